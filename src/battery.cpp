@@ -0,0 +1,128 @@
+#include "battery.h"
+#include <math.h>
+
+static BatteryConfig config = BATTERY_DEFAULT_CONFIG;
+static BatteryMetrics metrics = {0.0f, 0.0f, 0.0f, 1.0f, 0, 0};
+static BatteryLevel level = BatteryLevel::Absent;
+static bool hasSample = false;
+static uint32_t lastMs = 0;
+
+void batteryConfigure(const BatteryConfig &newConfig)
+{
+    config = newConfig;
+}
+
+const BatteryConfig &batteryGetConfig()
+{
+    return config;
+}
+
+// 带滞回的电量等级：进入看阈值，退出需回升超过阈值加滞回量
+static BatteryLevel classify(float volts)
+{
+    if (volts < config.absentV)
+    {
+        return BatteryLevel::Absent;
+    }
+    switch (level)
+    {
+    case BatteryLevel::Critical:
+        if (volts < config.criticalV + config.hysteresisV)
+        {
+            return BatteryLevel::Critical;
+        }
+        return volts < config.lowV + config.hysteresisV ? BatteryLevel::Low : BatteryLevel::Normal;
+    case BatteryLevel::Low:
+        if (volts < config.criticalV)
+        {
+            return BatteryLevel::Critical;
+        }
+        return volts < config.lowV + config.hysteresisV ? BatteryLevel::Low : BatteryLevel::Normal;
+    case BatteryLevel::Absent:
+    case BatteryLevel::Normal:
+    default:
+        if (volts < config.criticalV)
+        {
+            return BatteryLevel::Critical;
+        }
+        return volts < config.lowV ? BatteryLevel::Low : BatteryLevel::Normal;
+    }
+}
+
+bool batteryUpdate(uint32_t nowMs, float volts)
+{
+    ++metrics.samples;
+    const bool absent = volts < config.absentV;
+    if (!hasSample || absent || metrics.fastV < config.absentV)
+    {
+        // 首个样本或接上/拔下电池：滤波器直接跳到当前值
+        metrics.fastV = volts;
+        metrics.slowV = volts;
+        metrics.minFastV = volts;
+    }
+    else
+    {
+        const float dt = (nowMs - lastMs) / 1000.0f;
+        metrics.fastV += (volts - metrics.fastV) * fminf(dt / config.fastTauS, 1.0f);
+        metrics.slowV += (volts - metrics.slowV) * fminf(dt / config.slowTauS, 1.0f);
+        metrics.minFastV = fminf(metrics.minFastV, metrics.fastV);
+    }
+    hasSample = true;
+    lastMs = nowMs;
+
+    if (absent)
+    {
+        metrics.scale = 1.0f;
+    }
+    else
+    {
+        const float wanted = config.referenceV / metrics.fastV;
+        if (wanted > config.maxScale)
+        {
+            ++metrics.saturated;
+        }
+        metrics.scale = fminf(wanted, config.maxScale);
+    }
+
+    const BatteryLevel next = classify(metrics.slowV);
+    const bool changed = next != level;
+    level = next;
+    return changed;
+}
+
+BatteryLevel batteryLevel()
+{
+    return level;
+}
+
+float batteryDutyScale()
+{
+    return metrics.scale;
+}
+
+int batteryCompensate(int duty)
+{
+    const int scaled = static_cast<int>(lroundf(duty * metrics.scale));
+    return scaled > 255 ? 255 : (scaled < -255 ? -255 : scaled);
+}
+
+const BatteryMetrics &batteryGetMetrics()
+{
+    return metrics;
+}
+
+const char *batteryLevelName(BatteryLevel value)
+{
+    switch (value)
+    {
+    case BatteryLevel::Normal:
+        return "正常";
+    case BatteryLevel::Low:
+        return "低电量";
+    case BatteryLevel::Critical:
+        return "严重低电量";
+    case BatteryLevel::Absent:
+    default:
+        return "未接电池";
+    }
+}
@@ -0,0 +1,57 @@
+#pragma once
+#include <stdint.h>
+
+// 电池监测：对 ADC 连续采样得到的电池电压做两级滤波。
+//   快速滤波跟随负载压降，用于按 参考电压 / 当前电压 缩放电机占空比，使电机两端的有效电压保持不变，
+//   同一命令在满电与低电、重载压降时速度一致（刹车距离也因此与避障阈值相符）；
+//   慢速滤波忽略短时压降，带滞回判定低电量/严重低电量事件。
+// 电压低于 absentV 视为未接电池（USB 供电调试），不缩放也不报告事件。
+// 纯逻辑模块（不依赖 Arduino），时间由调用方传入，便于主机端用仿真放电曲线测试。
+
+struct BatteryConfig
+{
+    float referenceV;  // 补偿目标：电机两端保持的有效电压
+    float lowV;        // 慢速滤波低于该值进入低电量
+    float criticalV;   // 低于该值进入严重低电量
+    float hysteresisV; // 回升超过阈值加滞回量才退出
+    float absentV;     // 低于该值视为未接电池
+    float fastTauS;    // 补偿用滤波时间常数
+    float slowTauS;    // 事件判定用滤波时间常数
+    float maxScale;    // 占空比放大上限（电压过低时不再继续放大）
+};
+
+// 默认 2S 锂电池：满电 8.4 V，标称 7.4 V
+static constexpr BatteryConfig BATTERY_DEFAULT_CONFIG = {7.0f, 6.8f, 6.4f, 0.2f, 3.0f, 0.2f, 5.0f, 1.3f};
+
+enum class BatteryLevel : uint8_t
+{
+    Absent,
+    Normal,
+    Low,
+    Critical
+};
+
+struct BatteryMetrics
+{
+    float fastV;
+    float slowV;
+    float minFastV;     // 最低瞬时电压（负载压降）
+    float scale;        // 当前占空比缩放系数
+    uint32_t samples;
+    uint32_t saturated; // 需要的放大超过 maxScale 的次数
+};
+
+void batteryConfigure(const BatteryConfig &config);
+const BatteryConfig &batteryGetConfig();
+
+// 输入一次电池电压（一批 ADC 样本的平均值），电量等级变化时返回 true
+bool batteryUpdate(uint32_t nowMs, float volts);
+
+BatteryLevel batteryLevel();
+// 占空比缩放系数（未接电池或尚无数据时为 1）
+float batteryDutyScale();
+// 按当前系数缩放占空比并限幅到 ±255
+int batteryCompensate(int duty);
+
+const BatteryMetrics &batteryGetMetrics();
+const char *batteryLevelName(BatteryLevel level);
@@ -0,0 +1,84 @@
+#include "battery_adc.h"
+#include <driver/adc.h>
+#include <esp_adc_cal.h>
+
+// 分压：电池 — 100 kΩ — GPIO1 — 33 kΩ — GND，8.4 V 满电时 ADC 输入约 2.1 V
+static constexpr float DIVIDER_RATIO = (100.0f + 33.0f) / 33.0f;
+static constexpr adc1_channel_t CHANNEL = ADC1_CHANNEL_0; // GPIO1
+static constexpr adc_atten_t ATTENUATION = ADC_ATTEN_DB_11;
+static constexpr uint32_t SAMPLE_FREQ_HZ = 1000;
+static constexpr uint32_t FRAME_BYTES = 256; // 每帧 64 个样本（TYPE2 格式每个 4 字节）
+
+static esp_adc_cal_characteristics_t calibration;
+static bool started = false;
+
+bool batteryAdcBegin()
+{
+    adc_digi_init_config_t init = {};
+    init.max_store_buf_size = 4 * FRAME_BYTES;
+    init.conv_num_each_intr = FRAME_BYTES;
+    init.adc1_chan_mask = BIT(CHANNEL);
+    init.adc2_chan_mask = 0;
+    if (adc_digi_initialize(&init) != ESP_OK)
+    {
+        return false;
+    }
+
+    adc_digi_pattern_config_t pattern = {};
+    pattern.atten = ATTENUATION;
+    pattern.channel = CHANNEL;
+    pattern.unit = 0; // ADC1
+    pattern.bit_width = SOC_ADC_DIGI_MAX_BITWIDTH;
+
+    adc_digi_configuration_t config = {};
+    config.conv_limit_en = false;
+    config.conv_limit_num = 250;
+    config.pattern_num = 1;
+    config.adc_pattern = &pattern;
+    config.sample_freq_hz = SAMPLE_FREQ_HZ;
+    config.conv_mode = ADC_CONV_SINGLE_UNIT_1;
+    config.format = ADC_DIGI_OUTPUT_FORMAT_TYPE2;
+    if (adc_digi_controller_configure(&config) != ESP_OK || adc_digi_start() != ESP_OK)
+    {
+        adc_digi_deinitialize();
+        return false;
+    }
+
+    esp_adc_cal_characterize(ADC_UNIT_1, ATTENUATION, ADC_WIDTH_BIT_12, 1100, &calibration);
+    started = true;
+    return true;
+}
+
+bool batteryAdcRead(float *volts)
+{
+    if (!started)
+    {
+        return false;
+    }
+    uint8_t frame[FRAME_BYTES];
+    uint32_t sum = 0;
+    uint32_t count = 0;
+    uint32_t length = 0;
+    // 超时为 0：只取已完成的帧，缓冲空时立即返回；缓冲溢出（ESP_ERR_INVALID_STATE）时已读到的数据仍然有效
+    esp_err_t err;
+    while (((err = adc_digi_read_bytes(frame, sizeof(frame), &length, 0)) == ESP_OK || err == ESP_ERR_INVALID_STATE) &&
+           length > 0)
+    {
+        for (uint32_t i = 0; i + SOC_ADC_DIGI_RESULT_BYTES <= length; i += SOC_ADC_DIGI_RESULT_BYTES)
+        {
+            const adc_digi_output_data_t *result = reinterpret_cast<const adc_digi_output_data_t *>(frame + i);
+            if (result->type2.unit == 0 && result->type2.channel == CHANNEL)
+            {
+                sum += result->type2.data;
+                ++count;
+            }
+        }
+    }
+    if (count == 0)
+    {
+        return false;
+    }
+    const uint32_t millivolts = esp_adc_cal_raw_to_voltage(sum / count, &calibration);
+    *volts = millivolts * DIVIDER_RATIO / 1000.0f;
+    return true;
+}
@@ -0,0 +1,11 @@
+#pragma once
+#include <Arduino.h>
+
+// 电池电压采样：GPIO1（ADC1_CH0）经分压电阻接电池正极，ADC 以连续模式由 DMA 采样，
+// CPU 只在读取时对一批样本求平均，不为单个样本付出开销。
+
+// 启动连续采样，失败返回 false
+bool batteryAdcBegin();
+
+// 读取自上次调用以来 DMA 缓冲中的全部样本，换算为电池电压（V）；没有新样本时返回 false（非阻塞）
+bool batteryAdcRead(float *volts);
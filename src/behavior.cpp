@@ -0,0 +1,31 @@
+#include "behavior.h"
+
+void behaviorStart(Behavior &behavior, uint32_t nowMs)
+{
+    behavior.resumeLine = 0;
+    behavior.running = true;
+    behaviorStep(behavior, nowMs);
+}
+
+bool behaviorStep(Behavior &behavior, uint32_t nowMs)
+{
+    if (behavior.running && behavior.script(behavior, nowMs))
+    {
+        behavior.running = false;
+    }
+    return behavior.running;
+}
+
+void behaviorCancel(Behavior &behavior)
+{
+    if (!behavior.running)
+    {
+        return;
+    }
+    behavior.running = false;
+    behavior.resumeLine = 0;
+    if (behavior.onCancel != nullptr)
+    {
+        behavior.onCancel();
+    }
+}
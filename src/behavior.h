@@ -0,0 +1,79 @@
+#pragma once
+#include <stdint.h>
+
+// 协作式行为脚本：把“后退 3 s → 暂停 2 s → 转向 → 暂停”之类的定时序列写成顺序代码，
+// 由主循环每次调用 behaviorStep() 推进，脚本在 BEHAVIOR_SLEEP / BEHAVIOR_UNTIL 处挂起，下次从挂起处继续。
+// 无栈实现（switch + 行号，同 protothreads）：状态只有 Behavior 结构本身，不分配堆内存。
+// 纯逻辑模块（不依赖 Arduino），时间由调用方传入。
+//
+// 脚本的写法限制：
+//   - 需要跨越挂起点保留的变量放在文件作用域的静态变量中（函数局部变量在恢复时不会保留）；
+//   - 脚本函数体内不能再使用 switch 语句，同一行不能有两个挂起点。
+
+struct Behavior;
+
+// 脚本函数：从上次挂起处继续执行，执行到 BEHAVIOR_END 时返回 true
+typedef bool (*BehaviorScript)(Behavior &self, uint32_t nowMs);
+
+struct Behavior
+{
+    BehaviorScript script;
+    void (*onCancel)();    // 被取消时的清理（可为空），脚本正常结束时不调用
+    uint16_t resumeLine;   // 挂起点（源代码行号），0 表示从头开始
+    bool running;
+    uint32_t waitStartMs;  // BEHAVIOR_SLEEP 开始等待的时间
+};
+
+// 从头开始并立即推进一次（已在运行时直接重新开始，不调用 onCancel）
+void behaviorStart(Behavior &behavior, uint32_t nowMs);
+
+// 推进一次，返回脚本是否仍在运行
+bool behaviorStep(Behavior &behavior, uint32_t nowMs);
+
+// 取消正在运行的脚本并调用 onCancel；未运行时什么也不做
+void behaviorCancel(Behavior &behavior);
+
+inline bool behaviorRunning(const Behavior &behavior)
+{
+    return behavior.running;
+}
+
+// ---- 脚本宏 ----
+#define BEHAVIOR_BEGIN(self) \
+    switch ((self).resumeLine) \
+    {                          \
+    case 0:
+
+#define BEHAVIOR_END(self)  \
+    }                       \
+    (self).resumeLine = 0;  \
+    return true
+
+// 记录挂起点；恢复时跳到这里
+#define BEHAVIOR_SUSPEND_POINT_(self)  \
+    (self).resumeLine = __LINE__;      \
+    __attribute__((fallthrough));      \
+    case __LINE__:
+
+// 挂起直到条件成立（条件每次推进时重新求值）
+#define BEHAVIOR_UNTIL(self, condition)  \
+    do                                   \
+    {                                    \
+        BEHAVIOR_SUSPEND_POINT_(self)    \
+        if (!(condition))                \
+        {                                \
+            return false;                \
+        }                                \
+    } while (0)
+
+// 挂起 durationMs 毫秒
+#define BEHAVIOR_SLEEP(self, nowMs, durationMs)             \
+    do                                                      \
+    {                                                       \
+        (self).waitStartMs = (nowMs);                       \
+        BEHAVIOR_SUSPEND_POINT_(self)                       \
+        if ((nowMs) - (self).waitStartMs < (durationMs))    \
+        {                                                   \
+            return false;                                   \
+        }                                                   \
+    } while (0)
@@ -0,0 +1,149 @@
+#include "boot.h"
+#include <atomic>
+#include <stdio.h>
+
+// 依赖表：按 BootPhase 顺序，每项为依赖阶段的位掩码
+#define BOOT_BIT(phase) (1u << static_cast<unsigned>(BootPhase::phase))
+static const uint8_t DEPENDENCIES[BOOT_PHASE_COUNT] = {
+    0,                                     // Motors
+    0,                                     // Display
+    BOOT_BIT(Display),                     // Imu：与 OLED 共用 I2C 总线，由显示初始化启动总线
+    0,                                     // Buttons
+    0,                                     // Ultrasonic
+    BOOT_BIT(Motors) | BOOT_BIT(Imu),      // Drive
+    0,                                     // Battery
+};
+#undef BOOT_BIT
+
+static const char *const PHASE_NAMES[BOOT_PHASE_COUNT] = {"motors", "display", "imu", "buttons", "ultrasonic", "drive", "battery"};
+
+static std::atomic<uint8_t> states[BOOT_PHASE_COUNT];
+static BootTiming timings[BOOT_PHASE_COUNT];
+static uint32_t originUs = 0;
+
+static size_t indexOf(BootPhase phase)
+{
+    return static_cast<size_t>(phase);
+}
+
+static bool finished(size_t index)
+{
+    const uint8_t state = states[index].load(std::memory_order_acquire);
+    return state == static_cast<uint8_t>(BootPhaseState::Done) || state == static_cast<uint8_t>(BootPhaseState::Failed);
+}
+
+void bootInit(uint32_t nowUs)
+{
+    originUs = nowUs;
+    for (size_t i = 0; i < BOOT_PHASE_COUNT; ++i)
+    {
+        timings[i] = {0, 0};
+        states[i].store(static_cast<uint8_t>(BootPhaseState::Pending), std::memory_order_relaxed);
+    }
+}
+
+bool bootDependsOn(BootPhase phase, BootPhase dependency)
+{
+    return (DEPENDENCIES[indexOf(phase)] & (1u << indexOf(dependency))) != 0;
+}
+
+bool bootRunnable(BootPhase phase)
+{
+    const size_t index = indexOf(phase);
+    if (states[index].load(std::memory_order_acquire) != static_cast<uint8_t>(BootPhaseState::Pending))
+    {
+        return false;
+    }
+    for (size_t i = 0; i < BOOT_PHASE_COUNT; ++i)
+    {
+        if ((DEPENDENCIES[index] & (1u << i)) != 0 && !finished(i))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+void bootStart(BootPhase phase, uint32_t nowUs)
+{
+    const size_t index = indexOf(phase);
+    timings[index].startUs = nowUs - originUs;
+    states[index].store(static_cast<uint8_t>(BootPhaseState::Running), std::memory_order_release);
+}
+
+void bootFinish(BootPhase phase, uint32_t nowUs, bool ok)
+{
+    const size_t index = indexOf(phase);
+    timings[index].endUs = nowUs - originUs;
+    const BootPhaseState state = ok ? BootPhaseState::Done : BootPhaseState::Failed;
+    states[index].store(static_cast<uint8_t>(state), std::memory_order_release);
+}
+
+BootPhaseState bootState(BootPhase phase)
+{
+    return static_cast<BootPhaseState>(states[indexOf(phase)].load(std::memory_order_acquire));
+}
+
+bool bootComplete()
+{
+    for (size_t i = 0; i < BOOT_PHASE_COUNT; ++i)
+    {
+        if (!finished(i))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+BootTiming bootGetTiming(BootPhase phase)
+{
+    return timings[indexOf(phase)];
+}
+
+const char *bootPhaseName(BootPhase phase)
+{
+    return indexOf(phase) < BOOT_PHASE_COUNT ? PHASE_NAMES[indexOf(phase)] : "?";
+}
+
+uint32_t bootTotalUs()
+{
+    uint32_t total = 0;
+    for (size_t i = 0; i < BOOT_PHASE_COUNT; ++i)
+    {
+        if (finished(i) && timings[i].endUs > total)
+        {
+            total = timings[i].endUs;
+        }
+    }
+    return total;
+}
+
+uint32_t bootSerialUs()
+{
+    uint32_t sum = 0;
+    for (size_t i = 0; i < BOOT_PHASE_COUNT; ++i)
+    {
+        if (finished(i))
+        {
+            sum += timings[i].endUs - timings[i].startUs;
+        }
+    }
+    return sum;
+}
+
+void bootReport(void (*sink)(const char *line))
+{
+    char line[80];
+    for (size_t i = 0; i < BOOT_PHASE_COUNT; ++i)
+    {
+        const BootPhaseState state = static_cast<BootPhaseState>(states[i].load(std::memory_order_acquire));
+        const char *result = state == BootPhaseState::Done ? "ok" : (state == BootPhaseState::Failed ? "FAILED" : "unfinished");
+        snprintf(line, sizeof(line), "[boot] %-10s %8.1f ms -> %8.1f ms  (%7.1f ms) %s", PHASE_NAMES[i],
+                 timings[i].startUs / 1000.0, timings[i].endUs / 1000.0,
+                 finished(i) ? (timings[i].endUs - timings[i].startUs) / 1000.0 : 0.0, result);
+        sink(line);
+    }
+    snprintf(line, sizeof(line), "[boot] 总计 %.1f ms（串行需 %.1f ms）", bootTotalUs() / 1000.0, bootSerialUs() / 1000.0);
+    sink(line);
+}
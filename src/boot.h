@@ -0,0 +1,59 @@
+#pragma once
+#include <stddef.h>
+#include <stdint.h>
+
+// 启动流水线：各启动阶段按依赖关系排序，依赖全部结束（成功或失败）后即可开始，
+// 互不依赖的阶段可以重叠（IMU 校准在独立任务中进行，同时显示与按键已可用）。
+// 记录每个阶段的开始/结束时间并输出报告。纯逻辑模块，时间由调用方传入；
+// 阶段状态可由其他任务结束，跨任务读写使用原子变量。
+
+enum class BootPhase : uint8_t
+{
+    Motors,     // 电机驱动初始化并保持待机
+    Display,    // OLED（同时启动 I2C 总线）
+    Imu,        // MPU6050 初始化与校准（独立任务）
+    Buttons,
+    Ultrasonic,
+    Drive,      // 解除电机待机：需要电机与 IMU 都已就绪
+    Battery     // 电池电压 ADC 连续采样
+};
+
+static constexpr size_t BOOT_PHASE_COUNT = 7;
+
+enum class BootPhaseState : uint8_t
+{
+    Pending,
+    Running,
+    Done,
+    Failed
+};
+
+struct BootTiming
+{
+    uint32_t startUs; // 相对 bootInit 的时间
+    uint32_t endUs;
+};
+
+void bootInit(uint32_t nowUs);
+
+// phase 是否直接依赖 dependency
+bool bootDependsOn(BootPhase phase, BootPhase dependency);
+
+// 尚未开始且所有依赖都已结束
+bool bootRunnable(BootPhase phase);
+
+void bootStart(BootPhase phase, uint32_t nowUs);
+// 可在其他任务中调用
+void bootFinish(BootPhase phase, uint32_t nowUs, bool ok);
+
+BootPhaseState bootState(BootPhase phase);
+bool bootComplete();
+BootTiming bootGetTiming(BootPhase phase);
+const char *bootPhaseName(BootPhase phase);
+
+// 从开始到最后一个阶段结束的总时长，以及各阶段耗时之和（即串行启动所需时间）
+uint32_t bootTotalUs();
+uint32_t bootSerialUs();
+
+// 逐行输出各阶段时间与汇总
+void bootReport(void (*sink)(const char *line));
@@ -1,4 +1,5 @@
 #include "buttons.h"
+#include "logger.h"
 
 // 按键引脚定义 - 根据实际连接修改（与原 main.cpp 保持一致）
 #define K1_PIN GPIO_NUM_15
@@ -89,10 +90,7 @@ void buttonsPoll()
         if (reading != buttons[i].lastState)
         {
             buttons[i].lastDebounceTime = currentTime;
-            Serial.print("按键");
-            Serial.print(i + 1);
-            Serial.print(" 状态变化: ");
-            Serial.println(reading == HIGH ? "HIGH" : "LOW");
+            LOG_DEBUG("按键{} 状态变化: {}", i + 1, reading == HIGH ? "HIGH" : "LOW");
         }
 
         if ((currentTime - buttons[i].lastDebounceTime) > 20)
@@ -107,17 +105,13 @@ void buttonsPoll()
                     buttons[i].isPressedFlag = true;
                     buttons[i].longPressTriggered = false;
                     buttons[i].shortPressHandled = false;
-                    Serial.print("按键");
-                    Serial.print(i + 1);
-                    Serial.println(" 按下");
+                    LOG_DEBUG("按键{} 按下", i + 1);
                 }
                 else
                 {
                     buttons[i].isPressedFlag = false;
                     buttons[i].longPressTriggered = false;
-                    Serial.print("按键");
-                    Serial.print(i + 1);
-                    Serial.println(" 释放");
+                    LOG_DEBUG("按键{} 释放", i + 1);
                 }
             }
         }
@@ -0,0 +1,161 @@
+#include "collision.h"
+#include <math.h>
+
+static CollisionMetrics metrics = {};
+static bool hasSample = false;
+static uint32_t lastUs = 0;
+static float baseline[2] = {0.0f, 0.0f};
+static float lastDeviation[2] = {0.0f, 0.0f};
+static float magnitudeMean = 0.0f;
+static float magnitudeVar = 0.0f;
+static bool stallCandidate = false;
+static uint32_t stallStartUs = 0;
+static bool hasEvent = false;
+static uint32_t lastEventUs = 0;
+
+void collisionReset()
+{
+    hasSample = false;
+    stallCandidate = false;
+    hasEvent = false;
+}
+
+static int absInt(int value)
+{
+    return value < 0 ? -value : value;
+}
+
+static CollisionKind report(CollisionKind kind, uint32_t nowUs)
+{
+    hasEvent = true;
+    lastEventUs = nowUs;
+    stallCandidate = false;
+    if (kind == CollisionKind::Bump)
+    {
+        ++metrics.bumps;
+    }
+    else
+    {
+        ++metrics.stalls;
+    }
+    return kind;
+}
+
+CollisionKind collisionUpdate(uint32_t nowUs, const float accel[3], const float gyro[3], int commandA, int commandB)
+{
+    const float magnitude = sqrtf(accel[0] * accel[0] + accel[1] * accel[1] + accel[2] * accel[2]);
+    if (!hasSample)
+    {
+        hasSample = true;
+        lastUs = nowUs;
+        baseline[0] = accel[0];
+        baseline[1] = accel[1];
+        lastDeviation[0] = 0.0f;
+        lastDeviation[1] = 0.0f;
+        magnitudeMean = magnitude;
+        magnitudeVar = 0.0f;
+        return CollisionKind::None;
+    }
+
+    const float dt = (nowUs - lastUs) / 1e6f;
+    lastUs = nowUs;
+    if (dt <= 0.0f || dt > 0.1f)
+    {
+        // 采样中断过久时差分没有意义，重新建立基线
+        hasSample = false;
+        return CollisionKind::None;
+    }
+
+    // 水平加速度相对慢变基线的偏差及其变化率
+    float deviation[2];
+    float jerkSq = 0.0f;
+    for (int axis = 0; axis < 2; ++axis)
+    {
+        deviation[axis] = accel[axis] - baseline[axis];
+        const float jerk = (deviation[axis] - lastDeviation[axis]) / dt;
+        jerkSq += jerk * jerk;
+        lastDeviation[axis] = deviation[axis];
+    }
+    const float deviationMag = hypotf(deviation[0], deviation[1]);
+    const float jerkMag = sqrtf(jerkSq);
+
+    // 突变期间不更新基线，避免把碰撞本身吸收进基线
+    if (deviationMag < COLLISION_ACCEL_THRESHOLD)
+    {
+        const float alpha = fminf(dt / COLLISION_BASELINE_TAU_S, 1.0f);
+        baseline[0] += deviation[0] * alpha;
+        baseline[1] += deviation[1] * alpha;
+    }
+
+    const float varAlpha = fminf(dt / COLLISION_STALL_TAU_S, 1.0f);
+    const float delta = magnitude - magnitudeMean;
+    magnitudeMean += delta * varAlpha;
+    magnitudeVar += (delta * delta - magnitudeVar) * varAlpha;
+
+    if (hasEvent && nowUs - lastEventUs < COLLISION_REFRACTORY_MS * 1000u)
+    {
+        return CollisionKind::None;
+    }
+
+    const bool driving = commandA != 0 || commandB != 0;
+    if (driving && deviationMag > COLLISION_ACCEL_THRESHOLD && jerkMag > COLLISION_JERK_THRESHOLD)
+    {
+        metrics.lastPeakAccel = deviationMag;
+        metrics.lastJerk = jerkMag;
+        return report(CollisionKind::Bump, nowUs);
+    }
+
+    // 堵转：两侧同向且占空比足够（原地转向不算），车身却几乎不动
+    const bool pushing = absInt(commandA) >= COLLISION_STALL_DUTY && absInt(commandB) >= COLLISION_STALL_DUTY &&
+                         (commandA > 0) == (commandB > 0);
+    const float gyroMag = sqrtf(gyro[0] * gyro[0] + gyro[1] * gyro[1] + gyro[2] * gyro[2]);
+    const bool still = magnitudeVar < COLLISION_STALL_ACCEL_VAR && gyroMag < COLLISION_STALL_GYRO_DPS;
+    if (!pushing || !still)
+    {
+        stallCandidate = false;
+        return CollisionKind::None;
+    }
+    if (!stallCandidate)
+    {
+        stallCandidate = true;
+        stallStartUs = nowUs;
+    }
+    if (nowUs - stallStartUs >= COLLISION_STALL_MS * 1000u)
+    {
+        return report(CollisionKind::Stall, nowUs);
+    }
+    return CollisionKind::None;
+}
+
+void collisionReportLatency(uint32_t latencyUs, uint32_t busUs)
+{
+    metrics.lastLatencyUs = latencyUs;
+    if (latencyUs > metrics.maxLatencyUs)
+    {
+        metrics.maxLatencyUs = latencyUs;
+    }
+    metrics.lastBusUs = busUs;
+    if (busUs > metrics.maxBusUs)
+    {
+        metrics.maxBusUs = busUs;
+    }
+}
+
+const CollisionMetrics &collisionGetMetrics()
+{
+    return metrics;
+}
+
+const char *collisionName(CollisionKind kind)
+{
+    switch (kind)
+    {
+    case CollisionKind::Bump:
+        return "碰撞";
+    case CollisionKind::Stall:
+        return "堵转";
+    case CollisionKind::None:
+    default:
+        return "无";
+    }
+}
@@ -0,0 +1,46 @@
+#pragma once
+#include <stdint.h>
+
+// 碰撞与堵转检测：在传感器任务中对每个原始 IMU 样本运行，检测到后由调用方直接通过电机层刹车。
+//   碰撞：水平加速度相对慢变基线的突变幅值与加加速度（jerk）同时超过阈值，且电机有输出
+//   堵转：电机以足够占空比同向驱动，但车身振动与角速度都接近静止，并持续一段时间
+// 纯逻辑模块（不依赖 Arduino），时间由调用方传入，便于主机端用合成轨迹评估。
+
+static constexpr float COLLISION_ACCEL_THRESHOLD = 5.5f;   // 水平加速度突变（m/s²）
+static constexpr float COLLISION_JERK_THRESHOLD = 300.0f;  // 加加速度（m/s³）
+static constexpr float COLLISION_BASELINE_TAU_S = 0.5f;    // 慢变基线（坡度、正常加减速）的时间常数
+static constexpr int COLLISION_STALL_DUTY = 100;           // 判定堵转的最低占空比
+static constexpr uint32_t COLLISION_STALL_MS = 400;        // 堵转条件需持续的时间
+static constexpr float COLLISION_STALL_ACCEL_VAR = 0.02f;  // 堵转时加速度幅值方差上限（(m/s²)²）
+static constexpr float COLLISION_STALL_TAU_S = 0.15f;      // 方差估计的时间常数
+static constexpr float COLLISION_STALL_GYRO_DPS = 3.0f;    // 堵转时角速度幅值上限
+static constexpr uint32_t COLLISION_REFRACTORY_MS = 1000;  // 两次事件之间的最短间隔
+
+enum class CollisionKind : uint8_t
+{
+    None,
+    Bump,
+    Stall
+};
+
+struct CollisionMetrics
+{
+    uint32_t bumps;
+    uint32_t stalls;
+    float lastPeakAccel;    // 最近一次碰撞的加速度突变幅值
+    float lastJerk;
+    uint32_t lastLatencyUs; // 最近一次从发起样本读取（含等待总线）到电机刹车完成的耗时（由调用方上报）
+    uint32_t maxLatencyUs;
+    uint32_t lastBusUs;     // 其中等待总线与读取样本的耗时
+    uint32_t maxBusUs;
+};
+
+void collisionReset();
+
+// accel 为扣除静态零偏的加速度（m/s²），gyro 为角速度（°/s），commandA/B 为两侧电机当前命令
+CollisionKind collisionUpdate(uint32_t nowUs, const float accel[3], const float gyro[3], int commandA, int commandB);
+
+void collisionReportLatency(uint32_t latencyUs, uint32_t busUs);
+
+const CollisionMetrics &collisionGetMetrics();
+const char *collisionName(CollisionKind kind);
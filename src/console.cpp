@@ -0,0 +1,97 @@
+#include <Arduino.h>
+#include "console.h"
+#include <stdio.h>
+#include <string.h>
+
+static constexpr size_t LINE_CAPACITY = 48;
+static char line[LINE_CAPACITY];
+static size_t lineLength = 0;
+static bool lineOverflow = false;
+
+bool consoleParse(const char *text, ConsoleCommand *out)
+{
+    *out = {ConsoleCommandKind::None, 0, 0};
+    char name[8];
+    int a = 0, b = 0;
+    const int fields = sscanf(text, "%7s %d %d", name, &a, &b);
+    if (fields < 1)
+    {
+        return false;
+    }
+
+    if (strcmp(name, "d") == 0)
+    {
+        if (fields != 3 || a < -255 || a > 255 || b < -255 || b > 255)
+        {
+            return false;
+        }
+        *out = {ConsoleCommandKind::Drive, static_cast<int16_t>(a), static_cast<int16_t>(b)};
+        return true;
+    }
+
+    static const struct
+    {
+        const char *name;
+        ConsoleCommandKind kind;
+    } SIMPLE[] = {
+        {"s", ConsoleCommandKind::Stop},
+        {"rec", ConsoleCommandKind::Record},
+        {"end", ConsoleCommandKind::EndRecord},
+        {"play", ConsoleCommandKind::Play},
+        {"route", ConsoleCommandKind::RouteInfo},
+        {"id", ConsoleCommandKind::MotorId},
+        {"imu", ConsoleCommandKind::ImuInfo},
+        {"range", ConsoleCommandKind::RangingInfo},
+        {"log", ConsoleCommandKind::LogInfo},
+        {"health", ConsoleCommandKind::HealthInfo},
+    };
+    for (const auto &entry : SIMPLE)
+    {
+        if (fields == 1 && strcmp(name, entry.name) == 0)
+        {
+            out->kind = entry.kind;
+            return true;
+        }
+    }
+    return false;
+}
+
+bool consolePoll(ConsoleCommand *out)
+{
+    while (Serial.available() > 0)
+    {
+        const char c = static_cast<char>(Serial.read());
+        if (c == '\r')
+        {
+            continue;
+        }
+        if (c != '\n')
+        {
+            // 超长的行整行丢弃
+            if (lineLength + 1 < LINE_CAPACITY)
+            {
+                line[lineLength++] = c;
+            }
+            else
+            {
+                lineOverflow = true;
+            }
+            continue;
+        }
+
+        line[lineLength] = '\0';
+        const bool overflow = lineOverflow;
+        lineLength = 0;
+        lineOverflow = false;
+        if (line[0] == '\0')
+        {
+            continue;
+        }
+        if (!overflow && consoleParse(line, out))
+        {
+            return true; // 每次最多返回一条，其余留到下次 loop
+        }
+        Serial.printf("未知命令：%s\n", line);
+    }
+    return false;
+}
@@ -0,0 +1,46 @@
+#pragma once
+#include <stdint.h>
+
+// 串口控制台：主机端程序逐行发送命令遥控小车与示教-复现。
+//   d <A> <B>  以给定速度遥控行驶（-255~255），再次发送即改变速度
+//   s          停车（同时中止复现）
+//   rec        开始录制路线
+//   end        结束录制并保存到闪存
+//   play       复现路线（内存中没有路线时从闪存载入）
+//   route      输出路线信息
+//   id         电机辨识（约 36 s，单侧驱动原地转动，需在空旷处进行）
+//   imu        输出芯片温度、温度-零偏模型与航向漂移（有/无温度模型对照）
+//   range      输出测距调度统计（次数、超时、实际间隔与数据陈旧时间）、超声连续测量统计（剔除读数、低置信度组、组延迟）
+//              与调速器状态（预估距离、接近速度、停车次数）
+//   log        输出日志队列统计（入队、丢弃、已输出、最高占用）
+//   health     输出各子系统的监督状态（降级/恢复次数、故障、陈旧、截止时间错过与最长耗时）
+// 每行以 '\n' 结束，大小写敏感；未知命令输出提示并忽略。
+
+enum class ConsoleCommandKind : uint8_t
+{
+    None,
+    Drive,
+    Stop,
+    Record,
+    EndRecord,
+    Play,
+    RouteInfo,
+    MotorId,
+    ImuInfo,
+    RangingInfo,
+    LogInfo,
+    HealthInfo
+};
+
+struct ConsoleCommand
+{
+    ConsoleCommandKind kind;
+    int16_t a;
+    int16_t b;
+};
+
+// 解析一行命令（不含换行），无法识别时返回 false
+bool consoleParse(const char *line, ConsoleCommand *out);
+
+// 非阻塞读取串口，收到完整且合法的一行时返回 true
+bool consolePoll(ConsoleCommand *out);
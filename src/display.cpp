@@ -2,6 +2,8 @@
 #include <Wire.h>
 #include <Adafruit_GFX.h>
 #include <Adafruit_SSD1306.h>
+#include "display.h"
+#include "stripchart.h"
 
 // OLED 定义
 #define SCREEN_WIDTH 128
@@ -13,14 +15,44 @@
 static const int SDA_PIN = 47;
 static const int SCL_PIN = 48;
 
-static Adafruit_SSD1306 display(SCREEN_WIDTH, SCREEN_HEIGHT, &Wire, OLED_RESET);
+// 总线与 MPU6050 共用：库默认传输结束后把时钟降回 100 kHz，IMU 的每帧读取随之变慢到约 2 ms，这里始终保持 400 kHz
+static constexpr uint32_t I2C_CLOCK_HZ = 400000;
+static Adafruit_SSD1306 display(SCREEN_WIDTH, SCREEN_HEIGHT, &Wire, OLED_RESET, I2C_CLOCK_HZ, I2C_CLOCK_HZ);
 
 static bool isDisplayInitialized = false; // 添加一个标志位
 static float traveledDistanceMeters = 0.0f;
 
+// 曲线页绕过库的整屏缓冲直接按列写显存
+static constexpr uint8_t CONTROL_COMMANDS = 0x00;
+static constexpr uint8_t CONTROL_DATA = 0x40;
+static DisplayStripMetrics stripMetrics = {};
+
+// 整屏刷新按短事务发送：库按 128 字节一个事务（400 kHz 下约 3 ms）发送 1 KB 缓冲，
+// 传感器任务每次读取都要等当前事务结束；32 字节一个事务时最长等待约 0.8 ms
+static constexpr size_t FLUSH_CHUNK_BYTES = 32;
+
+static void flushDisplay()
+{
+    const uint8_t commands[] = {CONTROL_COMMANDS, SSD1306_PAGEADDR, 0, SCREEN_HEIGHT / 8 - 1, SSD1306_COLUMNADDR, 0, SCREEN_WIDTH - 1};
+    Wire.beginTransmission(I2C_ADDRESS);
+    Wire.write(commands, sizeof(commands));
+    Wire.endTransmission();
+
+    const uint8_t *buffer = display.getBuffer();
+    const size_t total = SCREEN_WIDTH * SCREEN_HEIGHT / 8;
+    for (size_t offset = 0; offset < total; offset += FLUSH_CHUNK_BYTES)
+    {
+        Wire.beginTransmission(I2C_ADDRESS);
+        Wire.write(CONTROL_DATA);
+        Wire.write(buffer + offset, FLUSH_CHUNK_BYTES);
+        Wire.endTransmission();
+    }
+}
+
 bool initDisplay()
 {
     Wire.begin(SDA_PIN, SCL_PIN);
+    Wire.setClock(I2C_CLOCK_HZ);
 
     if (!display.begin(SSD1306_SWITCHCAPVCC, I2C_ADDRESS))
     {
@@ -33,10 +65,16 @@ bool initDisplay()
     display.setTextSize(1);
     display.setTextColor(SSD1306_WHITE);
     display.setCursor(0, 0);
-    display.display();
+    flushDisplay();
     return true;
 }
 
+bool displayProbe()
+{
+    Wire.beginTransmission(I2C_ADDRESS);
+    return Wire.endTransmission() == 0;
+}
+
 void updateDisplay(int currentSpeedA, int currentSpeedB)
 {
     if (!isDisplayInitialized) // 检查是否已初始化
@@ -58,7 +96,7 @@ void updateDisplay(int currentSpeedA, int currentSpeedB)
     display.printf("A:%s %3d", dirA, valA);
     display.setCursor(0, 32);
     display.printf("B:%s %3d", dirB, valB);
-    display.display();
+    flushDisplay();
 }
 
 void updateDisplay(float distance)
@@ -76,7 +114,7 @@ void updateDisplay(float distance)
     display.setCursor(0, 0);
     display.printf("%.1fcm", distance);
 
-    display.display();
+    flushDisplay();
 }
 
 void updateDisplay(float distance, int currentSpeedA, int currentSpeedB)
@@ -97,7 +135,7 @@ void updateDisplay(float distance, int currentSpeedA, int currentSpeedB)
     display.setCursor(0, 40);
     display.printf("V: %4d %4d", currentSpeedA, currentSpeedB);
 
-    display.display();
+    flushDisplay();
 }
 
 void updateAttitudeDisplay(float roll, float pitch, float yaw, float velocityX, float velocityY)
@@ -118,7 +156,7 @@ void updateAttitudeDisplay(float roll, float pitch, float yaw, float velocityX,
     display.printf("VX:%5.2f", velocityX);
     display.setCursor(0, 48);
     display.printf("VY:%5.2f", velocityY);
-    display.display();
+    flushDisplay();
 }
 
 void updateDisplay(float distance, bool motorEnabled, bool motorForward, float planarVelocity)
@@ -143,7 +181,7 @@ void updateDisplay(float distance, bool motorEnabled, bool motorForward, float p
     display.setCursor(0, 56);
     display.printf("Dir:%s", motorForward ? "FWD" : "REV");
 
-    display.display();
+    flushDisplay();
 }
 
 void updateDisplay(float distance, bool motorEnabled, bool motorForward, float planarVelocity, float yaw)
@@ -168,7 +206,110 @@ void updateDisplay(float distance, bool motorEnabled, bool motorForward, float p
     display.setCursor(0, 56);
     display.printf("Motor:%s %s", motorEnabled ? "ON " : "OFF", motorForward ? "FWD" : "REV");
 
-    display.display();
+    flushDisplay();
+}
+
+void displayBootProgress(const char *const names[], const char marks[], size_t count, int percent)
+{
+    if (!isDisplayInitialized)
+    {
+        return;
+    }
+
+    display.clearDisplay();
+    display.setTextSize(1);
+    display.setTextColor(SSD1306_WHITE);
+    for (size_t i = 0; i < count && i < 7; ++i)
+    {
+        display.setCursor(0, static_cast<int16_t>(i * 8));
+        display.printf("[%c] %s", marks[i], names[i]);
+    }
+
+    // 底部进度条：IMU 校准进度
+    const int width = constrain(percent, 0, 100) * (SCREEN_WIDTH - 2) / 100;
+    display.drawRect(0, 57, SCREEN_WIDTH, 7, SSD1306_WHITE);
+    display.fillRect(1, 58, width, 5, SSD1306_WHITE);
+    flushDisplay();
+}
+
+// 设置列/页窗口后写入相邻的 count 列（水平寻址模式下按页逐行写窗口内各列），返回总线字节数（含地址字节）
+static size_t writeColumns(uint8_t x, uint8_t count, const uint8_t (*columns)[STRIP_PAGES])
+{
+    const uint8_t commands[] = {CONTROL_COMMANDS, SSD1306_COLUMNADDR, x, static_cast<uint8_t>(x + count - 1),
+                                SSD1306_PAGEADDR, 0, STRIP_PAGES - 1};
+    Wire.beginTransmission(I2C_ADDRESS);
+    Wire.write(commands, sizeof(commands));
+    Wire.endTransmission();
+
+    uint8_t data[1 + 2 * STRIP_PAGES];
+    data[0] = CONTROL_DATA;
+    for (size_t page = 0; page < STRIP_PAGES; ++page)
+    {
+        for (size_t c = 0; c < count; ++c)
+        {
+            data[1 + page * count + c] = columns[c][page];
+        }
+    }
+    const size_t length = 1 + count * STRIP_PAGES;
+    Wire.beginTransmission(I2C_ADDRESS);
+    Wire.write(data, length);
+    Wire.endTransmission();
+    return 1 + sizeof(commands) + 1 + length;
+}
+
+void updateStripChart(bool fullRedraw)
+{
+    if (!isDisplayInitialized)
+    {
+        return;
+    }
+
+    const uint32_t startMicros = micros();
+    if (fullRedraw)
+    {
+        // 整屏：光栅化到库的缓冲后一次发送（约 1 KB）
+        uint8_t *buffer = display.getBuffer();
+        uint8_t column[STRIP_PAGES];
+        for (size_t x = 0; x < SCREEN_WIDTH; ++x)
+        {
+            stripChartColumn(x, column);
+            for (size_t page = 0; page < STRIP_PAGES; ++page)
+            {
+                buffer[page * SCREEN_WIDTH + x] = column[page];
+            }
+        }
+        flushDisplay();
+        ++stripMetrics.fullRedraws;
+        stripMetrics.redrawMicros = micros() - startMicros;
+        return;
+    }
+
+    const size_t head = stripChartHead();
+    const size_t cursor = stripChartCursor();
+    uint8_t columns[2][STRIP_PAGES];
+    stripChartColumn(head, columns[0]);
+    stripChartColumn(cursor, columns[1]);
+    size_t bytes;
+    if (cursor == head + 1)
+    {
+        bytes = writeColumns(static_cast<uint8_t>(head), 2, columns);
+    }
+    else
+    {
+        // 光标回到第 0 列，两列不相邻
+        bytes = writeColumns(static_cast<uint8_t>(head), 1, &columns[0]) + writeColumns(static_cast<uint8_t>(cursor), 1, &columns[1]);
+    }
+
+    const uint32_t elapsed = micros() - startMicros;
+    ++stripMetrics.columnUpdates;
+    stripMetrics.columnBytes = static_cast<uint32_t>(bytes);
+    stripMetrics.totalColumnMicros += elapsed;
+    stripMetrics.maxColumnMicros = elapsed > stripMetrics.maxColumnMicros ? elapsed : stripMetrics.maxColumnMicros;
+}
+
+const DisplayStripMetrics &displayStripMetrics()
+{
+    return stripMetrics;
 }
 
 // 清屏函数实现
@@ -180,7 +321,7 @@ void clearDisplay()
     }
 
     display.clearDisplay(); // 清除显示内容
-    display.display();      // 刷新屏幕，确保黑屏
+    flushDisplay();         // 刷新屏幕，确保黑屏
 }
 
 void displaySetTraveledDistance(float distanceMeters)
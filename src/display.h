@@ -1,8 +1,13 @@
 #pragma once
+#include <stddef.h>
+#include <stdint.h>
 
 // 初始化OLED显示屏
 bool initDisplay();
 
+// 探测 OLED 是否应答（一次空的 I2C 写，NACK 返回 false）
+bool displayProbe();
+
 // 清除显示
 void clearDisplay();
 
@@ -12,5 +17,23 @@ void updateDisplay(float distance, bool motorEnabled, bool motorForward, float p
 // 如果需要保留姿态显示的功能，可以添加这个函数
 void updateAttitudeDisplay(float roll, float pitch, float yaw, float velX, float velY);
 
+// 启动进度：每个阶段一行（marks 为状态符号），底部为 0~100 的进度条
+void displayBootProgress(const char *const names[], const char marks[], size_t count, int percent);
+
 // 设置累计行驶距离（单位：米）
 void displaySetTraveledDistance(float distanceMeters);
+
+// 曲线页（见 stripchart.h）：fullRedraw 为 true 时整屏重绘（进入页面或量程变化），否则只写入最新一列与光标列
+void updateStripChart(bool fullRedraw);
+
+// 曲线页的总线开销（实测）
+struct DisplayStripMetrics
+{
+    uint32_t columnUpdates;
+    uint32_t fullRedraws;
+    uint32_t columnBytes;       // 最近一次列更新在总线上的字节数（含地址与控制字节）
+    uint32_t totalColumnMicros; // 列更新累计耗时
+    uint32_t maxColumnMicros;
+    uint32_t redrawMicros;      // 最近一次整屏重绘耗时
+};
+const DisplayStripMetrics &displayStripMetrics();
@@ -0,0 +1,141 @@
+#include "governor.h"
+#include <math.h>
+
+static GovernorConfig config = GOVERNOR_DEFAULT_CONFIG;
+static GovernorMetrics metrics = {0.0f, -1.0f, 0, 0, 0};
+static float distanceCm = -1.0f;
+static uint32_t lastObserveMs = 0;
+static bool hasObservation = false;
+static float throttle = 0.0f;
+static uint32_t lastUpdateMs = 0;
+static bool hasUpdate = false;
+static uint32_t stallStartMs = 0;
+static bool stallTiming = false;
+
+void governorConfigure(const GovernorConfig &newConfig)
+{
+    config = newConfig;
+}
+
+const GovernorConfig &governorGetConfig()
+{
+    return config;
+}
+
+void governorReset(int currentThrottle)
+{
+    throttle = static_cast<float>(currentThrottle > 0 ? currentThrottle : 0);
+    hasUpdate = false;
+    stallTiming = false;
+}
+
+void governorObserve(uint32_t nowMs, float newDistanceCm)
+{
+    if (newDistanceCm < 0.0f)
+    {
+        // 无回波：前方空旷，接近速度无从估计
+        distanceCm = -1.0f;
+        hasObservation = false;
+        metrics.closingSpeedCmS = 0.0f;
+        return;
+    }
+
+    if (hasObservation && distanceCm >= 0.0f)
+    {
+        const uint32_t dtMs = nowMs - lastObserveMs;
+        if (dtMs > 0 && dtMs < 1000)
+        {
+            const float raw = (distanceCm - newDistanceCm) * 1000.0f / dtMs;
+            metrics.closingSpeedCmS += (raw - metrics.closingSpeedCmS) * 0.5f;
+        }
+    }
+    distanceCm = newDistanceCm;
+    lastObserveMs = nowMs;
+    hasObservation = true;
+}
+
+GovernorOutput governorUpdate(uint32_t nowMs, int levelSpeed)
+{
+    GovernorOutput out = {0, 0, false, false, false};
+    const float dt = hasUpdate ? (nowMs - lastUpdateMs) / 1000.0f : 0.0f;
+    lastUpdateMs = nowMs;
+    hasUpdate = true;
+
+    // 按距离求允许速度：在停车距离前以规划减速度刹停，v = sqrt(2·a·余量)
+    float allowed = static_cast<float>(levelSpeed);
+    float proximity = 0.0f;
+    metrics.effectiveCm = -1.0f;
+    if (distanceCm >= 0.0f)
+    {
+        const float closing = metrics.closingSpeedCmS > 0.0f ? metrics.closingSpeedCmS : 0.0f;
+        const float effective = distanceCm - closing * config.latencyS;
+        const float margin = effective - config.stopDistanceCm;
+        metrics.effectiveCm = effective;
+        if (margin <= 0.0f)
+        {
+            throttle = 0.0f;
+            stallTiming = false;
+            metrics.allowedSpeed = 0;
+            ++metrics.stops;
+            out.stop = true;
+            out.limited = true;
+            return out;
+        }
+        const float vCmS = sqrtf(2.0f * config.brakeDecelCmS2 * margin);
+        allowed = fminf(allowed, vCmS / config.fullSpeedCmS * 255.0f);
+        allowed = fmaxf(allowed, fminf(static_cast<float>(config.minSpeed), static_cast<float>(levelSpeed)));
+        if (effective < config.steerDistanceCm)
+        {
+            proximity = 1.0f - margin / (config.steerDistanceCm - config.stopDistanceCm);
+        }
+        out.limited = allowed < levelSpeed || proximity > 0.0f;
+
+        // 蠕行速度不足以推动小车（地面阻力、轻触障碍）时距离不再变化，预估距离永远到不了停车距离
+        const bool pushing = proximity > 0.0f && throttle >= fminf(static_cast<float>(config.minSpeed), static_cast<float>(levelSpeed)) &&
+                             metrics.closingSpeedCmS < GOVERNOR_STALL_CLOSING_CM_S;
+        if (!pushing)
+        {
+            stallTiming = false;
+        }
+        else if (!stallTiming)
+        {
+            stallTiming = true;
+            stallStartMs = nowMs;
+        }
+        else if (nowMs - stallStartMs >= config.stallMs)
+        {
+            throttle = 0.0f;
+            stallTiming = false;
+            metrics.allowedSpeed = 0;
+            ++metrics.stalls;
+            out.stop = true;
+            out.stalled = true;
+            out.limited = true;
+            return out;
+        }
+    }
+    else
+    {
+        stallTiming = false;
+    }
+    metrics.allowedSpeed = static_cast<int>(allowed);
+
+    // 速率限制：加速平缓，减速更快
+    if (allowed > throttle)
+    {
+        throttle = fminf(allowed, throttle + config.accelPerS * dt);
+    }
+    else
+    {
+        throttle = fmaxf(allowed, throttle - config.decelPerS * dt);
+    }
+
+    out.throttle = static_cast<int>(throttle);
+    out.turn = static_cast<int>(throttle * config.maxTurnRatio * proximity);
+    return out;
+}
+
+const GovernorMetrics &governorGetMetrics()
+{
+    return metrics;
+}
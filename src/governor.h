@@ -0,0 +1,55 @@
+#pragma once
+#include <stdint.h>
+
+// 速度调节：按前方距离与接近速度连续缩放前进速度（以所选档位为上限），并在靠近障碍时逐渐加大差速避让，
+// 只有预估距离低于停车距离、或在避让区内被卡住不再接近时才需要停车后退（调用方据 stop 启动避障）。输出的加减速受速率限制。
+// 纯逻辑模块（不依赖 Arduino），时间由调用方传入，便于主机端仿真。
+
+struct GovernorConfig
+{
+    float stopDistanceCm;  // 低于该距离停车，交给后退避障
+    float steerDistanceCm; // 低于该距离开始差速避让
+    float brakeDecelCmS2;  // 规划刹车减速度：保证以该减速度能在停车距离前停下
+    float latencyS;        // 测距与控制的总延迟，期间按接近速度预估距离缩短
+    float fullSpeedCmS;    // 满占空比（255）时的估计车速
+    int minSpeed;          // 低于该占空比电机无法起步，未到停车距离时至少以此速度蠕行
+    float maxTurnRatio;    // 贴近停车距离时转向量占油门的比例
+    float accelPerS;       // 输出加速限制（占空比/秒）
+    float decelPerS;       // 输出减速限制（占空比/秒），到达停车距离时不受限
+    uint32_t stallMs;      // 避让区内以蠕行速度行驶却没有接近超过该时间，视为卡住并停车
+};
+
+static constexpr GovernorConfig GOVERNOR_DEFAULT_CONFIG = {15.0f, 60.0f, 80.0f, 0.15f, 100.0f, 90, 0.6f, 400.0f, 1200.0f, 1500};
+static constexpr float GOVERNOR_STALL_CLOSING_CM_S = 2.0f; // 接近速度低于该值视为没有接近
+
+struct GovernorOutput
+{
+    int throttle; // 前进油门（0~档位速度）
+    int turn;     // > 0 向右转，配合 motorsMix 使用
+    bool stop;    // 已到停车距离或被卡住，调用方应停车避障
+    bool stalled; // stop 的原因是卡住
+    bool limited; // 因障碍物限速或避让中
+};
+
+struct GovernorMetrics
+{
+    float closingSpeedCmS; // 滤波后的接近速度（正值为靠近）
+    float effectiveCm;     // 计入延迟后的预估距离，未知时为 -1
+    int allowedSpeed;      // 距离允许的最高占空比
+    uint32_t stops;        // 因距离停车的次数
+    uint32_t stalls;       // 因卡住停车的次数
+};
+
+void governorConfigure(const GovernorConfig &config);
+const GovernorConfig &governorGetConfig();
+
+// 进入调速模式时以当前油门为起点，避免跳变
+void governorReset(int currentThrottle);
+
+// 记录一次测距：distanceCm < 0 表示无回波（前方空旷）
+void governorObserve(uint32_t nowMs, float distanceCm);
+
+// 计算本次输出，levelSpeed 为所选档位速度
+GovernorOutput governorUpdate(uint32_t nowMs, int levelSpeed);
+
+const GovernorMetrics &governorGetMetrics();
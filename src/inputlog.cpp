@@ -0,0 +1,195 @@
+#include "inputlog.h"
+
+#ifdef INPUT_LOG_CAPTURE
+#include "inputlog_codec.h"
+
+static uint8_t *logBuffer = nullptr;
+static size_t logUsed = 0;
+static bool logOverflow = false;
+static bool logHasTick = false;
+static uint32_t lastTickMicros = 0;
+
+// 单条记录最大长度：类型 1 字节 + MpuState 或 MpuSample
+static constexpr size_t MAX_RECORD_SIZE = 1 + (sizeof(MpuState) > sizeof(MpuSample) ? sizeof(MpuState) : sizeof(MpuSample));
+
+static_assert(sizeof(MpuState) < 256, "MpuState 过大，日志头只有一个字节记录其长度");
+
+static uint8_t *reserve()
+{
+    if (logBuffer == nullptr || logOverflow)
+    {
+        return nullptr;
+    }
+    if (logUsed + MAX_RECORD_SIZE > INPUT_LOG_CAPACITY)
+    {
+        logOverflow = true; // 缓冲写满后停止记录，保证已有部分完整可回放
+        return nullptr;
+    }
+    return logBuffer + logUsed;
+}
+
+bool inputLogBegin()
+{
+    if (logBuffer == nullptr)
+    {
+        logBuffer = static_cast<uint8_t *>(ps_malloc(INPUT_LOG_CAPACITY));
+        if (logBuffer == nullptr)
+        {
+            Serial.println("输入日志：PSRAM 分配失败");
+            return false;
+        }
+    }
+    logUsed = inputLogWriteHeader(logBuffer, static_cast<uint8_t>(sizeof(MpuState)));
+    logOverflow = false;
+    logHasTick = false;
+    return true;
+}
+
+void inputLogTick(uint32_t nowMicros)
+{
+    uint8_t *p = reserve();
+    if (p == nullptr)
+    {
+        return;
+    }
+    // 首个 Tick 记录绝对时间，之后记录差值
+    const uint32_t delta = logHasTick ? nowMicros - lastTickMicros : nowMicros;
+    lastTickMicros = nowMicros;
+    logHasTick = true;
+    p[0] = static_cast<uint8_t>(InputLogType::Tick);
+    logUsed += 1 + inputLogPutVarint(p + 1, delta);
+}
+
+void inputLogMpu(const MpuState &state)
+{
+    uint8_t *p = reserve();
+    if (p == nullptr)
+    {
+        return;
+    }
+    p[0] = static_cast<uint8_t>(InputLogType::Mpu);
+    memcpy(p + 1, &state, sizeof(state));
+    logUsed += 1 + sizeof(state);
+}
+
+void inputLogSample(const MpuSample &sample)
+{
+    uint8_t *p = reserve();
+    if (p == nullptr)
+    {
+        return;
+    }
+    p[0] = static_cast<uint8_t>(InputLogType::Sample);
+    memcpy(p + 1, &sample, sizeof(sample));
+    logUsed += 1 + sizeof(sample);
+}
+
+void inputLogRange(float distanceCm)
+{
+    uint8_t *p = reserve();
+    if (p == nullptr)
+    {
+        return;
+    }
+    p[0] = static_cast<uint8_t>(InputLogType::Range);
+    logUsed += 1 + inputLogPutFloat(p + 1, distanceCm);
+}
+
+void inputLogButton(int buttonIndex, bool longPress)
+{
+    uint8_t *p = reserve();
+    if (p == nullptr)
+    {
+        return;
+    }
+    p[0] = static_cast<uint8_t>(InputLogType::Button);
+    p[1] = inputLogPackButton(buttonIndex, longPress);
+    logUsed += 2;
+}
+
+void inputLogCollision(uint8_t kind)
+{
+    uint8_t *p = reserve();
+    if (p == nullptr)
+    {
+        return;
+    }
+    p[0] = static_cast<uint8_t>(InputLogType::Collision);
+    p[1] = kind;
+    logUsed += 2;
+}
+
+void inputLogCommand(const ConsoleCommand &command)
+{
+    uint8_t *p = reserve();
+    if (p == nullptr)
+    {
+        return;
+    }
+    p[0] = static_cast<uint8_t>(InputLogType::Command);
+    p[1] = static_cast<uint8_t>(command.kind);
+    size_t n = 2 + inputLogPutInt16(p + 2, command.a);
+    n += inputLogPutInt16(p + n, command.b);
+    logUsed += n;
+}
+
+void inputLogRoute(const uint8_t *data, size_t size)
+{
+    if (logBuffer == nullptr || logOverflow)
+    {
+        return;
+    }
+    // 路线远长于普通记录，单独检查剩余空间
+    if (logUsed + 1 + 5 + size + MAX_RECORD_SIZE > INPUT_LOG_CAPACITY)
+    {
+        logOverflow = true;
+        return;
+    }
+    uint8_t *p = logBuffer + logUsed;
+    p[0] = static_cast<uint8_t>(InputLogType::Route);
+    const size_t n = 1 + inputLogPutVarint(p + 1, static_cast<uint32_t>(size));
+    memcpy(p + n, data, size);
+    logUsed += n + size;
+}
+
+void inputLogBattery(float volts)
+{
+    uint8_t *p = reserve();
+    if (p == nullptr)
+    {
+        return;
+    }
+    p[0] = static_cast<uint8_t>(InputLogType::Battery);
+    logUsed += 1 + inputLogPutFloat(p + 1, volts);
+}
+
+void inputLogDump()
+{
+    if (logBuffer == nullptr)
+    {
+        Serial.println("输入日志：未启用");
+        return;
+    }
+
+    Serial.printf("IL:BEGIN %u %s\n", static_cast<unsigned>(logUsed), logOverflow ? "OVERFLOW" : "OK");
+    static const char HEX_DIGITS[] = "0123456789abcdef";
+    char line[3 + 64 + 1];
+    for (size_t offset = 0; offset < logUsed; offset += 32)
+    {
+        const size_t count = min(static_cast<size_t>(32), logUsed - offset);
+        size_t n = 0;
+        line[n++] = 'I';
+        line[n++] = 'L';
+        line[n++] = ':';
+        for (size_t i = 0; i < count; ++i)
+        {
+            line[n++] = HEX_DIGITS[logBuffer[offset + i] >> 4];
+            line[n++] = HEX_DIGITS[logBuffer[offset + i] & 0x0F];
+        }
+        line[n] = '\0';
+        Serial.println(line);
+    }
+    Serial.println("IL:END");
+}
+
+#endif
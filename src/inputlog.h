@@ -0,0 +1,47 @@
+#pragma once
+#include <Arduino.h>
+#include "mpu.h"
+#include "console.h"
+
+// 输入采集：把所有外部输入（loop 时间戳、MPU 状态与原始样本、超声波读数、按键与碰撞事件、串口命令、载入的路线、电池电压）
+// 按时间顺序写入 PSRAM 缓冲，供主机端 tools/replay 用同一份控制代码回放。
+// 仅在 build_flags 定义 INPUT_LOG_CAPTURE 时启用，否则全部为空操作。
+#ifdef INPUT_LOG_CAPTURE
+
+#ifndef INPUT_LOG_CAPACITY
+#define INPUT_LOG_CAPACITY (4u * 1024u * 1024u)
+#endif
+
+// 分配缓冲并写入日志头，失败返回 false
+bool inputLogBegin();
+
+// 每次 loop() 开始时调用，记录本次迭代的时间基准
+void inputLogTick(uint32_t nowMicros);
+
+void inputLogMpu(const MpuState &state);
+void inputLogSample(const MpuSample &sample);
+void inputLogRange(float distanceCm);
+void inputLogButton(int buttonIndex, bool longPress);
+void inputLogCollision(uint8_t kind);
+void inputLogCommand(const ConsoleCommand &command);
+void inputLogRoute(const uint8_t *data, size_t size);
+void inputLogBattery(float volts);
+
+// 以 "IL:" 前缀的十六进制行输出到串口（阻塞，仅在停车时调用）
+void inputLogDump();
+
+#else
+
+inline bool inputLogBegin() { return false; }
+inline void inputLogTick(uint32_t) {}
+inline void inputLogMpu(const MpuState &) {}
+inline void inputLogSample(const MpuSample &) {}
+inline void inputLogRange(float) {}
+inline void inputLogButton(int, bool) {}
+inline void inputLogCollision(uint8_t) {}
+inline void inputLogCommand(const ConsoleCommand &) {}
+inline void inputLogRoute(const uint8_t *, size_t) {}
+inline void inputLogBattery(float) {}
+inline void inputLogDump() {}
+
+#endif
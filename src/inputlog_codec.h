@@ -0,0 +1,110 @@
+#pragma once
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+// 输入日志编解码（不依赖 Arduino，设备端采集与主机端回放共用）
+//
+// 日志格式：
+//   头部  : 'I' 'L' 版本号 MpuState字节数
+//   Tick  : 0x01 varint(距上一 Tick 的微秒差)
+//   Mpu   : 0x02 原样的 MpuState 字节（保证回放按位一致；仅在 mpuFetch 取到新样本时记录）
+//   Range : 0x03 float 距离（cm，-1 表示超时）
+//   Button: 0x04 按键序号 | (长按 ? 0x80 : 0)
+//   Collision: 0x05 CollisionKind（传感器任务检测到的碰撞/堵转，仅在非 None 时记录）
+//   Command: 0x06 ConsoleCommandKind int16 a int16 b（串口控制台命令）
+//   Route : 0x07 varint(长度) 路线字节（从闪存载入的路线）
+//   Battery: 0x08 float 电池电压（V，一批 ADC 样本的平均值）
+//   Sample: 0x09 原样的 MpuSample 字节（加速度、角速度、芯片温度，紧跟在 Mpu 记录之后）
+// 同一 Tick 之后的记录都属于该次 loop() 迭代。
+
+static constexpr uint8_t INPUT_LOG_VERSION = 5;
+static constexpr size_t INPUT_LOG_HEADER_SIZE = 4;
+
+enum class InputLogType : uint8_t
+{
+    Tick = 0x01,
+    Mpu = 0x02,
+    Range = 0x03,
+    Button = 0x04,
+    Collision = 0x05,
+    Command = 0x06,
+    Route = 0x07,
+    Battery = 0x08,
+    Sample = 0x09
+};
+
+inline size_t inputLogWriteHeader(uint8_t *out, uint8_t mpuStateSize)
+{
+    out[0] = 'I';
+    out[1] = 'L';
+    out[2] = INPUT_LOG_VERSION;
+    out[3] = mpuStateSize;
+    return INPUT_LOG_HEADER_SIZE;
+}
+
+inline bool inputLogCheckHeader(const uint8_t *in, size_t len, uint8_t mpuStateSize)
+{
+    return len >= INPUT_LOG_HEADER_SIZE && in[0] == 'I' && in[1] == 'L' &&
+           in[2] == INPUT_LOG_VERSION && in[3] == mpuStateSize;
+}
+
+// LEB128 无符号变长整数，最多 5 字节
+inline size_t inputLogPutVarint(uint8_t *out, uint32_t value)
+{
+    size_t n = 0;
+    while (value >= 0x80)
+    {
+        out[n++] = static_cast<uint8_t>(value | 0x80);
+        value >>= 7;
+    }
+    out[n++] = static_cast<uint8_t>(value);
+    return n;
+}
+
+// 返回消耗的字节数，数据不完整时返回 0
+inline size_t inputLogGetVarint(const uint8_t *in, size_t len, uint32_t *value)
+{
+    uint32_t result = 0;
+    for (size_t i = 0; i < len && i < 5; ++i)
+    {
+        result |= static_cast<uint32_t>(in[i] & 0x7F) << (7 * i);
+        if ((in[i] & 0x80) == 0)
+        {
+            *value = result;
+            return i + 1;
+        }
+    }
+    return 0;
+}
+
+inline size_t inputLogPutFloat(uint8_t *out, float value)
+{
+    memcpy(out, &value, sizeof(value));
+    return sizeof(value);
+}
+
+inline float inputLogGetFloat(const uint8_t *in)
+{
+    float value;
+    memcpy(&value, in, sizeof(value));
+    return value;
+}
+
+inline size_t inputLogPutInt16(uint8_t *out, int16_t value)
+{
+    memcpy(out, &value, sizeof(value));
+    return sizeof(value);
+}
+
+inline int16_t inputLogGetInt16(const uint8_t *in)
+{
+    int16_t value;
+    memcpy(&value, in, sizeof(value));
+    return value;
+}
+
+inline uint8_t inputLogPackButton(int buttonIndex, bool longPress)
+{
+    return static_cast<uint8_t>((buttonIndex & 0x7F) | (longPress ? 0x80 : 0));
+}
@@ -0,0 +1,191 @@
+#include "logger.h"
+#include <atomic>
+#include <stdio.h>
+#include <string.h>
+
+static_assert((LOG_QUEUE_SIZE & (LOG_QUEUE_SIZE - 1)) == 0, "LOG_QUEUE_SIZE 必须是 2 的幂");
+
+struct LogEntry
+{
+    const char *fmt;
+    uint32_t timestampMs;
+    uint8_t level;
+    uint8_t count;
+    LogArg args[LOG_MAX_ARGS];
+};
+
+// 有界多生产者队列（Vyukov）：每个槽位带序号，生产者用 CAS 抢占写位置，无锁。
+// 序号按“相对槽位下标的偏移”保存，零初始化即为就绪状态，无需显式初始化。
+struct LogSlot
+{
+    std::atomic<uint32_t> sequence;
+    LogEntry entry;
+};
+
+static LogSlot slots[LOG_QUEUE_SIZE];
+static std::atomic<uint32_t> enqueuePos(0);
+static std::atomic<uint32_t> dequeuePos(0);
+static std::atomic<uint32_t> pushedCount(0);
+static std::atomic<uint32_t> droppedCount(0);
+static std::atomic<uint32_t> highWater(0);
+static uint32_t emittedCount = 0;
+static uint32_t reportedDrops = 0;
+static uint32_t (*clockSource)() = nullptr;
+
+void logSetClock(uint32_t (*clock)())
+{
+    clockSource = clock;
+}
+
+bool logPush(uint8_t level, const char *fmt, const LogArg *args, size_t count)
+{
+    uint32_t pos = enqueuePos.load(std::memory_order_relaxed);
+    LogSlot *slot;
+    while (true)
+    {
+        const uint32_t index = pos & (LOG_QUEUE_SIZE - 1);
+        slot = &slots[index];
+        const uint32_t sequence = slot->sequence.load(std::memory_order_acquire) + index;
+        const int32_t diff = static_cast<int32_t>(sequence - pos);
+        if (diff == 0)
+        {
+            if (enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+            {
+                break;
+            }
+        }
+        else if (diff < 0)
+        {
+            droppedCount.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        else
+        {
+            pos = enqueuePos.load(std::memory_order_relaxed);
+        }
+    }
+
+    LogEntry &entry = slot->entry;
+    entry.fmt = fmt;
+    entry.timestampMs = clockSource != nullptr ? clockSource() : 0;
+    entry.level = level;
+    entry.count = static_cast<uint8_t>(count < LOG_MAX_ARGS ? count : LOG_MAX_ARGS);
+    memcpy(entry.args, args, entry.count * sizeof(LogArg));
+    slot->sequence.store(pos + 1 - (pos & (LOG_QUEUE_SIZE - 1)), std::memory_order_release);
+
+    pushedCount.fetch_add(1, std::memory_order_relaxed);
+    // 消费者可能已越过本条，差值为负时不计入
+    const int32_t used = static_cast<int32_t>(pos + 1 - dequeuePos.load(std::memory_order_relaxed));
+    uint32_t peak = highWater.load(std::memory_order_relaxed);
+    while (used > 0 && static_cast<uint32_t>(used) > peak &&
+           !highWater.compare_exchange_weak(peak, static_cast<uint32_t>(used), std::memory_order_relaxed))
+    {
+    }
+    return true;
+}
+
+static bool logPop(LogEntry *out)
+{
+    const uint32_t pos = dequeuePos.load(std::memory_order_relaxed);
+    const uint32_t index = pos & (LOG_QUEUE_SIZE - 1);
+    LogSlot &slot = slots[index];
+    const uint32_t sequence = slot.sequence.load(std::memory_order_acquire) + index;
+    if (static_cast<int32_t>(sequence - (pos + 1)) < 0)
+    {
+        return false;
+    }
+    *out = slot.entry;
+    slot.sequence.store(pos + LOG_QUEUE_SIZE - index, std::memory_order_release);
+    dequeuePos.store(pos + 1, std::memory_order_relaxed);
+    return true;
+}
+
+static size_t append(char *out, size_t size, size_t n, const char *text)
+{
+    while (*text != '\0' && n + 1 < size)
+    {
+        out[n++] = *text++;
+    }
+    return n;
+}
+
+size_t logFormat(char *out, size_t size, uint8_t level, uint32_t timestampMs, const char *fmt, const LogArg *args, size_t count)
+{
+    if (size == 0)
+    {
+        return 0;
+    }
+
+    static const char *const LEVEL_TAGS[] = {"D", "I", "W", "E"};
+    char scratch[24];
+    snprintf(scratch, sizeof(scratch), "[%lu %s] ", static_cast<unsigned long>(timestampMs),
+             level < 4 ? LEVEL_TAGS[level] : "?");
+    size_t n = append(out, size, 0, scratch);
+
+    size_t argIndex = 0;
+    for (const char *p = fmt; *p != '\0' && n + 1 < size; ++p)
+    {
+        if (p[0] == '{' && p[1] == '}' && argIndex < count)
+        {
+            const LogArg &arg = args[argIndex++];
+            switch (arg.type)
+            {
+            case LogArgType::Int:
+                snprintf(scratch, sizeof(scratch), "%ld", static_cast<long>(arg.i));
+                n = append(out, size, n, scratch);
+                break;
+            case LogArgType::Uint:
+                snprintf(scratch, sizeof(scratch), "%lu", static_cast<unsigned long>(arg.u));
+                n = append(out, size, n, scratch);
+                break;
+            case LogArgType::Float:
+                snprintf(scratch, sizeof(scratch), "%.2f", static_cast<double>(arg.f));
+                n = append(out, size, n, scratch);
+                break;
+            case LogArgType::Str:
+                n = append(out, size, n, arg.s != nullptr ? arg.s : "(null)");
+                break;
+            }
+            ++p;
+            continue;
+        }
+        out[n++] = *p;
+    }
+    out[n] = '\0';
+    return n;
+}
+
+size_t logDrain(void (*sink)(const char *line), size_t maxLines)
+{
+    char line[LOG_LINE_MAX];
+    size_t handled = 0;
+
+    // 自上次输出以来新增的丢弃数作为一条独立提示
+    const uint32_t drops = droppedCount.load(std::memory_order_relaxed);
+    if (drops != reportedDrops)
+    {
+        snprintf(line, sizeof(line), "[log] 队列已满，丢弃 %lu 条", static_cast<unsigned long>(drops - reportedDrops));
+        reportedDrops = drops;
+        sink(line);
+    }
+
+    LogEntry entry;
+    while (handled < maxLines && logPop(&entry))
+    {
+        logFormat(line, sizeof(line), entry.level, entry.timestampMs, entry.fmt, entry.args, entry.count);
+        sink(line);
+        ++handled;
+        ++emittedCount;
+    }
+    return handled;
+}
+
+LogStats logGetStats()
+{
+    LogStats stats;
+    stats.pushed = pushedCount.load(std::memory_order_relaxed);
+    stats.dropped = droppedCount.load(std::memory_order_relaxed);
+    stats.emitted = emittedCount;
+    stats.highWater = highWater.load(std::memory_order_relaxed);
+    return stats;
+}
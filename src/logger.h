@@ -0,0 +1,123 @@
+#pragma once
+#include <stddef.h>
+#include <stdint.h>
+
+// 延迟日志：热路径只把格式串指针与参数拷入无锁环形队列，由低优先级任务格式化并输出到串口，
+// 串口发送缓冲写满时也不会阻塞控制循环。队列满时丢弃并计数。
+// 格式串用 {} 作为占位符，必须是字符串字面量（只保存指针）；字符串参数同样只保存指针。
+// 编译期按 LOG_LEVEL 过滤，低于该级别的调用连同参数求值一起被编译器消除。
+
+#define LOG_LEVEL_DEBUG 0
+#define LOG_LEVEL_INFO 1
+#define LOG_LEVEL_WARN 2
+#define LOG_LEVEL_ERROR 3
+#define LOG_LEVEL_NONE 4
+
+#ifndef LOG_LEVEL
+#define LOG_LEVEL LOG_LEVEL_INFO
+#endif
+
+static constexpr size_t LOG_QUEUE_SIZE = 64; // 必须是 2 的幂
+static constexpr size_t LOG_MAX_ARGS = 4;
+static constexpr size_t LOG_LINE_MAX = 160;
+
+enum class LogArgType : uint8_t
+{
+    Int,
+    Uint,
+    Float,
+    Str
+};
+
+struct LogArg
+{
+    LogArgType type;
+    union
+    {
+        int32_t i;
+        uint32_t u;
+        float f;
+        const char *s;
+    };
+};
+
+struct LogStats
+{
+    uint32_t pushed;    // 成功入队
+    uint32_t dropped;   // 队列满被丢弃
+    uint32_t emitted;   // 已输出
+    uint32_t highWater; // 队列最大占用
+};
+
+inline LogArg logArg(int v)
+{
+    LogArg a;
+    a.type = LogArgType::Int;
+    a.i = v;
+    return a;
+}
+// 无符号参数单独保存，millis()、计数器超过 INT32_MAX 时不会显示成负数
+inline LogArg logArg(unsigned v)
+{
+    LogArg a;
+    a.type = LogArgType::Uint;
+    a.u = static_cast<uint32_t>(v);
+    return a;
+}
+inline LogArg logArg(long v) { return logArg(static_cast<int>(v)); }
+inline LogArg logArg(unsigned long v) { return logArg(static_cast<unsigned>(v)); }
+inline LogArg logArg(bool v) { return logArg(v ? 1 : 0); }
+inline LogArg logArg(float v)
+{
+    LogArg a;
+    a.type = LogArgType::Float;
+    a.f = v;
+    return a;
+}
+inline LogArg logArg(double v) { return logArg(static_cast<float>(v)); }
+inline LogArg logArg(const char *v)
+{
+    LogArg a;
+    a.type = LogArgType::Str;
+    a.s = v;
+    return a;
+}
+
+// 时间戳来源（设备端为 millis），未设置时记为 0
+void logSetClock(uint32_t (*clock)());
+
+// 入队，队列满时返回 false 并累加丢弃计数；可在任意任务中调用
+bool logPush(uint8_t level, const char *fmt, const LogArg *args, size_t count);
+
+// 取出最多 maxLines 条并格式化后交给 sink，返回处理条数（单消费者）
+size_t logDrain(void (*sink)(const char *line), size_t maxLines);
+
+// 按 {} 占位符格式化一条日志，返回写入长度
+size_t logFormat(char *out, size_t size, uint8_t level, uint32_t timestampMs, const char *fmt, const LogArg *args, size_t count);
+
+LogStats logGetStats();
+
+// 启动输出任务（设备端实现于 logger_task.cpp）
+void logBegin();
+
+template <typename... ARGS>
+inline void logWrite(uint8_t level, const char *fmt, ARGS... args)
+{
+    static_assert(sizeof...(ARGS) <= LOG_MAX_ARGS, "日志参数过多");
+    const LogArg packed[] = {logArg(args)..., logArg(0)};
+    logPush(level, fmt, packed, sizeof...(ARGS));
+}
+
+#define LOG_AT(level, ...)                \
+    do                                    \
+    {                                     \
+        if (LOG_LEVEL <= (level))         \
+        {                                 \
+            logWrite((level), __VA_ARGS__); \
+        }                                 \
+    } while (0)
+
+#define LOG_DEBUG(...) LOG_AT(LOG_LEVEL_DEBUG, __VA_ARGS__)
+#define LOG_INFO(...) LOG_AT(LOG_LEVEL_INFO, __VA_ARGS__)
+#define LOG_WARN(...) LOG_AT(LOG_LEVEL_WARN, __VA_ARGS__)
+#define LOG_ERROR(...) LOG_AT(LOG_LEVEL_ERROR, __VA_ARGS__)
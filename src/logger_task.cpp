@@ -0,0 +1,40 @@
+#include <Arduino.h>
+#include "logger.h"
+
+// 日志输出任务：运行在核心 0、最低应用优先级，串口阻塞只会拖慢本任务
+static constexpr uint32_t LOG_TASK_STACK = 4096;
+static constexpr UBaseType_t LOG_TASK_PRIORITY = 1;
+static constexpr size_t LOG_LINES_PER_WAKE = 8;
+
+static uint32_t logClock()
+{
+    return millis();
+}
+
+static void serialSink(const char *line)
+{
+    Serial.println(line);
+}
+
+static void logTask(void *)
+{
+    while (true)
+    {
+        if (logDrain(serialSink, LOG_LINES_PER_WAKE) == 0)
+        {
+            vTaskDelay(pdMS_TO_TICKS(10));
+        }
+    }
+}
+
+void logBegin()
+{
+    static bool started = false;
+    if (started)
+    {
+        return;
+    }
+    started = true;
+    logSetClock(logClock);
+    xTaskCreatePinnedToCore(logTask, "log", LOG_TASK_STACK, nullptr, LOG_TASK_PRIORITY, nullptr, 0);
+}
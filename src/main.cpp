@@ -5,6 +5,25 @@
 #include "buttons.h" // 新增：按键模块头文件
 #include "ultrasonic.h"
 #include "mpu.h"
+#include "inputlog.h"
+#include "ranging.h"
+#include "motion.h"
+#include "logger.h"
+#include "supervisor.h"
+#include "spectrum.h"
+#include "governor.h"
+#include "boot.h"
+#include "console.h"
+#include "route.h"
+#include "route_store.h"
+#include "motorid.h"
+#include "motorid_store.h"
+#include "battery.h"
+#include "battery_adc.h"
+#include "behavior.h"
+#include "sonar.h"
+#include "thermal_bias_store.h"
+#include "stripchart.h"
 
 // Function prototype for clearDisplay
 void clearDisplay();
@@ -13,8 +32,17 @@ void displaySetTraveledDistance(float distanceMeters);
 // 业务状态：默认电机关闭、OLED关闭、方向前进
 static bool motorEnabled = false;
 static bool motorForward = true;
-static bool displayEnabled = true;
-static const int SPEED_LEVELS[] = {150, 200, 255};
+// OLED 页面：K2 短按按 关闭 → 状态 → 曲线 → 关闭 循环
+enum class DisplayPage : uint8_t
+{
+  Off,
+  Status,
+  StripChart
+};
+static DisplayPage displayPage = DisplayPage::Status;
+// 曲线页下次更新需整屏重绘（进入页面、量程变化或显示屏恢复后）
+static bool stripRedrawPending = true;
+static const int SPEED_LEVELS[] = {150, 200, 255}; // 档位：前进时作为调速器的速度上限
 static constexpr size_t SPEED_LEVEL_COUNT = sizeof(SPEED_LEVELS) / sizeof(SPEED_LEVELS[0]);
 static size_t speedLevelIndex = 1;
 static int baseSpeed = SPEED_LEVELS[speedLevelIndex];
@@ -29,64 +57,442 @@ static float deltaTime = 0.0f;
 static constexpr uint32_t REVERSE_DURATION_MS = 3000;
 static constexpr uint32_t PAUSE_DURATION_MS = 2000;
 static constexpr float TARGET_YAW_CHANGE = 45.0f;
-enum class AvoidState
-{
-  Idle,
-  Reversing,
-  PauseAfterReverse,
-  Rotating,
-  PauseAfterRotate
-};
-static AvoidState avoidState = AvoidState::Idle;
-static unsigned long avoidStateStartMs = 0;
-static float avoidInitialYaw = 0.0f;
+// 避障脚本：后退 → 暂停 → 原地转向 → 暂停（见 avoidScript）
+static bool avoidScript(Behavior &self, uint32_t nowMs);
+static void avoidCancelled();
+static Behavior avoidBehavior = {avoidScript, avoidCancelled, 0, false, 0};
+static bool avoidReversing = false;
 static float lastDistanceCm = -1.0f;
 static float totalDistanceMeters = 0.0f;
+// 监督降级：测距陈旧时停车；显示与 IMU 的恢复尝试间隔
+static bool rangingHalted = false;
+static constexpr uint32_t IMU_RETRY_INTERVAL_MS = 1000;
+static constexpr uint32_t DISPLAY_RETRY_INTERVAL_MS = 2000;
+static constexpr uint32_t DEADLINE_REPORT_INTERVAL_MS = 1000;
+
+// 前进时由速度调节器按前方距离连续调速（见 loop），档位只作为上限
+static bool governing = false;
+
+// 串口遥控：直接给定两侧速度，不经过速度调节器
+static bool remoteDriving = false;
+static int remoteSpeedA = 0;
+static int remoteSpeedB = 0;
+// 路线复现：前方距离低于停车距离时暂停，超过停车距离加余量后继续
+static bool playbackBlocked = false;
+static constexpr float PLAYBACK_CLEAR_MARGIN_CM = 5.0f;
+// 录制结束后的路线等电机停下再写入闪存（复现直接使用内存中的路线）
+static bool routeSavePending = false;
+// 组内连续测量与组间测距遵守同一个传感器测量周期
+static_assert(SONAR_PING_GAP_MS >= RANGING_MIN_INTERVAL_MS, "超声组内测量间隔短于传感器测量周期");
+// 电机前馈补偿表（启动时从闪存载入，辨识完成后更新）
+static MotorIdTable motorTable = {};
+static bool motorTableLoaded = false;
+// 电池电压：每 100 ms 取一次 DMA 缓冲中的样本平均
+static constexpr uint32_t BATTERY_INTERVAL_MS = 100;
+// 温度-零偏模型：静止时保存到闪存，两次保存至少间隔 10 min 且新学习了至少 10 s 的静止样本，控制闪存写入次数
+static constexpr uint32_t THERMAL_CHECK_INTERVAL_MS = 1000;
+static constexpr uint32_t THERMAL_SAVE_INTERVAL_MS = 600000;
+static constexpr uint32_t THERMAL_SAVE_MIN_SAMPLES = 5000;
+static ThermalBiasTable thermalTable = {};
+static uint32_t thermalSavedSamples = 0;
 
 // 应用电机状态
 static void applyMotorState()
 {
-  if (!motorEnabled)
+  if (!motorEnabled || rangingHalted)
   {
     motors(0, 0);
     return;
   }
-  const int effectiveSpeed = motorForward ? baseSpeed : -baseSpeed;
-  motors(effectiveSpeed, effectiveSpeed);
+  if (remoteDriving)
+  {
+    motors(remoteSpeedA, remoteSpeedB);
+    return;
+  }
+  if (motorForward)
+  {
+    return;
+  }
+  motors(-baseSpeed, -baseSpeed);
+}
+
+// 辨识期间关闭前馈，结束或中止后恢复
+static void restoreFeedForward()
+{
+  motorsSetFeedForward(motorTableLoaded ? &motorTable : nullptr);
+}
+
+static void cancelMotorId()
+{
+  if (!motorIdRunning())
+  {
+    return;
+  }
+  motorIdAbort();
+  motors(0, 0);
+  restoreFeedForward();
+  LOG_INFO("电机辨识中止");
+}
+
+// 停车并结束遥控、复现与电机辨识
+static void stopDriving()
+{
+  cancelMotorId();
+  motorEnabled = false;
+  remoteDriving = false;
+  if (routePlaying())
+  {
+    routePlaybackStop();
+    LOG_INFO("路线复现中止");
+  }
+  applyMotorState();
+}
+
+// 严重低电量时不再启动任何行驶
+static bool batteryRefusesDrive()
+{
+  if (batteryLevel() != BatteryLevel::Critical)
+  {
+    return false;
+  }
+  LOG_WARN("电池电量严重不足，拒绝启动电机");
+  return true;
+}
+
+static void startRecording()
+{
+  const MpuState &mpuState = mpuGetState();
+  routeRecordBegin(millis(), mpuState.yaw, totalDistanceMeters);
+  routeSavePending = false; // 新录制覆盖缓冲，尚未保存的上一条路线作废
+  LOG_INFO("开始录制路线");
+}
+
+static void finishRecording()
+{
+  const MpuState &mpuState = mpuGetState();
+  routeRecordEnd(millis(), mpuState.yaw, totalDistanceMeters);
+  const RouteMetrics &route = routeGetMetrics();
+  LOG_INFO("路线录制结束：{} 条记录，{} 字节，{} ms", route.points, route.bytes, route.durationMs);
+  routeSavePending = true;
+}
+
+// 写入闪存会阻塞数十毫秒，等两侧电机命令都为 0 时再保存录制结束的路线
+static void saveRouteWhenStopped()
+{
+  if (!routeSavePending || getSpeedA() != 0 || getSpeedB() != 0)
+  {
+    return;
+  }
+  routeSavePending = false;
+  if (!routeStoreSave())
+  {
+    LOG_WARN("路线保存到闪存失败");
+    return;
+  }
+  LOG_INFO("路线已保存到闪存");
+}
+
+static void startPlayback()
+{
+  if (batteryRefusesDrive())
+  {
+    return;
+  }
+  cancelMotorId();
+  if (routeRecording())
+  {
+    finishRecording();
+  }
+  if (routeSize() == 0)
+  {
+    if (!routeStoreLoad())
+    {
+      LOG_WARN("没有可复现的路线");
+      return;
+    }
+    inputLogRoute(routeData(), routeSize());
+  }
+  const MpuState &mpuState = mpuGetState();
+  if (!routePlaybackBegin(millis(), mpuState.yaw, totalDistanceMeters))
+  {
+    LOG_WARN("没有可复现的路线");
+    return;
+  }
+  // 复现期间由路线接管电机：取消运动原语与避障流程
+  motionCancel();
+  behaviorCancel(avoidBehavior);
+  remoteDriving = false;
+  playbackBlocked = false;
+  motorEnabled = true;
+  LOG_INFO("开始复现路线：{} 条记录，{} ms", routeGetMetrics().points, routeGetMetrics().durationMs);
+}
+
+static void startMotorId()
+{
+  if (motorIdRunning() || batteryRefusesDrive())
+  {
+    return;
+  }
+  if (bootState(BootPhase::Imu) != BootPhaseState::Done || supervisorDegraded(Subsystem::Imu))
+  {
+    LOG_WARN("IMU 不可用，无法辨识电机");
+    return;
+  }
+  stopDriving();
+  motorsSetFeedForward(nullptr); // 辨识按原始占空比输出
+  motorIdBegin(millis());
+  LOG_INFO("开始电机辨识（约 36 s），小车将原地转动");
+}
+
+static void finishMotorId()
+{
+  MotorIdTable table;
+  if (!motorIdFitLast(&table))
+  {
+    restoreFeedForward();
+    LOG_WARN("电机辨识失败：有一侧在最大占空比下仍不转动");
+    return;
+  }
+  motorTable = table;
+  motorTableLoaded = true;
+  restoreFeedForward();
+  LOG_INFO("电机辨识完成：左侧死区 {}/{}，右侧死区 {}/{}（前进/后退）", table.deadband[0][0], table.deadband[0][1],
+           table.deadband[1][0], table.deadband[1][1]);
+  LOG_INFO("命令 255 对应单侧驱动偏航 {}°/s", table.maxRateDps);
+  if (!motorIdStoreSave(table))
+  {
+    LOG_WARN("电机辨识结果保存到闪存失败");
+  }
+}
+
+// 写入闪存会阻塞数十毫秒，只在静止（电机已停）时进行
+static void saveThermalModel(uint32_t nowMs)
+{
+  static uint32_t lastCheckMs = 0;
+  static uint32_t lastSaveMs = 0;
+  if (nowMs - lastCheckMs < THERMAL_CHECK_INTERVAL_MS)
+  {
+    return;
+  }
+  lastCheckMs = nowMs;
+  if (lastSaveMs != 0 && nowMs - lastSaveMs < THERMAL_SAVE_INTERVAL_MS)
+  {
+    return;
+  }
+  const MpuDriftMetrics drift = mpuGetDriftMetrics();
+  if (!drift.stationary || drift.thermalSamples - thermalSavedSamples < THERMAL_SAVE_MIN_SAMPLES ||
+      !mpuGetThermalTable(&thermalTable))
+  {
+    return;
+  }
+  lastSaveMs = nowMs;
+  if (!thermalBiasStoreSave(thermalTable))
+  {
+    LOG_WARN("温度-零偏模型保存到闪存失败");
+    return;
+  }
+  thermalSavedSamples = drift.thermalSamples;
+  LOG_INFO("温度-零偏模型已保存：{} 个温度表点，芯片温度 {} °C", drift.thermalBins, drift.temperatureC);
+}
+
+static void logImuInfo()
+{
+  const MpuDriftMetrics drift = mpuGetDriftMetrics();
+  LOG_INFO("IMU：芯片温度 {} °C，温度模型 {} 个表点，当前 Z 轴零偏修正 {}°/s", drift.temperatureC, drift.thermalBins,
+           drift.thermalShiftZ);
+  LOG_INFO("航向漂移 {}°/min（不用温度模型 {}°/min，仅开机零偏 {}°/min）", drift.headingDriftDegPerMin,
+           drift.uncompensatedDriftDegPerMin, drift.bootBiasDriftDegPerMin);
+}
+
+static void logRangingInfo(uint32_t nowMs)
+{
+  const RangingMetrics &ranging = rangingGetMetrics();
+  const uint32_t staleMs = rangingStalenessMs(nowMs);
+  LOG_INFO("测距：{} 次，超时 {} 次，目标间隔 {} ms，实际平均 {} ms", ranging.samples, ranging.timeouts, ranging.targetIntervalMs,
+           ranging.meanIntervalMs);
+  LOG_INFO("有效距离陈旧 {} ms（最长 {} ms）", staleMs == UINT32_MAX ? -1 : static_cast<int32_t>(staleMs), ranging.maxStalenessMs);
+  const GovernorMetrics &governor = governorGetMetrics();
+  LOG_INFO("调速：预估距离 {} cm，接近速度 {} cm/s，允许速度 {}", governor.effectiveCm, governor.closingSpeedCmS, governor.allowedSpeed);
+  LOG_INFO("调速停车 {} 次，卡住停车 {} 次", governor.stops, governor.stalls);
+  const SonarMetrics &sonar = sonarGetMetrics();
+  LOG_INFO("超声：{} 组 {} 次测量，提前结束 {} 组，剔除读数 {} 次", sonar.bursts, sonar.pings, sonar.earlyStops, sonar.outliers);
+  LOG_INFO("低置信度 {} 组，组延迟 {} ms（最长 {} ms）", sonar.lowConfidence, sonar.lastLatencyMs, sonar.maxLatencyMs);
+}
+
+static void logQueueInfo()
+{
+  const LogStats stats = logGetStats();
+  LOG_INFO("日志：入队 {} 条，丢弃 {} 条，已输出 {} 条，队列最高占用 {}", stats.pushed, stats.dropped, stats.emitted, stats.highWater);
+}
+
+static void logHealthInfo()
+{
+  for (size_t i = 0; i < SUBSYSTEM_COUNT; ++i)
+  {
+    const Subsystem subsystem = static_cast<Subsystem>(i);
+    const SubsystemHealth &health = supervisorGetHealth(subsystem);
+    LOG_INFO("{}：{}，降级 {} 次，恢复 {} 次", supervisorName(subsystem), health.degraded ? "降级" : "正常", health.degradations,
+             health.recoveries);
+    LOG_INFO("  故障 {} 次，陈旧 {} 次，截止时间错过 {} 次，最长 {} us", health.faults, health.staleEvents, health.deadlineMisses,
+             health.maxDurationUs);
+  }
+}
+
+// 截止时间错过不影响降级判定，每秒汇总一次新增的错过次数，避免逐次刷屏
+static void reportDeadlineMisses(uint32_t nowMs)
+{
+  static uint32_t lastReportMs = 0;
+  static uint32_t reportedMisses[SUBSYSTEM_COUNT] = {};
+  if (nowMs - lastReportMs < DEADLINE_REPORT_INTERVAL_MS)
+  {
+    return;
+  }
+  lastReportMs = nowMs;
+  for (size_t i = 0; i < SUBSYSTEM_COUNT; ++i)
+  {
+    const Subsystem subsystem = static_cast<Subsystem>(i);
+    const SubsystemHealth &health = supervisorGetHealth(subsystem);
+    if (health.deadlineMisses != reportedMisses[i])
+    {
+      LOG_WARN("监督：{}错过截止时间 {} 次（预算 {} us，最近一次 {} us）", supervisorName(subsystem),
+               health.deadlineMisses - reportedMisses[i], supervisorGetBudget(subsystem).deadlineUs, health.lastMissUs);
+      reportedMisses[i] = health.deadlineMisses;
+    }
+  }
+}
+
+static void handleConsoleCommand(const ConsoleCommand &command)
+{
+  inputLogCommand(command);
+  switch (command.kind)
+  {
+  case ConsoleCommandKind::Drive:
+    if (batteryRefusesDrive())
+    {
+      break;
+    }
+    cancelMotorId();
+    if (routePlaying())
+    {
+      routePlaybackStop();
+      LOG_INFO("路线复现中止");
+    }
+    remoteDriving = true;
+    remoteSpeedA = command.a;
+    remoteSpeedB = command.b;
+    motorEnabled = true;
+    if (!behaviorRunning(avoidBehavior))
+    {
+      applyMotorState();
+    }
+    break;
+  case ConsoleCommandKind::Stop:
+    stopDriving();
+    break;
+  case ConsoleCommandKind::Record:
+    startRecording();
+    break;
+  case ConsoleCommandKind::EndRecord:
+    if (routeRecording())
+    {
+      finishRecording();
+    }
+    break;
+  case ConsoleCommandKind::Play:
+    startPlayback();
+    break;
+  case ConsoleCommandKind::RouteInfo:
+  {
+    const RouteMetrics &route = routeGetMetrics();
+    LOG_INFO("路线：{} 条记录，{} 字节，{} ms，{} m", route.points, route.bytes, route.durationMs, route.distanceM);
+    LOG_INFO("上次复现：最大航向误差 {}°，暂停 {} 次，距离误差 {} m", route.maxHeadingErrorDeg, route.pauses, route.distanceErrorM);
+    break;
+  }
+  case ConsoleCommandKind::MotorId:
+    startMotorId();
+    break;
+  case ConsoleCommandKind::ImuInfo:
+    logImuInfo();
+    break;
+  case ConsoleCommandKind::RangingInfo:
+    logRangingInfo(millis());
+    break;
+  case ConsoleCommandKind::LogInfo:
+    logQueueInfo();
+    break;
+  case ConsoleCommandKind::HealthInfo:
+    logHealthInfo();
+    break;
+  case ConsoleCommandKind::None:
+    break;
+  }
+}
+
+static void logStripChartMetrics()
+{
+  const DisplayStripMetrics &strip = displayStripMetrics();
+  if (strip.columnUpdates == 0)
+  {
+    return;
+  }
+  const uint32_t meanMicros = strip.totalColumnMicros / strip.columnUpdates;
+  LOG_INFO("曲线页：按列更新 {} 次，每次 {} 字节，平均 {} us（最长 {} us）", strip.columnUpdates, strip.columnBytes, meanMicros,
+           strip.maxColumnMicros);
+  LOG_INFO("整屏重绘 {} 次，最近一次 {} us；按列更新最高约 {} 列/秒", strip.fullRedraws, strip.redrawMicros,
+           meanMicros > 0 ? 1000000 / meanMicros : 0);
 }
 
 // 新增：按键事件回调（短按）
 static void onShortPress(int buttonIndex)
 {
+  inputLogButton(buttonIndex, false);
   switch (buttonIndex)
   {
   case 0: // K1：速度档位循环
   {
     speedLevelIndex = (speedLevelIndex + 1) % SPEED_LEVEL_COUNT;
     baseSpeed = SPEED_LEVELS[speedLevelIndex];
-    Serial.print("速度档位切换为：");
-    Serial.println(baseSpeed);
+    LOG_INFO("速度档位切换为：{}", baseSpeed);
     if (motorEnabled)
     {
       applyMotorState();
     }
     break;
   }
-  case 1: // K2：OLED 开/关（仅影响是否刷新显示）
-    displayEnabled = !displayEnabled;
-    if (!displayEnabled)
+  case 1: // K2：切换 OLED 页面（仅影响显示内容）
+    switch (displayPage)
     {
+    case DisplayPage::Off:
+      displayPage = DisplayPage::Status;
+      LOG_INFO("OLED：状态页");
+      break;
+    case DisplayPage::Status:
+      displayPage = DisplayPage::StripChart;
+      stripRedrawPending = true;
+      LOG_INFO("OLED：曲线页（上：距离，中：偏航角速度，下：电机命令）");
+      break;
+    case DisplayPage::StripChart:
+      displayPage = DisplayPage::Off;
       clearDisplay(); // 清屏并黑屏
+      logStripChartMetrics();
+      LOG_INFO("OLED：显示关闭");
+      break;
     }
-    Serial.println(displayEnabled ? "OLED：显示开启" : "OLED：显示关闭");
     break;
-  case 2: // K3：电机启停
-    motorEnabled = !motorEnabled;
-    applyMotorState();
-    Serial.println(motorEnabled ? "电机：启动" : "电机：停止");
+  case 2: // K3：电机启停（辨识中则中止辨识）
+    if (motorEnabled || motorIdRunning())
+    {
+      stopDriving();
+    }
+    else if (!batteryRefusesDrive())
+    {
+      motorEnabled = true;
+      applyMotorState();
+    }
+    LOG_INFO(motorEnabled ? "电机：启动" : "电机：停止");
     break;
   case 3: // K4：系统重启
-    Serial.println("系统重启中...");
+    LOG_INFO("系统重启中...");
     delay(100);
     ESP.restart();
     break;
@@ -98,141 +504,383 @@ static void onShortPress(int buttonIndex)
 // 新增：按键事件回调（长按）
 static void onLongPress(int buttonIndex)
 {
+  inputLogButton(buttonIndex, true);
   if (buttonIndex == 0)
   {
     motorForward = !motorForward;
-    Serial.println(motorForward ? "方向：前进" : "方向：后退");
+    LOG_INFO(motorForward ? "方向：前进" : "方向：后退");
     if (motorEnabled)
     {
       applyMotorState();
     }
     return;
   }
-  Serial.print("按键");
-  Serial.print(buttonIndex + 1);
-  Serial.println(" 长按");
+  if (buttonIndex == 1) // K2 长按：开始/结束录制路线
+  {
+    if (routeRecording())
+    {
+      finishRecording();
+    }
+    else
+    {
+      startRecording();
+    }
+    return;
+  }
+  if (buttonIndex == 2) // K3 长按：开始/中止复现路线
+  {
+    if (routePlaying())
+    {
+      stopDriving();
+    }
+    else
+    {
+      startPlayback();
+    }
+    return;
+  }
+  if (buttonIndex == 3) // K4 长按：导出输入日志（仅 INPUT_LOG_CAPTURE 构建有效）
+  {
+    inputLogDump();
+  }
+  LOG_INFO("按键{} 长按", buttonIndex + 1);
 }
 
-void setup()
+// ---- 启动流水线 ----
+static constexpr uint32_t BOOT_PROGRESS_INTERVAL_MS = 100;
+static constexpr uint32_t IMU_BOOT_TASK_STACK = 4096;
+
+// IMU 初始化与两次校准约 10 s，放到独立任务中，与其余阶段重叠
+static void imuBootTask(void *)
 {
-  Serial.begin(115200);
+  const bool ok = mpuInit(MPU6050_SDA, MPU6050_SCL);
+  bootFinish(BootPhase::Imu, micros(), ok);
+  // 初始化失败也启动采样任务，监督模块恢复传感器后即可继续采样
+  mpuStartTask();
+  vTaskDelete(nullptr);
+}
 
-  initMotors();
+static void startBootPhase(BootPhase phase)
+{
+  bootStart(phase, micros());
+  bool ok = true;
+  switch (phase)
+  {
+  case BootPhase::Motors:
+    initMotors();
+    standby(); // IMU 就绪前保持待机
+    Serial.println("TB6612FNG 电机驱动初始化完成");
+    motorTableLoaded = motorIdStoreLoad(&motorTable);
+    restoreFeedForward();
+    Serial.println(motorTableLoaded ? "已载入电机前馈补偿表" : "未找到电机辨识结果，按原始占空比驱动（串口发送 id 辨识）");
+    break;
+  case BootPhase::Display:
+    ok = initDisplay();
+    Serial.println(ok ? "OLED 初始化成功" : "SSD1306初始化失败，以无显示模式运行");
+    break;
+  case BootPhase::Imu:
+    if (thermalBiasStoreLoad(&thermalTable) && mpuSetThermalTable(thermalTable))
+    {
+      Serial.println("已载入温度-零偏模型");
+    }
+    else
+    {
+      Serial.println("未找到温度-零偏模型，静止时在线学习");
+    }
+    if (xTaskCreatePinnedToCore(imuBootTask, "imu-boot", IMU_BOOT_TASK_STACK, nullptr, 2, nullptr, 0) == pdPASS)
+    {
+      return; // 由任务结束本阶段
+    }
+    ok = false;
+    break;
+  case BootPhase::Buttons:
+    buttonsInit();
+    buttonsSetShortPressHandler(onShortPress);
+    buttonsSetLongPressHandler(onLongPress);
+    break;
+  case BootPhase::Ultrasonic:
+    ok = initUltrasonic();
+    break;
+  case BootPhase::Drive:
+    wakeup();
+    break;
+  case BootPhase::Battery:
+    ok = batteryAdcBegin();
+    Serial.println(ok ? "电池电压采样已启动" : "电池电压 ADC 初始化失败，不做电压补偿");
+    break;
+  }
+  bootFinish(phase, micros(), ok);
+}
 
-  if (!initDisplay())
+static void showBootProgress()
+{
+  if (bootState(BootPhase::Display) != BootPhaseState::Done)
   {
-    Serial.println(F("SSD1306初始化失败"));
-    while (true)
-      delay(100);
+    return;
   }
-  else
+  static const char MARKS[] = {'.', '>', '*', 'x'}; // 等待、进行中、完成、失败
+  const char *names[BOOT_PHASE_COUNT];
+  char marks[BOOT_PHASE_COUNT];
+  for (size_t i = 0; i < BOOT_PHASE_COUNT; ++i)
   {
-    Serial.println("OLED 初始化成功");
+    const BootPhase phase = static_cast<BootPhase>(i);
+    names[i] = bootPhaseName(phase);
+    marks[i] = MARKS[static_cast<size_t>(bootState(phase))];
   }
+  displayBootProgress(names, marks, BOOT_PHASE_COUNT, mpuCalibrationPercent());
+}
 
-  Serial.println("TB6612FNG 电机驱动初始化完成");
+static void bootReportLine(const char *line)
+{
+  Serial.println(line);
+}
 
-  // 新增：初始化超声波
-  initUltrasonic();
+// 按依赖顺序启动各阶段，等待期间刷新进度
+static void runBootPipeline()
+{
+  bootInit(micros());
+  uint32_t lastProgressMs = 0;
+  while (!bootComplete())
+  {
+    for (size_t i = 0; i < BOOT_PHASE_COUNT; ++i)
+    {
+      const BootPhase phase = static_cast<BootPhase>(i);
+      if (bootRunnable(phase))
+      {
+        startBootPhase(phase);
+      }
+    }
+    if (millis() - lastProgressMs >= BOOT_PROGRESS_INTERVAL_MS)
+    {
+      lastProgressMs = millis();
+      showBootProgress();
+    }
+    delay(10);
+  }
+  showBootProgress();
+  bootReport(bootReportLine);
+}
 
-  // 初始化按键（模块化）
-  buttonsInit();
-  buttonsSetShortPressHandler(onShortPress);
-  buttonsSetLongPressHandler(onLongPress);
+void setup()
+{
+  Serial.begin(115200);
+  logBegin();
+
+  runBootPipeline();
 
-  // 初始化MPU6050
-  if (!mpuInit(MPU6050_SDA, MPU6050_SCL))
+  // 监督从启动完成时开始计时；启动失败的外设不停机，以降级模式运行并由监督定期尝试恢复
+  supervisorInit(millis());
+  if (bootState(BootPhase::Display) == BootPhaseState::Failed)
   {
-    Serial.println("找不到MPU6050芯片！");
-    while (true)
-      delay(10);
+    supervisorReportFault(Subsystem::Display, millis());
+  }
+  if (bootState(BootPhase::Imu) == BootPhaseState::Failed)
+  {
+    Serial.println("找不到MPU6050芯片，转向改为开环");
+    supervisorReportFault(Subsystem::Imu, millis());
   }
-  Serial.println("MPU6050初始化成功！");
 
   // 默认：电机关闭、OLED关闭、方向前进
   motorEnabled = false;
   motorForward = true;
-  displayEnabled = false;
+  displayPage = DisplayPage::Off;
+  stripChartReset();
   applyMotorState();
 
+  // 振动频谱的采样窗口放在 PSRAM
+  if (spectrumInit(static_cast<float *>(ps_malloc(SPECTRUM_STORAGE_BYTES))))
+  {
+    Serial.println("振动频谱分析已启用");
+  }
+
+  if (inputLogBegin())
+  {
+    Serial.println("输入日志采集已启用，K4 长按导出");
+  }
+
   lastMicros = micros();
 }
 
-static void updateObstacleAvoidance(float distanceCm, bool hasFreshSample)
+// 声速修正用的气温：IMU 可用时取 MPU6050 芯片温度减去自热偏差
+static float airTemperatureC()
 {
-  if (!motorEnabled && avoidState != AvoidState::Idle)
+  if (bootState(BootPhase::Imu) != BootPhaseState::Done || supervisorDegraded(Subsystem::Imu))
   {
-    motors(0, 0);
-    avoidState = AvoidState::Idle;
-    obstacleDetected = false;
+    return SONAR_DEFAULT_TEMPERATURE_C;
   }
+  return mpuGetSample().temperatureC - SONAR_IMU_DIE_OFFSET_C;
+}
 
-  if (hasFreshSample)
+// 运动原语所需的实时输入
+static MotionInput currentMotionInput()
+{
+  const MpuState &mpuState = mpuGetState();
+  return {static_cast<uint32_t>(millis()), mpuState.yaw, mpuState.yawRate, totalDistanceMeters, hypotf(mpuState.velocityX, mpuState.velocityY)};
+}
+
+// 振动频谱按传感器任务的采样时刻逐个输入样本，采样率为真实的 500 Hz，不受 loop 周期抖动影响
+static void feedSpectrum()
+{
+  MpuQueuedSample batch[16];
+  size_t count;
+  while ((count = mpuTakeSamples(batch, sizeof(batch) / sizeof(batch[0]))) > 0)
   {
-    if (motorEnabled && distanceCm > 0.0f && distanceCm < 25.0f && avoidState == AvoidState::Idle)
+    for (size_t i = 0; i < count; ++i)
     {
-      obstacleDetected = true;
-      avoidState = AvoidState::Reversing;
-      avoidStateStartMs = millis();
-      motors(0, 0);
-      Serial.println("距离过近，电机停止");
-      motors(-baseSpeed, -baseSpeed);
-      Serial.println("开始后退避障");
-    }
-    else if (distanceCm >= 25.0f && obstacleDetected && avoidState == AvoidState::Idle)
-    {
-      obstacleDetected = false;
-      Serial.println("障碍物清除");
-      if (motorEnabled)
-      {
-        applyMotorState();
-      }
+      spectrumPush(batch[i].micros, batch[i].sample.accel, batch[i].sample.gyro);
     }
   }
+}
+
+// 每算完一窗发布一次：行驶中输出车身竖直方向与偏航方向的主频，调试级别输出全部通道
+static void publishSpectrum()
+{
+  static uint32_t publishedWindows = 0;
+  const SpectrumMetrics &metrics = spectrumGetMetrics();
+  if (metrics.windows == publishedWindows)
+  {
+    return;
+  }
+  publishedWindows = metrics.windows;
 
-  switch (avoidState)
+  for (size_t i = 0; i < SPECTRUM_CHANNELS; ++i)
   {
-  case AvoidState::Idle:
+    const SpectrumChannel channel = static_cast<SpectrumChannel>(i);
+    const SpectrumResult &result = spectrumGetResult(channel);
+    LOG_DEBUG("振动 {} 主频 {}Hz 均方根 {}", spectrumChannelName(channel), result.dominantHz, result.rms);
+    LOG_DEBUG("  频带能量 {} {} {} {}", result.bandEnergy[0], result.bandEnergy[1], result.bandEnergy[2], result.bandEnergy[3]);
+  }
+  LOG_DEBUG("振动：采样 {}Hz，单窗计算 {}us，丢弃 {} 窗，样本队列丢弃 {}", metrics.sampleRateHz, metrics.windowCpuUs,
+            metrics.droppedWindows, mpuDroppedSamples());
+  if (motorEnabled)
+  {
+    const SpectrumResult &vertical = spectrumGetResult(SpectrumChannel::AccelZ);
+    const SpectrumResult &yaw = spectrumGetResult(SpectrumChannel::GyroZ);
+    LOG_INFO("振动：Az 主频 {}Hz 均方根 {}，Gz 主频 {}Hz", vertical.dominantHz, vertical.rms, yaw.dominantHz);
+  }
+}
+
+// 电量等级变化：低电量只提示，严重低电量停车（再次启动会被拒绝）
+static void handleBatteryLevel()
+{
+  const BatteryMetrics &battery = batteryGetMetrics();
+  switch (batteryLevel())
+  {
+  case BatteryLevel::Normal:
+    LOG_INFO("电池电压 {} V", battery.slowV);
     break;
-  case AvoidState::Reversing:
-    motors(-baseSpeed, -baseSpeed);
-    if (millis() - avoidStateStartMs >= REVERSE_DURATION_MS)
-    {
-      motors(0, 0);
-      avoidState = AvoidState::PauseAfterReverse;
-      avoidStateStartMs = millis();
-    }
+  case BatteryLevel::Low:
+    LOG_WARN("电池电量低：{} V（负载下最低 {} V），请尽快充电", battery.slowV, battery.minFastV);
     break;
-  case AvoidState::PauseAfterReverse:
-    if (millis() - avoidStateStartMs >= PAUSE_DURATION_MS)
-    {
-      avoidInitialYaw = mpuGetState().yaw;
-      avoidState = AvoidState::Rotating;
-    }
+  case BatteryLevel::Critical:
+    stopDriving();
+    LOG_ERROR("电池电量严重不足：{} V，已停车", battery.slowV);
     break;
-  case AvoidState::Rotating:
-    motors(baseSpeed, -baseSpeed);
-    if (fabsf(mpuGetState().yaw - avoidInitialYaw) >= TARGET_YAW_CHANGE)
+  case BatteryLevel::Absent:
+    LOG_INFO("未检测到电池，不做电压补偿");
+    break;
+  }
+}
+
+// 碰撞/堵转：传感器任务已直接刹车并锁存，这里解除锁存并进入后退避让
+static void handleCollision(CollisionKind kind)
+{
+  const CollisionMetrics &collisionMetrics = collisionGetMetrics();
+  LOG_WARN("检测到{}，已刹车（{}us，其中总线 {}us）", collisionName(kind), collisionMetrics.lastLatencyUs, collisionMetrics.lastBusUs);
+  motionCancel();
+  motorsClearEmergency();
+  if (routePlaying() || motorIdRunning())
+  {
+    // 复现中碰撞说明路线已被阻挡，停车等待人工处理；辨识中碰撞则本次测量无效
+    stopDriving();
+    return;
+  }
+  if (!motorEnabled)
+  {
+    motors(0, 0);
+    return;
+  }
+  if (behaviorRunning(avoidBehavior) && avoidReversing)
+  {
+    // 后退时撞到：后退已被取消，停在原地，脚本按正常流程暂停后转向
+    motors(0, 0);
+    return;
+  }
+  obstacleDetected = true;
+  behaviorStart(avoidBehavior, millis());
+}
+
+// 避障脚本：每次 loop 推进一次，在等待处挂起
+static bool avoidScript(Behavior &self, uint32_t nowMs)
+{
+  BEHAVIOR_BEGIN(self);
+  avoidReversing = true;
+  motionDriveFor(nowMs, -baseSpeed, REVERSE_DURATION_MS);
+  LOG_INFO("开始后退避障");
+  BEHAVIOR_UNTIL(self, !motionActive());
+  avoidReversing = false;
+  motors(0, 0);
+  BEHAVIOR_SLEEP(self, nowMs, PAUSE_DURATION_MS);
+
+  if (supervisorDegraded(Subsystem::Imu))
+  {
+    motionSpinOpenLoop(nowMs, baseSpeed, TARGET_YAW_CHANGE);
+  }
+  else
+  {
+    motionRotateBy(currentMotionInput(), baseSpeed, TARGET_YAW_CHANGE);
+  }
+  BEHAVIOR_UNTIL(self, !motionActive());
+  motors(0, 0);
+  LOG_INFO("原地转向完成，超调 {}°", motionGetMetrics().lastOvershootDeg);
+  BEHAVIOR_SLEEP(self, nowMs, PAUSE_DURATION_MS);
+
+  obstacleDetected = false;
+  LOG_INFO("尝试避障完成，继续前进");
+  if (motorEnabled)
+  {
+    applyMotorState();
+  }
+  BEHAVIOR_END(self);
+}
+
+static void avoidCancelled()
+{
+  motionCancel();
+  avoidReversing = false;
+  obstacleDetected = false;
+}
+
+static void updateObstacleAvoidance(float distanceCm, bool hasFreshSample)
+{
+  if (!motorEnabled && behaviorRunning(avoidBehavior))
+  {
+    behaviorCancel(avoidBehavior);
+    motors(0, 0);
+  }
+
+  if (hasFreshSample)
+  {
+    const float stopDistanceCm = governorGetConfig().stopDistanceCm;
+    if (motorEnabled && distanceCm > 0.0f && distanceCm < stopDistanceCm && !behaviorRunning(avoidBehavior))
     {
+      obstacleDetected = true;
       motors(0, 0);
-      avoidState = AvoidState::PauseAfterRotate;
-      avoidStateStartMs = millis();
-      Serial.println("原地转向完成");
+      LOG_INFO("距离过近，电机停止");
+      behaviorStart(avoidBehavior, millis());
     }
-    break;
-  case AvoidState::PauseAfterRotate:
-    if (millis() - avoidStateStartMs >= PAUSE_DURATION_MS)
+    else if (distanceCm >= stopDistanceCm && obstacleDetected && !behaviorRunning(avoidBehavior))
     {
-      avoidState = AvoidState::Idle;
       obstacleDetected = false;
-      Serial.println("尝试避障完成，继续前进");
+      LOG_INFO("障碍物清除");
       if (motorEnabled)
       {
         applyMotorState();
       }
     }
-    break;
   }
+
+  behaviorStep(avoidBehavior, millis());
 }
 
 void loop()
@@ -240,7 +888,33 @@ void loop()
   const unsigned long nowMicros = micros();
   deltaTime = (nowMicros - lastMicros) / 1000000.0f;
   lastMicros = nowMicros;
-  mpuUpdate(deltaTime);
+  inputLogTick(nowMicros);
+  const bool imuFresh = mpuFetch();
+  supervisorReportDuration(Subsystem::Imu, micros() - nowMicros);
+  if (imuFresh)
+  {
+    // 没有新样本时快照不变，日志中缺少 Mpu 记录即表示本次取样失败
+    inputLogMpu(mpuGetState());
+    inputLogSample(mpuGetSample());
+    supervisorReportFresh(Subsystem::Imu, millis());
+  }
+  else
+  {
+    supervisorReportFault(Subsystem::Imu, millis());
+    // 重新配置会复位传感器并阻塞约 100 ms，只在降级后低频尝试
+    if (supervisorDegraded(Subsystem::Imu) && supervisorShouldRetry(Subsystem::Imu, millis(), IMU_RETRY_INTERVAL_MS))
+    {
+      mpuRecover();
+    }
+  }
+  feedSpectrum();
+
+  const CollisionKind collision = mpuTakeCollision();
+  if (collision != CollisionKind::None)
+  {
+    inputLogCollision(static_cast<uint8_t>(collision));
+    handleCollision(collision);
+  }
 
   const MpuState &mpuState = mpuGetState();
   float planarVelocity = hypotf(mpuState.velocityX, mpuState.velocityY);
@@ -251,51 +925,300 @@ void loop()
   }
   displaySetTraveledDistance(totalDistanceMeters);
 
+  // 电池电压：先更新补偿系数，本次迭代的电机命令即按新系数输出
+  static uint32_t lastBatteryMs = 0;
+  if (millis() - lastBatteryMs >= BATTERY_INTERVAL_MS)
+  {
+    lastBatteryMs = millis();
+    float volts;
+    if (batteryAdcRead(&volts))
+    {
+      inputLogBattery(volts);
+      if (batteryUpdate(lastBatteryMs, volts))
+      {
+        handleBatteryLevel();
+      }
+    }
+  }
+
   // 按键检测与事件处理（非阻塞，模块化）
   buttonsPoll();
 
+  ConsoleCommand command;
+  if (consolePoll(&command))
+  {
+    handleConsoleCommand(command);
+  }
+  saveThermalModel(millis());
+  saveRouteWhenStopped();
+
   float distanceForAvoidance = lastDistanceCm;
   bool hasFreshDistance = false;
 
-  static uint32_t lastUpdate = 0;
-  if (displayEnabled && millis() - lastUpdate >= DISPLAY_INTERVAL_MS)
+  // 监督：测距数据陈旧时停车，恢复后按当前状态继续。
+  // 只有实际在行驶（或正等待测距恢复、避障中）时才检查测距新鲜度：电机启用但命令为 0 时测距按空闲间隔进行，
+  // 一组测量的总时长会超过新鲜度预算，若仍检查会每组都降级再恢复
+  const uint32_t nowMs = millis();
+  const bool rangingNeeded = motorEnabled && (rangingHalted || behaviorRunning(avoidBehavior) || motionActive() || getSpeedA() != 0 ||
+                                              getSpeedB() != 0);
+  supervisorSetActive(Subsystem::Ranging, rangingNeeded);
+  supervisorEvaluate(nowMs);
+  reportDeadlineMisses(nowMs);
+  const bool haltNow = motorEnabled && supervisorDegraded(Subsystem::Ranging);
+  if (haltNow && !rangingHalted)
   {
-    float cm = ultrasonicReadCm();
-    if (cm >= 0.0f)
+    rangingHalted = true;
+    motionCancel();
+    behaviorCancel(avoidBehavior);
+    motors(0, 0);
+    LOG_WARN("测距数据陈旧（{} ms），停车等待", rangingStalenessMs(nowMs));
+  }
+  else if (!haltNow && rangingHalted)
+  {
+    rangingHalted = false;
+    LOG_INFO("测距恢复，继续行驶");
+    applyMotorState();
+  }
+
+  // 测距独立调度：间隔随电机命令与上次距离自适应，不再依赖显示开关；
+  // 停车等待与避障暂停期间按行驶频率测距，以便尽快恢复，也不会因停车期间测距放缓被监督判为陈旧
+  const int commandedSpeed = (rangingHalted || behaviorRunning(avoidBehavior)) ? baseSpeed : max(abs(getSpeedA()), abs(getSpeedB()));
+  // 每次测距为一组间隔 SONAR_PING_GAP_MS 的连续测量，组内每次 loop 最多测一次，整组结束后才使用结果
+  const bool startBurst = !sonarBurstActive() && rangingDue(nowMs, commandedSpeed, lastDistanceCm);
+  if (startBurst)
+  {
+    sonarBurstBegin(nowMs);
+    ultrasonicSetTemperature(airTemperatureC());
+  }
+  SonarResult sonar;
+  bool sonarDone = false;
+  if (startBurst || sonarPingDue(nowMs))
+  {
+    const unsigned long rangeStartMicros = micros();
+    const float cm = ultrasonicReadCm();
+    supervisorReportDuration(Subsystem::Ranging, micros() - rangeStartMicros);
+    inputLogRange(cm);
+    if (cm == ULTRASONIC_NO_RESPONSE)
+    {
+      sonarBurstAbort();
+      rangingRecord(nowMs, false);
+      supervisorReportFault(Subsystem::Ranging, nowMs);
+    }
+    else
+    {
+      supervisorReportFresh(Subsystem::Ranging, nowMs);
+      sonarDone = sonarBurstAdd(nowMs, cm, &sonar);
+    }
+  }
+  if (sonarDone)
+  {
+    const float cm = sonar.distanceCm;
+    const bool trusted = sonar.confidence >= SONAR_MIN_CONFIDENCE;
+    rangingRecord(nowMs, trusted && cm >= 0.0f);
+    if (!trusted)
+    {
+      // 读数互不一致：本组不用于避障与调速，调速器保持上次距离
+      LOG_DEBUG("测距读数不一致（{} 次，置信度 {}），本组忽略", sonar.pings, sonar.confidence);
+    }
+    else if (cm >= 0.0f)
     {
       lastDistanceCm = cm;
       distanceForAvoidance = cm;
       hasFreshDistance = true;
+      governorObserve(nowMs, cm);
+      const float stopDistanceCm = governorGetConfig().stopDistanceCm;
+      if (cm < stopDistanceCm)
+      {
+        playbackBlocked = true;
+      }
+      else if (cm >= stopDistanceCm + PLAYBACK_CLEAR_MARGIN_CM)
+      {
+        playbackBlocked = false;
+      }
     }
     else
     {
-      cm = lastDistanceCm;
+      // 无回波视为前方空旷
+      governorObserve(nowMs, -1.0f);
+      playbackBlocked = false;
+    }
+  }
+
+  // 速度调节：以档位为上限，按距离与接近速度连续减速，靠近障碍时逐渐加大差速避让
+  const bool governNow = motorEnabled && motorForward && !remoteDriving && !routePlaying() && !motorIdRunning() &&
+                         !rangingHalted && !behaviorRunning(avoidBehavior) && !motionActive();
+  if (governNow)
+  {
+    if (!governing)
+    {
+      governorReset((getSpeedA() + getSpeedB()) / 2);
+    }
+    const GovernorOutput governed = governorUpdate(nowMs, baseSpeed);
+    motorsMix(governed.throttle, governed.turn);
+    const GovernorMetrics &governorMetrics = governorGetMetrics();
+    if (governed.stop && !behaviorRunning(avoidBehavior))
+    {
+      // 调速器按计入延迟的预估距离判定，比下面按原始距离的判定早一个测距周期左右；卡住时原始距离永远到不了停车距离
+      obstacleDetected = true;
+      if (governed.stalled)
+      {
+        LOG_INFO("蠕行中没有接近障碍物（预估距离 {} cm），视为卡住，停车避障", governorMetrics.effectiveCm);
+      }
+      else
+      {
+        LOG_INFO("预估距离 {} cm（测距 {} cm，接近速度 {} cm/s），停车避障", governorMetrics.effectiveCm, lastDistanceCm,
+                 governorMetrics.closingSpeedCmS);
+      }
+      behaviorStart(avoidBehavior, millis());
     }
 
-    if (avoidState == AvoidState::Idle)
+    // 串口提示只在进入/离开避让时输出
+    static bool avoiding = false;
+    if (governed.limited != avoiding && !governed.stop)
     {
-      if (cm < 45.0f && cm >= 25.0f && motorEnabled)
+      avoiding = governed.limited;
+      if (avoiding)
       {
-        Serial.println("前方有障碍物，差速转弯通过");
-        const float TURN_RATIO = 0.7f;
-        const int turnOuter = baseSpeed;
-        const int turnInner = static_cast<int>(baseSpeed * TURN_RATIO);
-        motors(turnOuter, turnInner);
+        LOG_INFO("前方有障碍物，减速避让（预估距离 {} cm，允许速度 {}）", governorMetrics.effectiveCm, governorMetrics.allowedSpeed);
       }
-      else if (cm >= 45.0f)
+      else
       {
-        Serial.println("无障碍物，继续同速度前进");
-        applyMotorState();
+        LOG_INFO("无障碍物，恢复巡航");
       }
     }
+  }
+  governing = governNow;
 
+  // 电机辨识：IMU 降级时测量无效，直接中止
+  if (motorIdRunning())
+  {
+    if (supervisorDegraded(Subsystem::Imu))
+    {
+      cancelMotorId();
+    }
+    else
+    {
+      const MotorIdOutput id = motorIdUpdate(nowMs, mpuGetState().yawRate, mpuGetSample().accel);
+      motors(id.speedA, id.speedB);
+      if (id.failed)
+      {
+        restoreFeedForward();
+        LOG_WARN("电机辨识中止：水平加速度异常（撞击或被抬起）");
+      }
+      else if (id.done)
+      {
+        finishMotorId();
+      }
+    }
+  }
+
+  // 路线复现：受阻或测距陈旧时暂停时间轴
+  if (routePlaying())
+  {
     const MpuState &mpuState = mpuGetState();
-    float planarVelocity = hypotf(mpuState.velocityX, mpuState.velocityY);
-    updateDisplay(cm, motorEnabled, motorForward, planarVelocity, mpuState.yaw);
+    const RouteInput routeInput = {nowMs, mpuState.yaw, !supervisorDegraded(Subsystem::Imu), totalDistanceMeters,
+                                   playbackBlocked || rangingHalted};
+    const RouteOutput routeOutput = routePlaybackUpdate(routeInput);
+    motors(routeOutput.speedA, routeOutput.speedB);
+
+    static bool playbackPaused = false;
+    if (routeOutput.paused != playbackPaused)
+    {
+      playbackPaused = routeOutput.paused;
+      LOG_INFO(playbackPaused ? "前方受阻，暂停复现" : "前方清除，继续复现");
+    }
+    if (routeOutput.done)
+    {
+      motorEnabled = false;
+      const RouteMetrics &route = routeGetMetrics();
+      LOG_INFO("路线复现完成：最大航向误差 {}°，暂停 {} 次，距离误差 {} m", route.maxHeadingErrorDeg, route.pauses, route.distanceErrorM);
+    }
+  }
+
+  // 曲线历史始终记录，切换到曲线页即可看到最近约 5 s
+  static uint32_t lastStripMs = 0;
+  bool stripColumnReady = false;
+  if (millis() - lastStripMs >= STRIP_INTERVAL_MS)
+  {
+    lastStripMs = millis();
+    const int motorCommand = (getSpeedA() + getSpeedB()) / 2;
+    const float values[STRIP_TRACES] = {lastDistanceCm < 0.0f ? NAN : lastDistanceCm, mpuGetState().yawRate,
+                                        static_cast<float>(motorCommand)};
+    if (stripChartPush(values))
+    {
+      stripRedrawPending = true;
+    }
+    stripColumnReady = true;
+  }
+
+  // 状态页每 200 ms 整屏刷新；曲线页随每个新样本只写入一列
+  static uint32_t lastUpdate = 0;
+  const bool chartPage = displayPage == DisplayPage::StripChart;
+  const bool displayDue = chartPage ? stripColumnReady : millis() - lastUpdate >= DISPLAY_INTERVAL_MS;
+  if (displayPage != DisplayPage::Off && displayDue)
+  {
     lastUpdate = millis();
+    if (supervisorDegraded(Subsystem::Display))
+    {
+      // 无显示模式：不再占用 I2C 总线，只定期探测，应答后重新初始化
+      if (supervisorShouldRetry(Subsystem::Display, lastUpdate, DISPLAY_RETRY_INTERVAL_MS) && displayProbe() && initDisplay())
+      {
+        supervisorReportFresh(Subsystem::Display, lastUpdate);
+        stripRedrawPending = true;
+      }
+    }
+    else if (!displayProbe())
+    {
+      supervisorReportFault(Subsystem::Display, lastUpdate);
+    }
+    else
+    {
+      const unsigned long displayStartMicros = micros();
+      if (chartPage)
+      {
+        updateStripChart(stripRedrawPending);
+        stripRedrawPending = false;
+      }
+      else
+      {
+        const MpuState &mpuState = mpuGetState();
+        float planarVelocity = hypotf(mpuState.velocityX, mpuState.velocityY);
+        updateDisplay(lastDistanceCm, motorEnabled, motorForward, planarVelocity, mpuState.yaw);
+      }
+      supervisorReportDuration(Subsystem::Display, micros() - displayStartMicros);
+      supervisorReportFresh(Subsystem::Display, lastUpdate);
+    }
+  }
+
+  // 先推进运动原语，避障状态机在同一次迭代内即可看到原语完成
+  MotionOutput motionOutput;
+  if (motionUpdate(currentMotionInput(), &motionOutput))
+  {
+    motors(motionOutput.speedA, motionOutput.speedB);
+  }
+
+  if (!rangingHalted && !routePlaying() && !motorIdRunning())
+  {
+    updateObstacleAvoidance(distanceForAvoidance, hasFreshDistance);
+  }
+
+  // 录制本次迭代最终的电机命令与位姿
+  if (routeRecording() && !routeRecordSample(nowMs, getSpeedA(), getSpeedB(), mpuGetState().yaw, totalDistanceMeters))
+  {
+    LOG_WARN("路线缓冲已满，录制提前结束");
+    finishRecording();
+  }
+
+  // 振动频谱：每次 loop 最多计算一个通道，单窗计算量固定
+  const unsigned long spectrumStartMicros = micros();
+  if (spectrumStep())
+  {
+    spectrumReportDuration(micros() - spectrumStartMicros);
+    publishSpectrum();
   }
 
-  updateObstacleAvoidance(distanceForAvoidance, hasFreshDistance);
+  supervisorReportDuration(Subsystem::Control, micros() - nowMicros);
+  supervisorReportFresh(Subsystem::Control, millis());
 
   // 轻微让步，降低CPU占用
   delay(5);
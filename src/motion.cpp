@@ -0,0 +1,254 @@
+#include "motion.h"
+#include <math.h>
+
+enum class MotionKind : uint8_t
+{
+    None,
+    DriveTime,
+    DriveDistance,
+    Rotate
+};
+
+struct MotionTask
+{
+    MotionKind kind;
+    MotionProfile profile;
+    int speed;
+    uint32_t startMs;
+    uint32_t durationMs;
+    float target;        // 目标距离（m）或角度幅值（°）
+    float startPosition; // 起点里程或偏航角
+    int8_t direction;    // 转向方向 ±1；定时行驶时为 B 路相对 A 路的符号
+    bool settling;       // 已切断输出，等待车身静止
+    uint32_t cutoffMs;
+    float cutoffRate;     // 切断时的角速度（°/s）
+    float cutoffProgress; // 切断时已完成的角度
+};
+
+static MotionTask task = {};
+static MotionMetrics metrics = {0.0f, 0.0f, 0, MOTION_ROTATE_DECEL_DPS2, 5.0f, 0};
+static uint32_t lastUpdateMs = 0;
+static bool hasLastUpdate = false;
+
+static float clampf(float value, float low, float high)
+{
+    return value < low ? low : (value > high ? high : value);
+}
+
+// 切断时刻落在两次控制更新之间，平均输出延迟取半个控制周期
+static float latencySeconds()
+{
+    return metrics.controlPeriodMs * 0.5f / 1000.0f;
+}
+
+// 加减速曲线：x ∈ [0,1] 映射到速度比例
+static float shape(MotionProfile profile, float x)
+{
+    x = clampf(x, 0.0f, 1.0f);
+    if (profile == MotionProfile::SCurve)
+    {
+        return x * x * (3.0f - 2.0f * x);
+    }
+    return x;
+}
+
+static void start(MotionKind kind, uint32_t nowMs, int speed, MotionProfile profile)
+{
+    task = {};
+    task.kind = kind;
+    task.profile = profile;
+    task.speed = speed;
+    task.startMs = nowMs;
+}
+
+void motionDriveFor(uint32_t nowMs, int speed, uint32_t durationMs, MotionProfile profile)
+{
+    start(MotionKind::DriveTime, nowMs, speed, profile);
+    task.durationMs = durationMs;
+    task.direction = 1;
+}
+
+void motionSpinOpenLoop(uint32_t nowMs, int speed, float degrees, MotionProfile profile)
+{
+    const int magnitude = speed < 0 ? -speed : speed;
+    const float rateDps = MOTION_OPEN_LOOP_DPS_AT_FULL * magnitude / 255.0f;
+    start(MotionKind::DriveTime, nowMs, degrees >= 0.0f ? magnitude : -magnitude, profile);
+    // 加减速各损失约半个斜坡时间的角度，补回
+    task.durationMs = rateDps > 0.0f ? static_cast<uint32_t>(fabsf(degrees) / rateDps * 1000.0f) + MOTION_RAMP_MS : 0;
+    task.direction = -1;
+}
+
+void motionDriveDistance(const MotionInput &in, int speed, float distanceM, MotionProfile profile)
+{
+    start(MotionKind::DriveDistance, in.nowMs, speed, profile);
+    task.target = fabsf(distanceM);
+    task.startPosition = in.odometerM;
+}
+
+void motionRotateBy(const MotionInput &in, int speed, float degrees, MotionProfile profile)
+{
+    start(MotionKind::Rotate, in.nowMs, speed < 0 ? -speed : speed, profile);
+    task.target = fabsf(degrees);
+    task.startPosition = in.yaw;
+    task.direction = degrees >= 0.0f ? 1 : -1;
+}
+
+void motionCancel()
+{
+    task.kind = MotionKind::None;
+}
+
+bool motionActive()
+{
+    return task.kind != MotionKind::None;
+}
+
+const MotionMetrics &motionGetMetrics()
+{
+    return metrics;
+}
+
+static void finish(uint32_t nowMs)
+{
+    metrics.lastDurationMs = nowMs - task.startMs;
+    task.kind = MotionKind::None;
+}
+
+// 切断输出后等待静止（转向看角速度，定距行驶看车速），再统计超调并修正刹车减速度估计。
+// 静止后本次仍返回 true，让调用方把最后的零输出交给电机
+static bool settle(const MotionInput &in, float progress, MotionOutput *out)
+{
+    out->speedA = 0;
+    out->speedB = 0;
+    const bool moving = task.kind == MotionKind::Rotate ? fabsf(in.yawRate) > MOTION_SETTLE_RATE_DPS
+                                                        : fabsf(in.speedMps) > MOTION_SETTLE_SPEED_MPS;
+    if (moving && in.nowMs - task.cutoffMs < MOTION_SETTLE_TIMEOUT_MS)
+    {
+        return true;
+    }
+
+    if (task.kind == MotionKind::Rotate)
+    {
+        metrics.lastOvershootDeg = progress - task.target;
+        // 实际滑行角 = 切断后转过的角度，扣除延迟部分后反推减速度
+        const float latencyDeg = task.cutoffRate * latencySeconds();
+        const float brakingDeg = progress - task.cutoffProgress - latencyDeg;
+        if (task.cutoffRate > MOTION_SETTLE_RATE_DPS && brakingDeg > 0.5f)
+        {
+            const float observed = task.cutoffRate * task.cutoffRate / (2.0f * brakingDeg);
+            metrics.rotateDecelDps2 += (clampf(observed, 100.0f, 5000.0f) - metrics.rotateDecelDps2) * 0.3f;
+        }
+    }
+    else
+    {
+        metrics.lastOvershootM = progress - task.target;
+    }
+    finish(in.nowMs);
+    return true;
+}
+
+static bool updateDriveTime(const MotionInput &in, MotionOutput *out)
+{
+    const uint32_t elapsed = in.nowMs - task.startMs;
+    if (elapsed >= task.durationMs)
+    {
+        out->speedA = 0;
+        out->speedB = 0;
+        finish(in.nowMs);
+        return true;
+    }
+    const uint32_t remaining = task.durationMs - elapsed;
+    const float rampUp = shape(task.profile, static_cast<float>(elapsed) / MOTION_RAMP_MS);
+    const float rampDown = shape(task.profile, static_cast<float>(remaining) / MOTION_RAMP_MS);
+    const int speed = static_cast<int>(task.speed * fminf(rampUp, rampDown));
+    out->speedA = speed;
+    out->speedB = task.direction * speed;
+    return true;
+}
+
+static bool updateDriveDistance(const MotionInput &in, MotionOutput *out)
+{
+    const float progress = fabsf(in.odometerM - task.startPosition);
+    if (task.settling)
+    {
+        return settle(in, progress, out);
+    }
+
+    const float speed = fabsf(in.speedMps);
+    const float coast = speed * latencySeconds() + speed * speed / (2.0f * MOTION_DRIVE_DECEL_MPS2);
+    const float remaining = task.target - progress;
+    if (remaining <= coast)
+    {
+        task.settling = true;
+        task.cutoffMs = in.nowMs;
+        return settle(in, progress, out);
+    }
+
+    const float rampUp = shape(task.profile, static_cast<float>(in.nowMs - task.startMs) / MOTION_RAMP_MS);
+    const float rampDown = fmaxf(shape(task.profile, remaining / MOTION_RAMP_DISTANCE_M), MOTION_MIN_SPEED_RATIO);
+    const int command = static_cast<int>(task.speed * fminf(rampUp, rampDown));
+    out->speedA = command;
+    out->speedB = command;
+    return true;
+}
+
+static bool updateRotate(const MotionInput &in, MotionOutput *out)
+{
+    const float progress = fabsf(in.yaw - task.startPosition);
+    if (task.settling)
+    {
+        return settle(in, progress, out);
+    }
+
+    // 预测滑行角：输出延迟 + 以估计减速度刹停
+    const float rate = fabsf(in.yawRate);
+    const float coast = rate * latencySeconds() + rate * rate / (2.0f * metrics.rotateDecelDps2);
+    const float remaining = task.target - progress;
+    const bool timedOut = in.nowMs - task.startMs >= MOTION_ROTATE_TIMEOUT_MS;
+    if (timedOut)
+    {
+        ++metrics.rotateTimeouts;
+    }
+    if (remaining <= coast || timedOut)
+    {
+        task.settling = true;
+        task.cutoffMs = in.nowMs;
+        task.cutoffRate = rate;
+        task.cutoffProgress = progress;
+        return settle(in, progress, out);
+    }
+
+    const float rampUp = shape(task.profile, static_cast<float>(in.nowMs - task.startMs) / MOTION_RAMP_MS);
+    const float slowDown = fmaxf(shape(task.profile, remaining / MOTION_ROTATE_SLOWDOWN_DEG), MOTION_MIN_SPEED_RATIO);
+    const int command = static_cast<int>(task.speed * fmaxf(fminf(rampUp, slowDown), 0.0f));
+    out->speedA = task.direction * command;
+    out->speedB = -task.direction * command;
+    return true;
+}
+
+bool motionUpdate(const MotionInput &in, MotionOutput *out)
+{
+    if (hasLastUpdate)
+    {
+        const uint32_t period = in.nowMs - lastUpdateMs;
+        if (period > 0 && period < 200)
+        {
+            metrics.controlPeriodMs += (period - metrics.controlPeriodMs) * 0.05f;
+        }
+    }
+    hasLastUpdate = true;
+    lastUpdateMs = in.nowMs;
+
+    switch (task.kind)
+    {
+    case MotionKind::DriveTime:
+        return updateDriveTime(in, out);
+    case MotionKind::DriveDistance:
+        return updateDriveDistance(in, out);
+    case MotionKind::Rotate:
+        return updateRotate(in, out);
+    case MotionKind::None:
+    default:
+        return false;
+    }
+}
@@ -0,0 +1,76 @@
+#pragma once
+#include <stdint.h>
+
+// 运动原语：按梯形或 S 曲线生成 PWM 命令，非阻塞、可随时取消。
+// 纯逻辑模块（不依赖 Arduino），由主循环每次调用 motionUpdate() 推进并把输出交给 motors()。
+
+enum class MotionProfile : uint8_t
+{
+    Trapezoid, // 线性加减速
+    SCurve     // smoothstep 加减速，冲击更小
+};
+
+// 加减速时间与距离
+static constexpr uint32_t MOTION_RAMP_MS = 300;
+static constexpr float MOTION_RAMP_DISTANCE_M = 0.10f;
+// 原地转向接近目标时开始降速的角度，以及降速后的最低比例（避免进入电机死区）
+static constexpr float MOTION_ROTATE_SLOWDOWN_DEG = 20.0f;
+static constexpr float MOTION_MIN_SPEED_RATIO = 0.5f;
+// 停止后判定为静止的角速度（转向）/ 车速（定距行驶）阈值与最长等待时间
+static constexpr float MOTION_SETTLE_RATE_DPS = 3.0f;
+static constexpr float MOTION_SETTLE_SPEED_MPS = 0.02f;
+static constexpr uint32_t MOTION_SETTLE_TIMEOUT_MS = 1000; // 满速 1 m/s 按 1.5 m/s² 滑行约需 0.7 s
+// 转向超时（偏航角不再变化时，例如 IMU 故障），超时后停车并计数
+static constexpr uint32_t MOTION_ROTATE_TIMEOUT_MS = 4000;
+// IMU 不可用时的开环转向：满占空比下的估计角速度
+static constexpr float MOTION_OPEN_LOOP_DPS_AT_FULL = 180.0f;
+// 刹车减速度初值，运行中根据实际滑行量在线修正
+static constexpr float MOTION_ROTATE_DECEL_DPS2 = 600.0f;
+static constexpr float MOTION_DRIVE_DECEL_MPS2 = 1.5f;
+
+struct MotionInput
+{
+    uint32_t nowMs;
+    float yaw;        // °
+    float yawRate;    // °/s
+    float odometerM;  // 累计行驶距离（m，单调递增）
+    float speedMps;   // 当前平面速度（m/s）
+};
+
+struct MotionOutput
+{
+    int speedA;
+    int speedB;
+};
+
+struct MotionMetrics
+{
+    float lastOvershootDeg;     // 最近一次转向的超调（正=转过头，负=未到位）
+    float lastOvershootM;       // 最近一次定距行驶的超调
+    uint32_t lastDurationMs;    // 最近一次原语从开始到静止的耗时
+    float rotateDecelDps2;      // 当前使用的转向刹车减速度估计
+    float controlPeriodMs;      // 实测控制周期（预测滑行量用）
+    uint32_t rotateTimeouts;    // 转向超时次数
+};
+
+// 定时行驶：speed 为带符号 PWM，两路相同
+void motionDriveFor(uint32_t nowMs, int speed, uint32_t durationMs, MotionProfile profile = MotionProfile::Trapezoid);
+
+// 定距行驶：按 odometerM 计量，接近终点时预测滑行量提前停车
+void motionDriveDistance(const MotionInput &in, int speed, float distanceM, MotionProfile profile = MotionProfile::Trapezoid);
+
+// 原地转向：degrees > 0 时 A 路正转、B 路反转，speed 为 PWM 幅值；按实测角速度预测滑行量提前刹车
+void motionRotateBy(const MotionInput &in, int speed, float degrees, MotionProfile profile = MotionProfile::Trapezoid);
+
+// 开环原地转向：按估计角速度换算为定时转向，供 IMU 降级时使用
+void motionSpinOpenLoop(uint32_t nowMs, int speed, float degrees, MotionProfile profile = MotionProfile::Trapezoid);
+
+// 推进当前原语，返回 true 表示应把 out 交给电机：原语执行中（含刹车静止阶段），以及结束时的一次零输出
+bool motionUpdate(const MotionInput &in, MotionOutput *out);
+
+// 立即取消，下次 motionUpdate() 返回 false
+void motionCancel();
+
+bool motionActive();
+
+const MotionMetrics &motionGetMetrics();
@@ -0,0 +1,238 @@
+#pragma once
+#include <stddef.h>
+#include <stdint.h>
+
+// 编译期电机驱动层：驱动芯片、引脚与 LEDC 通道均为模板参数，热路径上没有虚函数调用。
+// 不依赖 Arduino，引脚操作通过 Backend 完成，Backend 需提供以下静态函数：
+//   pinOutput(pin)                    配置为输出
+//   write(pin, high)                  数字输出
+//   pwmSetup(channel, freq, bits)     配置 PWM 通道
+//   pwmAttach(pin, channel)           绑定引脚与通道
+//   pwmWrite(channel, duty)           设置占空比
+
+static constexpr int MOTOR_PWM_FREQ = 1000; // PWM频率1kHz
+static constexpr int MOTOR_PWM_BITS = 8;    // 8位分辨率(0-255)
+static constexpr int MOTOR_MAX_DUTY = 255;
+
+inline int motorClampSpeed(int speed)
+{
+    return speed > MOTOR_MAX_DUTY ? MOTOR_MAX_DUTY : (speed < -MOTOR_MAX_DUTY ? -MOTOR_MAX_DUTY : speed);
+}
+
+// TB6612FNG 单路：IN1/IN2 决定方向，PWM 引脚决定速度
+//   正转 IN1=H IN2=L；反转 IN1=L IN2=H；停止 IN1=H IN2=H（短路刹车）
+template <typename Backend, int IN1, int IN2, int PWM, int CHANNEL>
+struct Tb6612Motor
+{
+    static void init()
+    {
+        Backend::pinOutput(IN1);
+        Backend::pinOutput(IN2);
+        Backend::pwmSetup(CHANNEL, MOTOR_PWM_FREQ, MOTOR_PWM_BITS);
+        Backend::pwmAttach(PWM, CHANNEL);
+    }
+
+    static void drive(int speed)
+    {
+        if (speed > 0)
+        {
+            Backend::write(IN1, true);
+            Backend::write(IN2, false);
+            Backend::pwmWrite(CHANNEL, speed);
+        }
+        else if (speed < 0)
+        {
+            Backend::write(IN1, false);
+            Backend::write(IN2, true);
+            Backend::pwmWrite(CHANNEL, -speed);
+        }
+        else
+        {
+            brake();
+        }
+    }
+
+    static void brake()
+    {
+        Backend::write(IN1, true);
+        Backend::write(IN2, true);
+        Backend::pwmWrite(CHANNEL, 0);
+    }
+};
+
+// DRV8833 单路：两个输入都接 PWM（快衰减模式）
+//   正转 IN1=PWM IN2=0；反转 IN1=0 IN2=PWM；停止 IN1=1 IN2=1（刹车）
+template <typename Backend, int IN1, int IN2, int CHANNEL1, int CHANNEL2>
+struct Drv8833Motor
+{
+    static void init()
+    {
+        Backend::pwmSetup(CHANNEL1, MOTOR_PWM_FREQ, MOTOR_PWM_BITS);
+        Backend::pwmSetup(CHANNEL2, MOTOR_PWM_FREQ, MOTOR_PWM_BITS);
+        Backend::pwmAttach(IN1, CHANNEL1);
+        Backend::pwmAttach(IN2, CHANNEL2);
+    }
+
+    static void drive(int speed)
+    {
+        if (speed > 0)
+        {
+            Backend::pwmWrite(CHANNEL1, speed);
+            Backend::pwmWrite(CHANNEL2, 0);
+        }
+        else if (speed < 0)
+        {
+            Backend::pwmWrite(CHANNEL1, 0);
+            Backend::pwmWrite(CHANNEL2, -speed);
+        }
+        else
+        {
+            brake();
+        }
+    }
+
+    static void brake()
+    {
+        Backend::pwmWrite(CHANNEL1, MOTOR_MAX_DUTY);
+        Backend::pwmWrite(CHANNEL2, MOTOR_MAX_DUTY);
+    }
+};
+
+// 驱动使能引脚（TB6612 的 STBY、DRV8833 的 nSLEEP），高电平工作；可列出多块驱动板的引脚
+template <typename Backend, int... PINS>
+struct MotorEnablePins
+{
+    static void init()
+    {
+        const int pins[] = {PINS..., -1};
+        for (size_t i = 0; i + 1 < sizeof(pins) / sizeof(pins[0]); ++i)
+        {
+            Backend::pinOutput(pins[i]);
+        }
+        set(true);
+    }
+
+    static void set(bool enabled)
+    {
+        const int pins[] = {PINS..., -1};
+        for (size_t i = 0; i + 1 < sizeof(pins) / sizeof(pins[0]); ++i)
+        {
+            Backend::write(pins[i], enabled);
+        }
+    }
+};
+
+// 按编号分发到各路电机（编译期展开，无虚函数）
+template <typename... MOTORS>
+struct MotorList;
+
+template <>
+struct MotorList<>
+{
+    static void init() {}
+    static void drive(size_t, int) {}
+    static void brake() {}
+};
+
+template <typename M, typename... REST>
+struct MotorList<M, REST...>
+{
+    static void init()
+    {
+        M::init();
+        MotorList<REST...>::init();
+    }
+
+    static void drive(size_t index, int speed)
+    {
+        if (index == 0)
+        {
+            M::drive(speed);
+        }
+        else
+        {
+            MotorList<REST...>::drive(index - 1, speed);
+        }
+    }
+
+    static void brake()
+    {
+        M::brake();
+        MotorList<REST...>::brake();
+    }
+};
+
+// 一组电机：使能引脚 + N 路电机，按编号分发带符号的占空比（正=正转，负=反转）。
+// 不保存命令：各路最近一次命令（补偿前）只由 motors.cpp 的 commands[] 记录
+template <typename ENABLE, typename... MOTORS>
+struct MotorBank
+{
+    static constexpr size_t COUNT = sizeof...(MOTORS);
+
+    static void init()
+    {
+        MotorList<MOTORS...>::init();
+        ENABLE::init(); // 启动驱动芯片（取消待机）
+    }
+
+    static void drive(size_t index, int speed)
+    {
+        if (index >= COUNT)
+        {
+            return;
+        }
+        speed = motorClampSpeed(speed);
+        MotorList<MOTORS...>::drive(index, speed);
+    }
+
+    static void brakeAll()
+    {
+        MotorList<MOTORS...>::brake();
+    }
+
+    static void standby() { ENABLE::set(false); }
+    static void wakeup() { ENABLE::set(true); }
+};
+
+// 车轮所在侧：左侧与右侧
+enum WheelSide : int8_t
+{
+    WHEEL_LEFT = -1,
+    WHEEL_RIGHT = 1
+};
+
+// 差速混控：(throttle, turn) -> N 路车轮命令，turn > 0 向右转（左侧加速、右侧减速）。
+// 任一车轮超出 ±255 时按比例整体缩放，保持转弯曲率不变。
+template <int8_t... SIDES>
+struct DiffMixer
+{
+    static constexpr size_t COUNT = sizeof...(SIDES);
+
+    static int8_t side(size_t index)
+    {
+        const int8_t sides[] = {SIDES...};
+        return index < COUNT ? sides[index] : 0;
+    }
+
+    static void mix(int throttle, int turn, int (&out)[COUNT])
+    {
+        const int8_t sides[] = {SIDES...};
+        int peak = 0;
+        for (size_t i = 0; i < COUNT; ++i)
+        {
+            out[i] = throttle - sides[i] * turn;
+            const int magnitude = out[i] < 0 ? -out[i] : out[i];
+            if (magnitude > peak)
+            {
+                peak = magnitude;
+            }
+        }
+        if (peak > MOTOR_MAX_DUTY)
+        {
+            for (size_t i = 0; i < COUNT; ++i)
+            {
+                out[i] = out[i] * MOTOR_MAX_DUTY / peak;
+            }
+        }
+    }
+};
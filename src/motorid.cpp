@@ -0,0 +1,248 @@
+#include "motorid.h"
+#include <math.h>
+
+enum class Phase : uint8_t
+{
+    Rest,
+    Settle,
+    Measure
+};
+
+static MotorIdSweep sweeps[MOTORID_SIDES][MOTORID_DIRECTIONS] = {};
+static bool running = false;
+static size_t sweepIndex = 0; // 顺序：左前、右前、左后、右后
+static size_t level = 0;
+static Phase phase = Phase::Rest;
+static uint32_t phaseStartMs = 0;
+static float rateSum = 0.0f;
+static uint32_t rateCount = 0;
+
+int motorIdLevelDuty(size_t index)
+{
+    const int duty = static_cast<int>(index + 1) * MOTORID_LEVEL_STEP;
+    return duty > 255 ? 255 : duty;
+}
+
+void motorIdBegin(uint32_t nowMs)
+{
+    running = true;
+    sweepIndex = 0;
+    level = 0;
+    phase = Phase::Rest;
+    phaseStartMs = nowMs;
+}
+
+void motorIdAbort()
+{
+    running = false;
+}
+
+bool motorIdRunning()
+{
+    return running;
+}
+
+const MotorIdSweep &motorIdGetSweep(size_t side, size_t direction)
+{
+    return sweeps[side][direction];
+}
+
+MotorIdOutput motorIdUpdate(uint32_t nowMs, float yawRateDps, const float accel[3])
+{
+    MotorIdOutput out = {0, 0, false, false};
+    if (!running)
+    {
+        out.done = true;
+        return out;
+    }
+    if (hypotf(accel[0], accel[1]) > MOTORID_ABORT_ACCEL)
+    {
+        running = false;
+        out.failed = true;
+        return out;
+    }
+
+    const size_t side = sweepIndex % MOTORID_SIDES;
+    const size_t direction = sweepIndex / MOTORID_SIDES;
+    const uint32_t elapsed = nowMs - phaseStartMs;
+    switch (phase)
+    {
+    case Phase::Rest:
+        if (elapsed >= MOTORID_REST_MS)
+        {
+            phase = Phase::Settle;
+            phaseStartMs = nowMs;
+        }
+        return out;
+    case Phase::Settle:
+        if (elapsed >= MOTORID_SETTLE_MS)
+        {
+            phase = Phase::Measure;
+            phaseStartMs = nowMs;
+            rateSum = 0.0f;
+            rateCount = 0;
+        }
+        break;
+    case Phase::Measure:
+        rateSum += fabsf(yawRateDps);
+        ++rateCount;
+        if (elapsed >= MOTORID_MEASURE_MS)
+        {
+            sweeps[side][direction].rateDps[level] = rateSum / rateCount;
+            phaseStartMs = nowMs;
+            if (++level < MOTORID_LEVELS)
+            {
+                phase = Phase::Settle;
+            }
+            else
+            {
+                // 一次阶梯结束，停车后换下一侧/方向
+                level = 0;
+                phase = Phase::Rest;
+                if (++sweepIndex == MOTORID_SIDES * MOTORID_DIRECTIONS)
+                {
+                    running = false;
+                    out.done = true;
+                }
+                return out;
+            }
+        }
+        break;
+    }
+
+    // 另一侧输出 0（刹车），车身绕该侧原地转动
+    const int duty = (direction == 0 ? 1 : -1) * motorIdLevelDuty(level);
+    if (side == 0)
+    {
+        out.speedA = duty;
+    }
+    else
+    {
+        out.speedB = duty;
+    }
+    return out;
+}
+
+// 单次阶梯：响应取单调包络后求死区；失败返回 false
+static bool fitDeadband(const float rates[MOTORID_LEVELS], float *deadband)
+{
+    float previous = 0.0f;
+    for (size_t k = 0; k < MOTORID_LEVELS; ++k)
+    {
+        if (rates[k] >= MOTORID_MOVING_DPS)
+        {
+            const float lowDuty = k == 0 ? 0.0f : static_cast<float>(motorIdLevelDuty(k - 1));
+            const float highDuty = static_cast<float>(motorIdLevelDuty(k));
+            const float t = (MOTORID_MOVING_DPS - previous) / (rates[k] - previous);
+            *deadband = lowDuty + (highDuty - lowDuty) * t;
+            return true;
+        }
+        previous = fmaxf(previous, rates[k]);
+    }
+    return false;
+}
+
+// 在 (死区, 阈值) 与各级测量点构成的单调曲线上反查达到 target 所需的占空比
+static float invert(const float rates[MOTORID_LEVELS], float deadband, float target)
+{
+    float lowDuty = deadband;
+    float lowRate = MOTORID_MOVING_DPS;
+    if (target <= lowRate)
+    {
+        return deadband;
+    }
+    float envelope = lowRate;
+    for (size_t k = 0; k < MOTORID_LEVELS; ++k)
+    {
+        const float duty = static_cast<float>(motorIdLevelDuty(k));
+        if (duty <= deadband)
+        {
+            continue;
+        }
+        envelope = fmaxf(envelope, rates[k]);
+        if (envelope >= target)
+        {
+            const float span = envelope - lowRate;
+            return span > 0.0f ? lowDuty + (duty - lowDuty) * (target - lowRate) / span : duty;
+        }
+        lowDuty = duty;
+        lowRate = envelope;
+    }
+    return 255.0f;
+}
+
+bool motorIdFit(const MotorIdSweep input[MOTORID_SIDES][MOTORID_DIRECTIONS], MotorIdTable *out)
+{
+    float deadbands[MOTORID_SIDES][MOTORID_DIRECTIONS];
+    float maxRate = -1.0f;
+    for (size_t side = 0; side < MOTORID_SIDES; ++side)
+    {
+        for (size_t direction = 0; direction < MOTORID_DIRECTIONS; ++direction)
+        {
+            const float *rates = input[side][direction].rateDps;
+            if (!fitDeadband(rates, &deadbands[side][direction]))
+            {
+                return false;
+            }
+            float top = 0.0f;
+            for (size_t k = 0; k < MOTORID_LEVELS; ++k)
+            {
+                top = fmaxf(top, rates[k]);
+            }
+            // 命令 255 取四次阶梯中最慢的最高速度，保证两侧、两个方向都能达到
+            maxRate = maxRate < 0.0f ? top : fminf(maxRate, top);
+        }
+    }
+
+    out->version = MOTORID_TABLE_VERSION;
+    out->maxRateDps = maxRate;
+    for (size_t side = 0; side < MOTORID_SIDES; ++side)
+    {
+        for (size_t direction = 0; direction < MOTORID_DIRECTIONS; ++direction)
+        {
+            const float *rates = input[side][direction].rateDps;
+            const float deadband = deadbands[side][direction];
+            out->deadband[side][direction] = static_cast<uint8_t>(lroundf(deadband));
+            uint8_t previous = 0;
+            for (size_t i = 0; i < MOTORID_LUT_POINTS; ++i)
+            {
+                const float target = maxRate * i / (MOTORID_LUT_POINTS - 1);
+                long duty = lroundf(invert(rates, deadband, target));
+                duty = duty < previous ? previous : (duty > 255 ? 255 : duty);
+                out->duty[side][direction][i] = static_cast<uint8_t>(duty);
+                previous = static_cast<uint8_t>(duty);
+            }
+        }
+    }
+    return true;
+}
+
+bool motorIdFitLast(MotorIdTable *out)
+{
+    return motorIdFit(sweeps, out);
+}
+
+bool motorIdTableValid(const MotorIdTable &table)
+{
+    return table.version == MOTORID_TABLE_VERSION && table.maxRateDps > 0.0f;
+}
+
+int motorIdApply(const MotorIdTable &table, size_t side, int command)
+{
+    if (command == 0 || side >= MOTORID_SIDES)
+    {
+        return command;
+    }
+    const int magnitude = command > 0 ? (command > 255 ? 255 : command) : (command < -255 ? 255 : -command);
+    const uint8_t *lut = table.duty[side][command > 0 ? 0 : 1];
+    // 命令在相邻两个表点之间线性插值（整数运算）
+    const int scaled = magnitude * static_cast<int>(MOTORID_LUT_POINTS - 1);
+    const int index = scaled / 255;
+    const int remainder = scaled % 255;
+    int duty = lut[index];
+    if (remainder != 0)
+    {
+        duty += (lut[index + 1] - lut[index]) * remainder / 255;
+    }
+    return command > 0 ? duty : -duty;
+}
@@ -0,0 +1,62 @@
+#pragma once
+#include <stddef.h>
+#include <stdint.h>
+
+// 电机辨识与前馈补偿：逐侧、逐方向按阶梯占空比单侧驱动（另一侧刹住，车身绕其原地转动），
+// 以 IMU 偏航角速度度量该侧车轮速度，拟合每侧的死区与“命令 -> 占空比”查找表。
+// 补偿后两侧在相同命令下速度一致，且速度与命令近似成正比（命令 255 对应两侧都能达到的最高速度）。
+// 四驱布局下同侧的两个电机无法用 IMU 区分，按侧辨识与补偿。
+// 纯逻辑模块（不依赖 Arduino），时间与传感器值由调用方传入，便于主机端用仿真电机模型测试。
+
+static constexpr size_t MOTORID_SIDES = 2;      // 左、右
+static constexpr size_t MOTORID_DIRECTIONS = 2; // 前进、后退
+static constexpr size_t MOTORID_LEVELS = 17;    // 占空比阶梯 15、30 … 255
+static constexpr int MOTORID_LEVEL_STEP = 15;
+static constexpr uint32_t MOTORID_SETTLE_MS = 250;  // 每级先等待响应稳定
+static constexpr uint32_t MOTORID_MEASURE_MS = 250; // 再取平均
+static constexpr uint32_t MOTORID_REST_MS = 500;    // 两次阶梯之间停车
+static constexpr float MOTORID_MOVING_DPS = 3.0f;   // 判定已转动的偏航角速度
+static constexpr float MOTORID_ABORT_ACCEL = 12.0f; // 水平加速度超过此值（撞击、抬起）时中止（m/s²）
+static constexpr size_t MOTORID_LUT_POINTS = 9;     // 命令 0、32 … 255 处的占空比
+static constexpr uint8_t MOTORID_TABLE_VERSION = 1;
+
+struct MotorIdTable
+{
+    uint8_t version;
+    uint8_t deadband[MOTORID_SIDES][MOTORID_DIRECTIONS];                 // 开始转动的占空比
+    uint8_t duty[MOTORID_SIDES][MOTORID_DIRECTIONS][MOTORID_LUT_POINTS]; // 首点即死区
+    float maxRateDps; // 命令 255 对应的单侧驱动偏航角速度
+};
+
+// 一次阶梯的测量结果：各级占空比下的平均偏航角速度幅值
+struct MotorIdSweep
+{
+    float rateDps[MOTORID_LEVELS];
+};
+
+struct MotorIdOutput
+{
+    int speedA; // 原始占空比，调用方需关闭前馈后直接输出
+    int speedB;
+    bool done;
+    bool failed; // 中止（加速度异常）
+};
+
+int motorIdLevelDuty(size_t level);
+
+// ---- 阶梯测量 ----
+void motorIdBegin(uint32_t nowMs);
+// yawRateDps 为偏航角速度，accel 为扣除静态零偏的加速度（m/s²）
+MotorIdOutput motorIdUpdate(uint32_t nowMs, float yawRateDps, const float accel[3]);
+void motorIdAbort();
+bool motorIdRunning();
+const MotorIdSweep &motorIdGetSweep(size_t side, size_t direction);
+
+// ---- 拟合与补偿 ----
+// 由四次阶梯拟合查找表；某一侧在最大占空比下仍不转动时返回 false
+bool motorIdFit(const MotorIdSweep sweeps[MOTORID_SIDES][MOTORID_DIRECTIONS], MotorIdTable *out);
+// 测量完成后用本次结果拟合
+bool motorIdFitLast(MotorIdTable *out);
+bool motorIdTableValid(const MotorIdTable &table);
+// 命令（-255~255）-> 带符号占空比；side 0 为左侧
+int motorIdApply(const MotorIdTable &table, size_t side, int command);
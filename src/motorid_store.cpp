@@ -0,0 +1,36 @@
+#include <Arduino.h>
+#include <Preferences.h>
+#include "motorid_store.h"
+
+static const char *const NAMESPACE = "motorid";
+static const char *const KEY = "table";
+
+bool motorIdStoreSave(const MotorIdTable &table)
+{
+    Preferences prefs;
+    if (!prefs.begin(NAMESPACE, false))
+    {
+        return false;
+    }
+    const bool ok = prefs.putBytes(KEY, &table, sizeof(table)) == sizeof(table);
+    prefs.end();
+    return ok;
+}
+
+bool motorIdStoreLoad(MotorIdTable *table)
+{
+    Preferences prefs;
+    if (!prefs.begin(NAMESPACE, true))
+    {
+        return false;
+    }
+    MotorIdTable stored;
+    const size_t size = prefs.getBytes(KEY, &stored, sizeof(stored));
+    prefs.end();
+    if (size != sizeof(stored) || !motorIdTableValid(stored))
+    {
+        return false;
+    }
+    *table = stored;
+    return true;
+}
@@ -0,0 +1,7 @@
+#pragma once
+#include "motorid.h"
+
+// 电机辨识结果的闪存存储（NVS，命名空间 "motorid"）
+bool motorIdStoreSave(const MotorIdTable &table);
+// 没有保存过或版本不符时返回 false
+bool motorIdStoreLoad(MotorIdTable *table);
@@ -1,122 +1,221 @@
 #include <Arduino.h>
+#include "motors.h"
+#include "motor_driver.h"
+#include "motorid.h"
+#include "battery.h"
 
-// TB6612FNG 电机控制引脚定义
-// 电机A
-static const int AIN1 = 40; // 方向引脚1
-static const int AIN2 = 41;  // 方向引脚2
-static const int PWMA = 42; // PWM速度控制
-
-// 电机B
-static const int BIN1 = 38; // 方向引脚1
-static const int BIN2 = 37; // 方向引脚2
-static const int PWMB = 36; // PWM速度控制
-
-// 公共引脚
-static const int STBY = 39; // 待机控制
-
-// PWM参数
-static const int pwmChannelA = 0; // 电机A的PWM通道
-static const int pwmChannelB = 1; // 电机B的PWM通道
-static const int freq = 1000;     // PWM频率1kHz
-static const int resolution = 8;  // 8位分辨率(0-255)
-
-// 记录当前速度（带符号，正=正转，负=反转）
-static volatile int currentSpeedA = 0;
-static volatile int currentSpeedB = 0;
-
-void initMotors()
+// Arduino/ESP32 LEDC 引脚后端
+struct ArduinoPins
 {
-    pinMode(AIN1, OUTPUT);
-    pinMode(AIN2, OUTPUT);
-    pinMode(BIN1, OUTPUT);
-    pinMode(BIN2, OUTPUT);
-    pinMode(STBY, OUTPUT);
-
-    ledcSetup(pwmChannelA, freq, resolution);
-    ledcSetup(pwmChannelB, freq, resolution);
-    ledcAttachPin(PWMA, pwmChannelA);
-    ledcAttachPin(PWMB, pwmChannelB);
+    static void pinOutput(int pin) { pinMode(pin, OUTPUT); }
+    static void write(int pin, bool high) { digitalWrite(pin, high ? HIGH : LOW); }
+    static void pwmSetup(int channel, int freq, int bits) { ledcSetup(channel, freq, bits); }
+    static void pwmAttach(int pin, int channel) { ledcAttachPin(pin, channel); }
+    static void pwmWrite(int channel, int duty) { ledcWrite(channel, duty); }
+};
+
+// 车轮布局：按 build_flags 选择，车轮顺序统一为 左、右、（左、右）
+#if defined(MOTOR_DRIVER_DRV8833)
+// DRV8833：每路两个 PWM 输入，占用 LEDC 通道 0~3，nSLEEP 接原 STBY 引脚
+using MotorLeft = Drv8833Motor<ArduinoPins, 40, 41, 0, 1>;
+using MotorRight = Drv8833Motor<ArduinoPins, 38, 37, 2, 3>;
+using DriveMotors = MotorBank<MotorEnablePins<ArduinoPins, 39>, MotorLeft, MotorRight>;
+using DriveMixer = DiffMixer<WHEEL_LEFT, WHEEL_RIGHT>;
+#elif defined(MOTOR_LAYOUT_4WD)
+// 四驱：前轮沿用原 TB6612FNG，后轮接第二块 TB6612FNG（LEDC 通道 2/3）。
+// 原车没有后轮驱动板，下面的后轮引脚只是示例接线（S3 上未被占用的 GPIO 6~12），
+// 按实际接线在 build_flags 中覆盖，例如 -DMOTOR_REAR_LEFT_PINS=4,5,6 -DMOTOR_REAR_STBY_PIN=7
+#ifndef MOTOR_REAR_LEFT_PINS
+#define MOTOR_REAR_LEFT_PINS 6, 7, 8 // IN1, IN2, PWM
+#endif
+#ifndef MOTOR_REAR_RIGHT_PINS
+#define MOTOR_REAR_RIGHT_PINS 9, 10, 11
+#endif
+#ifndef MOTOR_REAR_STBY_PIN
+#define MOTOR_REAR_STBY_PIN 12
+#endif
+using MotorFrontLeft = Tb6612Motor<ArduinoPins, 40, 41, 42, 0>;
+using MotorFrontRight = Tb6612Motor<ArduinoPins, 38, 37, 36, 1>;
+using MotorRearLeft = Tb6612Motor<ArduinoPins, MOTOR_REAR_LEFT_PINS, 2>;
+using MotorRearRight = Tb6612Motor<ArduinoPins, MOTOR_REAR_RIGHT_PINS, 3>;
+using DriveMotors = MotorBank<MotorEnablePins<ArduinoPins, 39, MOTOR_REAR_STBY_PIN>,
+                              MotorFrontLeft, MotorFrontRight, MotorRearLeft, MotorRearRight>;
+using DriveMixer = DiffMixer<WHEEL_LEFT, WHEEL_RIGHT, WHEEL_LEFT, WHEEL_RIGHT>;
+#else
+// 默认：单块 TB6612FNG，A 路 AIN1=40 AIN2=41 PWMA=42，B 路 BIN1=38 BIN2=37 PWMB=36，STBY=39
+using MotorLeft = Tb6612Motor<ArduinoPins, 40, 41, 42, 0>;
+using MotorRight = Tb6612Motor<ArduinoPins, 38, 37, 36, 1>;
+using DriveMotors = MotorBank<MotorEnablePins<ArduinoPins, 39>, MotorLeft, MotorRight>;
+using DriveMixer = DiffMixer<WHEEL_LEFT, WHEEL_RIGHT>;
+#endif
+
+static_assert(DriveMotors::COUNT == DriveMixer::COUNT, "车轮布局与电机数量不一致");
+
+// 左右两侧的代表车轮（getSpeedA/B 读取）
+static constexpr size_t LEFT_WHEEL = 0;
+static constexpr size_t RIGHT_WHEEL = 1;
+
+// 紧急刹车锁存：传感器任务（核心 0）与 loop（核心 1）都会写电机。自旋锁只保护锁存标志与 commands[]，
+// 写引脚（ledcWrite）放在临界区外；写完后若锁存已置位则再刹车一次，保证锁存之后电机最终处于刹车状态
+static portMUX_TYPE driveMux = portMUX_INITIALIZER_UNLOCKED;
+static bool emergencyLatched = false;
+
+// 前馈补偿：命令经辨识得到的查找表换算为占空比，查找表只在 loop 中读写。
+// commands[] 是各车轮命令的唯一记录：限幅后、前馈与电压补偿前的值，getSpeedA/B 读取它
+static MotorIdTable feedForwardTable = {};
+static bool feedForward = false;
+static volatile int commands[DriveMotors::COUNT] = {};
+
+// 需在 driveMux 内调用：锁存时记为 0，返回记录的命令
+static int recordCommand(size_t wheel, int command)
+{
+    command = emergencyLatched ? 0 : motorClampSpeed(command);
+    commands[wheel] = command;
+    return command;
+}
 
-    // 启动驱动芯片（取消待机）
-    digitalWrite(STBY, HIGH);
+// 临界区外调用：前馈之后再按电池电压缩放占空比
+static void driveWheel(size_t wheel, int command)
+{
+    const size_t side = DriveMixer::side(wheel) == WHEEL_LEFT ? 0 : 1;
+    const int duty = feedForward ? motorIdApply(feedForwardTable, side, command) : command;
+    DriveMotors::drive(wheel, batteryCompensate(duty));
 }
 
-void motorA(int speed)
+// 写完引脚后检查锁存：紧急刹车可能发生在记录命令与写引脚之间，此时刚写入的占空比必须再刹掉
+static void enforceLatch()
 {
-    speed = constrain(speed, -255, 255);
+    portENTER_CRITICAL(&driveMux);
+    const bool latched = emergencyLatched;
+    portEXIT_CRITICAL(&driveMux);
+    if (latched)
+    {
+        DriveMotors::brakeAll();
+    }
+}
 
-    if (speed > 0)
+static void clearCommands()
+{
+    for (size_t i = 0; i < DriveMotors::COUNT; ++i)
     {
-        digitalWrite(AIN1, HIGH);
-        digitalWrite(AIN2, LOW);
-        ledcWrite(pwmChannelA, speed);
+        commands[i] = 0;
     }
-    else if (speed < 0)
+}
+
+static void driveSide(int8_t side, int speed)
+{
+    int recorded[DriveMotors::COUNT];
+    portENTER_CRITICAL(&driveMux);
+    for (size_t i = 0; i < DriveMotors::COUNT; ++i)
     {
-        digitalWrite(AIN1, LOW);
-        digitalWrite(AIN2, HIGH);
-        ledcWrite(pwmChannelA, -speed);
+        if (DriveMixer::side(i) == side)
+        {
+            recorded[i] = recordCommand(i, speed);
+        }
     }
-    else
+    portEXIT_CRITICAL(&driveMux);
+    for (size_t i = 0; i < DriveMotors::COUNT; ++i)
     {
-        // 停止（刹车）
-        digitalWrite(AIN1, HIGH);
-        digitalWrite(AIN2, HIGH);
-        ledcWrite(pwmChannelA, 0);
+        if (DriveMixer::side(i) == side)
+        {
+            driveWheel(i, recorded[i]);
+        }
     }
-    currentSpeedA = speed;
+    enforceLatch();
+}
+
+void initMotors()
+{
+    DriveMotors::init();
+}
+
+void motorA(int speed)
+{
+    driveSide(WHEEL_LEFT, speed);
 }
 
 void motorB(int speed)
 {
-    speed = constrain(speed, -255, 255);
+    driveSide(WHEEL_RIGHT, speed);
+}
 
-    if (speed > 0)
-    {
-        digitalWrite(BIN1, HIGH);
-        digitalWrite(BIN2, LOW);
-        ledcWrite(pwmChannelB, speed);
-    }
-    else if (speed < 0)
+void motors(int speedA, int speedB)
+{
+    motorA(speedA);
+    motorB(speedB);
+}
+
+void motorsMix(int throttle, int turn)
+{
+    int wheels[DriveMixer::COUNT];
+    DriveMixer::mix(throttle, turn, wheels);
+    portENTER_CRITICAL(&driveMux);
+    for (size_t i = 0; i < DriveMotors::COUNT; ++i)
     {
-        digitalWrite(BIN1, LOW);
-        digitalWrite(BIN2, HIGH);
-        ledcWrite(pwmChannelB, -speed);
+        wheels[i] = recordCommand(i, wheels[i]);
     }
-    else
+    portEXIT_CRITICAL(&driveMux);
+    for (size_t i = 0; i < DriveMotors::COUNT; ++i)
     {
-        digitalWrite(BIN1, HIGH);
-        digitalWrite(BIN2, HIGH);
-        ledcWrite(pwmChannelB, 0);
+        driveWheel(i, wheels[i]);
     }
-    currentSpeedB = speed;
+    enforceLatch();
 }
 
-void motors(int speedA, int speedB)
+void brakeAll()
 {
-    motorA(speedA);
-    motorB(speedB);
+    portENTER_CRITICAL(&driveMux);
+    clearCommands();
+    portEXIT_CRITICAL(&driveMux);
+    DriveMotors::brakeAll();
 }
 
-void brakeAll()
+// 先置锁存再刹车：之后 loop 记录的命令都为 0，正在写引脚的 loop 写完后也会看到锁存并再刹一次
+void motorsEmergencyStop()
+{
+    portENTER_CRITICAL(&driveMux);
+    emergencyLatched = true;
+    clearCommands();
+    portEXIT_CRITICAL(&driveMux);
+    DriveMotors::brakeAll();
+}
+
+void motorsClearEmergency()
+{
+    portENTER_CRITICAL(&driveMux);
+    emergencyLatched = false;
+    portEXIT_CRITICAL(&driveMux);
+}
+
+bool motorsEmergencyLatched()
+{
+    return emergencyLatched;
+}
+
+// 与 driveWheel 同在 loop 中调用，无需加锁
+void motorsSetFeedForward(const MotorIdTable *table)
+{
+    feedForward = table != nullptr;
+    if (table != nullptr)
+    {
+        feedForwardTable = *table;
+    }
+}
+
+bool motorsFeedForwardEnabled()
 {
-    digitalWrite(AIN1, HIGH);
-    digitalWrite(AIN2, HIGH);
-    digitalWrite(BIN1, HIGH);
-    digitalWrite(BIN2, HIGH);
-    ledcWrite(pwmChannelA, 0);
-    ledcWrite(pwmChannelB, 0);
+    return feedForward;
 }
 
 void standby()
 {
-    digitalWrite(STBY, LOW);
+    DriveMotors::standby();
 }
 
 void wakeup()
 {
-    digitalWrite(STBY, HIGH);
+    DriveMotors::wakeup();
 }
 
-int getSpeedA() { return currentSpeedA; }
-int getSpeedB() { return currentSpeedB; }
+int getSpeedA() { return commands[LEFT_WHEEL]; }
+int getSpeedB() { return commands[RIGHT_WHEEL]; }
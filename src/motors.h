@@ -1,4 +1,5 @@
 #pragma once
+#include "motorid.h"
 
 void initMotors();
 
@@ -6,9 +7,22 @@ void motorA(int speed);
 void motorB(int speed);
 void motors(int speedA, int speedB);
 
+// 差速混控：throttle 为前进速度，turn > 0 向右转，按车轮布局分配到所有电机
+void motorsMix(int throttle, int turn);
+
 void brakeAll();
 void standby();
 void wakeup();
 
+// 紧急刹车：可在传感器任务中调用，刹停后锁存，之后的驱动命令一律输出 0，直到 loop 清除
+void motorsEmergencyStop();
+void motorsClearEmergency();
+bool motorsEmergencyLatched();
+
+// 前馈补偿：传入辨识得到的查找表后，所有驱动命令先换算为占空比；传 nullptr 关闭（辨识时输出原始占空比）
+void motorsSetFeedForward(const MotorIdTable *table);
+bool motorsFeedForwardEnabled();
+
+// 当前命令（补偿前，-255~255）
 int getSpeedA();
 int getSpeedB();
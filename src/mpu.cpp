@@ -1,7 +1,12 @@
 #include "mpu.h"
+#include "collision.h"
+#include "motors.h"
+#include "thermal_bias.h"
+#include "zupt.h"
 #include <Adafruit_MPU6050.h>
 #include <Adafruit_Sensor.h>
 #include <Wire.h>
+#include <atomic>
 #include <math.h>
 
 namespace
@@ -11,32 +16,205 @@ namespace
   float gyroXoffset = 0.0f, gyroYoffset = 0.0f, gyroZoffset = 0.0f;
 
   constexpr float GRAVITY = 9.80665f;
-  constexpr float YAW_ZERO_THRESHOLD = 0.1f;
-  constexpr unsigned long YAW_ZERO_TIME = 2000;
+  constexpr float DEG_PER_RAD = static_cast<float>(180.0 / PI);
 
   MpuState state = {};
-  bool yawZeroing = false;
-  unsigned long yawZeroStartTime = 0;
+  MpuSample sample = {};
   bool initialized = false;
+  volatile uint8_t calibrationPercent = 0; // 陀螺占前一半，加速度计占后一半
+  bool wasStationary = false;
+  float lastVelocityDrift = 0.0f; // 最近一次零速更新时被清除的速度幅值
+  float maxVelocityDrift = 0.0f;
+
+  // 温度-零偏模型：零偏按“当前温度与校准温度下模型值之差”修正，静止检测只需跟踪模型之外的残余。
+  // 参考温度固定为校准时的温度：若以每次静止时的温度为参考，静止跟踪在短暂停车内尚未收敛（时间常数 2 s），残余会被带入下一段行驶
+  constexpr float DIE_TEMPERATURE_TAU_S = 1.0f;     // 平滑芯片温度读数的量化跳动
+  constexpr float LEVEL_LIMIT_DEG = 3.0f;           // 学习 Z 轴加速度零偏的倾斜上限
+  constexpr uint32_t THERMAL_PUBLISH_SAMPLES = 500; // 约 1 s 向 loop 发布一次模型副本
+  float dieTemperatureC = NAN;
+  float gyroReferenceC = NAN;     // 陀螺校准时的温度
+  float accelReferenceC = NAN;    // 加速度计校准时的温度
+  float thermalShiftZ = 0.0f;     // 当前模型对 Z 轴零偏的修正（°/s）
+  float thermalShiftDrift = 0.0f; // 每次进入静止时模型修正量的指数平均（°/min），用于对照没有模型时的漂移
+  uint32_t thermalShiftCount = 0;
+  uint32_t thermalPublishCountdown = 0;
+  ThermalBiasTable thermalCopy = {}; // 不放在任务栈上
+
+  // 传感器任务与 loop 之间的快照，由自旋锁保护
+  constexpr uint32_t SENSOR_TASK_STACK = 4096;
+  constexpr UBaseType_t SENSOR_TASK_PRIORITY = 5;
+  portMUX_TYPE snapshotMux = portMUX_INITIALIZER_UNLOCKED;
+  MpuState sharedState = {};
+  MpuSample sharedSample = {};
+  MpuDriftMetrics sharedDrift = {};
+  ThermalBiasTable sharedThermal = {};
+  bool sharedThermalValid = false;
+  uint32_t goodSamples = 0;
+  bool lastSampleOk = false;
+  MpuState fetchedState = {};
+  MpuSample fetchedSample = {};
+  uint32_t fetchedGoodSamples = 0;
+  // 样本队列：任务在快照临界区内写入，满时丢弃最新样本
+  MpuQueuedSample sampleQueue[MPU_SAMPLE_QUEUE_SIZE];
+  size_t queueHead = 0; // 下一个取出的位置
+  size_t queueCount = 0;
+  uint32_t queueDropped = 0;
+  std::atomic<uint8_t> pendingCollision(static_cast<uint8_t>(CollisionKind::None));
+  std::atomic<bool> recoverRequested(false);
+  bool taskRunning = false;
+
+  // 原始读数连续完全相同视为传感器冻结（芯片掉电复位后寄存器停在最后一次转换的值）
+  constexpr int FROZEN_SAMPLE_LIMIT = 20;
+  float lastRaw[6] = {};
+  int frozenSamples = 0;
+  uint32_t readDoneMicros = 0; // 最近一次读完样本的时刻
+
+  // 直接按寄存器读一帧：库的 getEvent 不检查总线结果，读失败时仍返回 true 和上一次的缓冲。
+  // 量程与 configureSensor 一致：±8 g 为 4096 LSB/g，±500 °/s 为 65.5 LSB/(°/s)
+  constexpr uint32_t I2C_CLOCK_HZ = 400000; // 与 OLED 共用总线，一帧 14 字节约 0.5 ms（100 kHz 时约 2 ms）
+  constexpr uint8_t MPU_ADDRESS = 0x68;
+  constexpr uint8_t REG_ACCEL_XOUT_H = 0x3B; // 加速度 6 字节、温度 2 字节、陀螺 6 字节连续排列
+  constexpr uint8_t FRAME_BYTES = 14;
+  constexpr float ACCEL_LSB_PER_G = 4096.0f;
+  constexpr float GYRO_LSB_PER_DPS = 65.5f;
+
+  struct RawFrame
+  {
+    float accel[3]; // m/s²
+    float gyro[3];  // rad/s，与 getEvent 相同
+    float temperature;
+  };
+
+  bool readFrame(RawFrame *frame)
+  {
+    Wire.beginTransmission(MPU_ADDRESS);
+    Wire.write(REG_ACCEL_XOUT_H);
+    if (Wire.endTransmission(false) != 0)
+    {
+      return false;
+    }
+    if (Wire.requestFrom(MPU_ADDRESS, FRAME_BYTES) != FRAME_BYTES)
+    {
+      return false;
+    }
+    int16_t words[FRAME_BYTES / 2];
+    for (int i = 0; i < FRAME_BYTES / 2; ++i)
+    {
+      const uint8_t high = static_cast<uint8_t>(Wire.read());
+      const uint8_t low = static_cast<uint8_t>(Wire.read());
+      words[i] = static_cast<int16_t>((high << 8) | low);
+    }
+    for (int i = 0; i < 3; ++i)
+    {
+      frame->accel[i] = words[i] / ACCEL_LSB_PER_G * GRAVITY;
+      frame->gyro[i] = words[4 + i] / GYRO_LSB_PER_DPS / DEG_PER_RAD;
+    }
+    frame->temperature = words[3] / 340.0f + 36.53f;
+    return true;
+  }
+
+  bool configureSensor()
+  {
+    if (!mpu.begin())
+    {
+      return false;
+    }
+    mpu.setAccelerometerRange(MPU6050_RANGE_8_G);
+    mpu.setGyroRange(MPU6050_RANGE_500_DEG);
+    mpu.setFilterBandwidth(MPU6050_BAND_44_HZ);
+    frozenSamples = 0;
+    return true;
+  }
+
+  void resetEstimator()
+  {
+    const float gyroBias[3] = {gyroXoffset, gyroYoffset, gyroZoffset};
+    zuptInit(gyroBias);
+
+    state = {};
+    wasStationary = false;
+    lastVelocityDrift = 0.0f;
+    maxVelocityDrift = 0.0f;
+    thermalShiftZ = 0.0f;
+    thermalShiftDrift = 0.0f;
+    thermalShiftCount = 0;
+  }
+
+  void updateDieTemperature(float deltaTime, float temperatureC)
+  {
+    if (isnan(dieTemperatureC))
+    {
+      dieTemperatureC = temperatureC;
+    }
+    dieTemperatureC += (temperatureC - dieTemperatureC) * fminf(deltaTime / DIE_TEMPERATURE_TAU_S, 1.0f);
+    // 开机未能校准时以首个读数为参考，之后由静止检测在线学习该温度下的零偏
+    if (isnan(gyroReferenceC))
+    {
+      gyroReferenceC = dieTemperatureC;
+    }
+    if (isnan(accelReferenceC))
+    {
+      accelReferenceC = dieTemperatureC;
+    }
+  }
+
+  // 模型中当前温度与参考温度下零偏之差，模型为空时为 0
+  void thermalGyroShift(float shift[3])
+  {
+    float now[3];
+    float reference[3];
+    if (!thermalBiasGyro(dieTemperatureC, now) || !thermalBiasGyro(gyroReferenceC, reference))
+    {
+      shift[0] = shift[1] = shift[2] = 0.0f;
+      return;
+    }
+    for (int i = 0; i < 3; ++i)
+    {
+      shift[i] = now[i] - reference[i];
+    }
+  }
+
+  float thermalAccelZShift()
+  {
+    float now;
+    float reference;
+    if (!thermalBiasAccelZ(dieTemperatureC, &now) || !thermalBiasAccelZ(accelReferenceC, &reference))
+    {
+      return 0.0f;
+    }
+    return now - reference;
+  }
 
   void calibrateGyro()
   {
     Serial.println("校准陀螺仪，保持传感器静止...");
-    float sumX = 0.0f, sumY = 0.0f, sumZ = 0.0f;
+    float sumX = 0.0f, sumY = 0.0f, sumZ = 0.0f, sumT = 0.0f;
+    int good = 0;
 
     for (int i = 0; i < 1000; ++i)
     {
-      sensors_event_t a, g, temp;
-      mpu.getEvent(&a, &g, &temp);
-      sumX += g.gyro.x * 180.0f / PI;
-      sumY += g.gyro.y * 180.0f / PI;
-      sumZ += g.gyro.z * 180.0f / PI;
+      RawFrame frame;
+      if (readFrame(&frame))
+      {
+        sumX += frame.gyro[0] * DEG_PER_RAD;
+        sumY += frame.gyro[1] * DEG_PER_RAD;
+        sumZ += frame.gyro[2] * DEG_PER_RAD;
+        sumT += frame.temperature;
+        ++good;
+      }
+      calibrationPercent = static_cast<uint8_t>(i / 20);
       delay(5);
     }
+    if (good == 0)
+    {
+      Serial.println("陀螺仪校准失败：总线无响应");
+      return; // 零偏保持 0，由静止检测在线学习
+    }
 
-    gyroXoffset = sumX / 1000.0f;
-    gyroYoffset = sumY / 1000.0f;
-    gyroZoffset = sumZ / 1000.0f;
+    gyroXoffset = sumX / good;
+    gyroYoffset = sumY / good;
+    gyroZoffset = sumZ / good;
+    gyroReferenceC = sumT / good;
 
     Serial.println("校准完成");
   }
@@ -45,19 +223,31 @@ namespace
   {
     Serial.println("校准加速度计，保持传感器静止并水平...");
     const int samples = 1000;
-    float sumX = 0.0f, sumY = 0.0f, sumZ = 0.0f;
+    float sumX = 0.0f, sumY = 0.0f, sumZ = 0.0f, sumT = 0.0f;
+    int good = 0;
     for (int i = 0; i < samples; ++i)
     {
-      sensors_event_t a, g, temp;
-      mpu.getEvent(&a, &g, &temp);
-      sumX += a.acceleration.x;
-      sumY += a.acceleration.y;
-      sumZ += a.acceleration.z;
+      RawFrame frame;
+      if (readFrame(&frame))
+      {
+        sumX += frame.accel[0];
+        sumY += frame.accel[1];
+        sumZ += frame.accel[2];
+        sumT += frame.temperature;
+        ++good;
+      }
+      calibrationPercent = static_cast<uint8_t>(50 + i * 50 / samples);
       delay(5);
     }
-    accelXoffset = sumX / samples;
-    accelYoffset = sumY / samples;
-    accelZoffset = sumZ / samples - GRAVITY;
+    if (good == 0)
+    {
+      Serial.println("加速度计校准失败：总线无响应");
+      return;
+    }
+    accelXoffset = sumX / good;
+    accelYoffset = sumY / good;
+    accelZoffset = sumZ / good - GRAVITY;
+    accelReferenceC = sumT / good;
     Serial.println("加速度计校准完成");
   }
 
@@ -107,71 +297,131 @@ namespace
 bool mpuInit(uint8_t sdaPin, uint8_t sclPin)
 {
   Wire.begin(sdaPin, sclPin);
+  Wire.setClock(I2C_CLOCK_HZ);
 
-  if (!mpu.begin())
+  if (!configureSensor())
   {
     Serial.println("找不到MPU6050芯片！");
     return false;
   }
   Serial.println("MPU6050初始化成功！");
 
-  mpu.setAccelerometerRange(MPU6050_RANGE_8_G);
-  mpu.setGyroRange(MPU6050_RANGE_500_DEG);
-  mpu.setFilterBandwidth(MPU6050_BAND_21_HZ);
-
   calibrateGyro();
   calibrateAccelerometer();
 
-  state = {};
-  yawZeroing = false;
-  yawZeroStartTime = 0;
+  resetEstimator();
+  calibrationPercent = 100;
   initialized = true;
   return true;
 }
 
-void mpuUpdate(float deltaTime)
+uint8_t mpuCalibrationPercent()
 {
-  if (!initialized)
+  return calibrationPercent;
+}
+
+namespace
+{
+  bool reconfigure()
   {
-    return;
+    if (!configureSensor())
+    {
+      return false;
+    }
+    // 开机未能校准时沿用零偏 0，由静止检测在线学习
+    if (!initialized)
+    {
+      resetEstimator();
+      initialized = true;
+    }
+    return true;
   }
+} // namespace
 
-  sensors_event_t a, g, temp;
-  mpu.getEvent(&a, &g, &temp);
-
-  const float accelX = a.acceleration.x - accelXoffset;
-  const float accelY = a.acceleration.y - accelYoffset;
-  const float accelZ = a.acceleration.z - accelZoffset;
-
-  const float gyroX = g.gyro.x * 180.0f / PI - gyroXoffset;
-  const float gyroY = g.gyro.y * 180.0f / PI - gyroYoffset;
-  const float gyroZ = g.gyro.z * 180.0f / PI - gyroZoffset;
+bool mpuRecover()
+{
+  if (taskRunning)
+  {
+    recoverRequested.store(true);
+    return true;
+  }
+  return reconfigure();
+}
 
-  const float accelRoll = atan2f(accelY, accelZ) * 180.0f / PI;
-  const float accelPitch = atan2f(-accelX, sqrtf(accelY * accelY + accelZ * accelZ)) * 180.0f / PI;
+static bool updateEstimator(float deltaTime)
+{
+  if (!initialized)
+  {
+    return false;
+  }
 
-  state.roll = 0.98f * (state.roll + gyroX * deltaTime) + 0.02f * accelRoll;
-  state.pitch = 0.98f * (state.pitch + gyroY * deltaTime) + 0.02f * accelPitch;
-  state.yaw += gyroZ * deltaTime;
+  RawFrame frame;
+  if (!readFrame(&frame))
+  {
+    return false;
+  }
+  readDoneMicros = micros();
+  const float *accelRaw = frame.accel;
+  const float *gyroRaw = frame.gyro;
 
-  if (fabsf(gyroZ) < YAW_ZERO_THRESHOLD)
+  const float raw[6] = {accelRaw[0], accelRaw[1], accelRaw[2], gyroRaw[0], gyroRaw[1], gyroRaw[2]};
+  bool identical = true;
+  for (int i = 0; i < 6; ++i)
   {
-    if (!yawZeroing)
+    if (isnan(raw[i]))
     {
-      yawZeroing = true;
-      yawZeroStartTime = millis();
+      return false;
     }
-    else if (millis() - yawZeroStartTime >= YAW_ZERO_TIME)
+    identical = identical && raw[i] == lastRaw[i];
+    lastRaw[i] = raw[i];
+  }
+  frozenSamples = identical ? frozenSamples + 1 : 0;
+  if (frozenSamples >= FROZEN_SAMPLE_LIMIT)
+  {
+    return false;
+  }
+
+  updateDieTemperature(deltaTime, frame.temperature);
+  const float accelX = accelRaw[0] - accelXoffset;
+  const float accelY = accelRaw[1] - accelYoffset;
+  const float accelZ = accelRaw[2] - accelZoffset - thermalAccelZShift();
+
+  // 静止检测：静止期间跟踪陀螺零偏、冻结偏航角并把速度清零（保留绝对航向）
+  const float rawAccel[3] = {accelRaw[0], accelRaw[1], accelRaw[2]};
+  const float rawGyro[3] = {gyroRaw[0] * DEG_PER_RAD, gyroRaw[1] * DEG_PER_RAD, gyroRaw[2] * DEG_PER_RAD};
+  float shift[3];
+  thermalGyroShift(shift);
+  thermalShiftZ = shift[2];
+  const float modelGyro[3] = {rawGyro[0] - shift[0], rawGyro[1] - shift[1], rawGyro[2] - shift[2]};
+  const bool motorsIdle = getSpeedA() == 0 && getSpeedB() == 0;
+  const bool stationary = zuptUpdate(deltaTime, rawAccel, modelGyro, motorsIdle);
+  if (stationary)
+  {
+    // 静止时的原始读数就是当前温度下的零偏；Z 轴加速度只在接近水平时学习（倾斜 3° 时误差 0.013 m/s²）
+    thermalBiasLearnGyro(dieTemperatureC, rawGyro);
+    if (fabsf(state.roll) < LEVEL_LIMIT_DEG && fabsf(state.pitch) < LEVEL_LIMIT_DEG)
     {
-      state.yaw = 0.0f;
-      Serial.println("偏航角已自动归零");
-      yawZeroing = false;
+      thermalBiasLearnAccelZ(dieTemperatureC, accelRaw[2]);
     }
   }
-  else
+
+  float gyro[3];
+  zuptCorrectGyro(modelGyro, gyro);
+  const float gyroX = gyro[0];
+  const float gyroY = gyro[1];
+  const float gyroZ = gyro[2];
+  sample = {{accelX, accelY, accelZ}, {gyroX, gyroY, gyroZ}, frame.temperature};
+
+  const float accelRoll = atan2f(accelY, accelZ) * 180.0f / PI;
+  const float accelPitch = atan2f(-accelX, sqrtf(accelY * accelY + accelZ * accelZ)) * 180.0f / PI;
+
+  state.roll = 0.98f * (state.roll + gyroX * deltaTime) + 0.02f * accelRoll;
+  state.pitch = 0.98f * (state.pitch + gyroY * deltaTime) + 0.02f * accelPitch;
+  if (!stationary)
   {
-    yawZeroing = false;
+    state.yaw += gyroZ * deltaTime;
   }
+  state.yawRate = gyroZ;
 
   const float rollRad = state.roll * PI / 180.0f;
   const float pitchRad = state.pitch * PI / 180.0f;
@@ -199,9 +449,203 @@ void mpuUpdate(float deltaTime)
 
   state.velocityX *= 0.99f;
   state.velocityY *= 0.99f;
+
+  if (stationary)
+  {
+    if (!wasStationary)
+    {
+      // 刚进入静止时残留的速度就是运动期间积分产生的漂移
+      lastVelocityDrift = hypotf(state.velocityX, state.velocityY);
+      maxVelocityDrift = fmaxf(maxVelocityDrift, lastVelocityDrift);
+    }
+    state.velocityX = 0.0f;
+    state.velocityY = 0.0f;
+  }
+  wasStationary = stationary;
+  return true;
+}
+
+namespace
+{
+  MpuDriftMetrics computeDriftMetrics()
+  {
+    const ZuptMetrics &zupt = zuptGetMetrics();
+    MpuDriftMetrics metrics = {};
+    metrics.stationary = zupt.stationary;
+    metrics.zuptCount = zupt.stationaryCount;
+    metrics.gyroBiasZ = zupt.gyroBias[2];
+    metrics.headingDriftDegPerMin = zupt.headingDriftDegPerMin;
+    metrics.bootBiasDriftDegPerMin = zupt.bootBiasDriftDegPerMin;
+    metrics.lastVelocityDrift = lastVelocityDrift;
+    metrics.maxVelocityDrift = maxVelocityDrift;
+
+    // 两个指数平均的更新规则相同，之和即没有模型修正时的漂移
+    if (zupt.stationaryCount != thermalShiftCount)
+    {
+      const float drift = thermalShiftZ * 60.0f;
+      thermalShiftDrift = thermalShiftCount == 0 ? drift : thermalShiftDrift + (drift - thermalShiftDrift) * 0.3f;
+      thermalShiftCount = zupt.stationaryCount;
+    }
+    metrics.uncompensatedDriftDegPerMin = zupt.headingDriftDegPerMin + thermalShiftDrift;
+    metrics.temperatureC = dieTemperatureC;
+    metrics.thermalShiftZ = thermalShiftZ;
+    metrics.thermalBins = static_cast<uint8_t>(thermalBiasValidBins());
+    metrics.thermalSamples = thermalBiasSamples();
+    return metrics;
+  }
+
+  // 碰撞快速通道：在采样任务内判定并直接刹车，loop 只负责后续的后退避让
+  void detectCollision(uint32_t sampleMicros)
+  {
+    const CollisionKind kind = collisionUpdate(sampleMicros, sample.accel, sample.gyro, getSpeedA(), getSpeedB());
+    if (kind == CollisionKind::None)
+    {
+      return;
+    }
+    motorsEmergencyStop();
+    collisionReportLatency(micros() - sampleMicros, readDoneMicros - sampleMicros);
+    pendingCollision.store(static_cast<uint8_t>(kind));
+  }
+
+  void sensorTask(void *)
+  {
+    TickType_t wake = xTaskGetTickCount();
+    uint32_t lastMicros = micros();
+    while (true)
+    {
+      vTaskDelayUntil(&wake, pdMS_TO_TICKS(MPU_SAMPLE_PERIOD_MS));
+      if (recoverRequested.exchange(false))
+      {
+        reconfigure();
+      }
+
+      // 样本时刻取在发起读取之前：显示占用总线时的等待也计入碰撞延迟
+      const uint32_t sampleMicros = micros();
+      const float deltaTime = (sampleMicros - lastMicros) / 1000000.0f;
+      lastMicros = sampleMicros;
+      const bool ok = updateEstimator(deltaTime);
+      if (ok)
+      {
+        detectCollision(sampleMicros);
+      }
+
+      const MpuDriftMetrics drift = computeDriftMetrics();
+      const bool publishThermal = thermalPublishCountdown == 0;
+      thermalPublishCountdown = publishThermal ? THERMAL_PUBLISH_SAMPLES : thermalPublishCountdown - 1;
+      if (publishThermal)
+      {
+        thermalBiasGetTable(&thermalCopy);
+      }
+      portENTER_CRITICAL(&snapshotMux);
+      sharedState = state;
+      sharedSample = sample;
+      sharedDrift = drift;
+      if (publishThermal)
+      {
+        sharedThermal = thermalCopy;
+        sharedThermalValid = true;
+      }
+      if (ok)
+      {
+        ++goodSamples;
+        if (queueCount < MPU_SAMPLE_QUEUE_SIZE)
+        {
+          sampleQueue[(queueHead + queueCount) % MPU_SAMPLE_QUEUE_SIZE] = {sampleMicros, sample};
+          ++queueCount;
+        }
+        else
+        {
+          ++queueDropped;
+        }
+      }
+      lastSampleOk = ok;
+      portEXIT_CRITICAL(&snapshotMux);
+    }
+  }
+} // namespace
+
+bool mpuStartTask()
+{
+  if (taskRunning)
+  {
+    return true;
+  }
+  taskRunning = xTaskCreatePinnedToCore(sensorTask, "imu", SENSOR_TASK_STACK, nullptr, SENSOR_TASK_PRIORITY, nullptr, 0) == pdPASS;
+  return taskRunning;
+}
+
+bool mpuFetch()
+{
+  portENTER_CRITICAL(&snapshotMux);
+  fetchedState = sharedState;
+  fetchedSample = sharedSample;
+  const uint32_t good = goodSamples;
+  const bool ok = lastSampleOk;
+  portEXIT_CRITICAL(&snapshotMux);
+
+  const bool fresh = ok && good != fetchedGoodSamples;
+  fetchedGoodSamples = good;
+  return fresh;
+}
+
+size_t mpuTakeSamples(MpuQueuedSample *out, size_t maxCount)
+{
+  portENTER_CRITICAL(&snapshotMux);
+  const size_t count = queueCount < maxCount ? queueCount : maxCount;
+  for (size_t i = 0; i < count; ++i)
+  {
+    out[i] = sampleQueue[queueHead];
+    queueHead = (queueHead + 1) % MPU_SAMPLE_QUEUE_SIZE;
+  }
+  queueCount -= count;
+  portEXIT_CRITICAL(&snapshotMux);
+  return count;
+}
+
+uint32_t mpuDroppedSamples()
+{
+  portENTER_CRITICAL(&snapshotMux);
+  const uint32_t dropped = queueDropped;
+  portEXIT_CRITICAL(&snapshotMux);
+  return dropped;
+}
+
+CollisionKind mpuTakeCollision()
+{
+  return static_cast<CollisionKind>(pendingCollision.exchange(static_cast<uint8_t>(CollisionKind::None)));
 }
 
 const MpuState &mpuGetState()
 {
-  return state;
+  return fetchedState;
+}
+
+const MpuSample &mpuGetSample()
+{
+  return fetchedSample;
+}
+
+MpuDriftMetrics mpuGetDriftMetrics()
+{
+  portENTER_CRITICAL(&snapshotMux);
+  const MpuDriftMetrics metrics = sharedDrift;
+  portEXIT_CRITICAL(&snapshotMux);
+  return metrics;
+}
+
+bool mpuSetThermalTable(const ThermalBiasTable &table)
+{
+  return thermalBiasLoad(table);
+}
+
+bool mpuGetThermalTable(ThermalBiasTable *out)
+{
+  portENTER_CRITICAL(&snapshotMux);
+  const bool valid = sharedThermalValid;
+  if (valid)
+  {
+    *out = sharedThermal;
+  }
+  portEXIT_CRITICAL(&snapshotMux);
+  return valid;
 }
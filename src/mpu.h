@@ -1,16 +1,85 @@
 #pragma once
 
 #include <Arduino.h>
+#include "collision.h"
+#include "thermal_bias.h"
+
+// 传感器任务采样周期（MPU6050 数字低通 44 Hz，输出率 1 kHz）
+static constexpr uint32_t MPU_SAMPLE_PERIOD_MS = 2;
 
 struct MpuState
 {
   float roll;
   float pitch;
   float yaw;
+  float yawRate; // 偏航角速度（°/s，已扣除零偏）
   float velocityX;
   float velocityY;
 };
 
+// 最近一次样本：扣除静态零偏的加速度（m/s²）与扣除在线零偏的角速度（°/s），供振动分析使用
+struct MpuSample
+{
+  float accel[3];
+  float gyro[3];
+  float temperatureC; // 芯片温度
+};
+
+// 传感器任务逐个样本入队，loop 按真实采样时刻取用（振动频谱需要均匀的 500 Hz 序列，
+// 而 loop 每次只能看到最新快照，间隔随显示刷新与测距抖动）
+static constexpr size_t MPU_SAMPLE_QUEUE_SIZE = 64; // 约 128 ms，覆盖一次整屏刷新
+
+struct MpuQueuedSample
+{
+  uint32_t micros; // 采样时刻
+  MpuSample sample;
+};
+
+// 静止检测与漂移指标
+struct MpuDriftMetrics
+{
+  bool stationary;
+  uint32_t zuptCount;           // 零速更新次数
+  float gyroBiasZ;              // 当前 Z 轴零偏（°/s）
+  float headingDriftDegPerMin;  // 使用在线零偏时的航向漂移
+  float bootBiasDriftDegPerMin; // 仅用开机零偏时的航向漂移（对照）
+  float lastVelocityDrift;      // 最近一次零速更新清除的速度（m/s）
+  float maxVelocityDrift;
+  float uncompensatedDriftDegPerMin; // 同一时刻若不用温度-零偏模型的航向漂移（对照）
+  float temperatureC;           // 平滑后的芯片温度
+  float thermalShiftZ;          // 模型对 Z 轴零偏的当前修正（°/s）
+  uint8_t thermalBins;          // 模型中有数据的温度表点数
+  uint32_t thermalSamples;      // 模型累计学习的样本数
+};
+
+// 载入保存的温度-零偏模型，须在 mpuInit 之前调用；版本不符时返回 false，模型从空开始
+bool mpuSetThermalTable(const ThermalBiasTable &table);
+// 取传感器任务最近发布（约每秒一次）的模型副本，用于保存到闪存；尚未发布时返回 false
+bool mpuGetThermalTable(ThermalBiasTable *out);
+
+// 初始化并校准（约 10 s），可在独立任务中调用
 bool mpuInit(uint8_t sdaPin, uint8_t sclPin);
-void mpuUpdate(float deltaTime);
+// 校准进度 0~100，可在其他任务中读取
+uint8_t mpuCalibrationPercent();
+// 启动传感器任务：按固定周期读取并融合每个样本，并在同一任务中运行碰撞检测，
+// 检测到碰撞或堵转时直接通过电机层刹车（不经过 loop）。初始化失败时也应启动，以便恢复后继续采样
+bool mpuStartTask();
+
+// 取一份状态快照供本次 loop 使用；自上次调用以来没有新的有效样本（读失败、NaN、冻结）时返回 false
+bool mpuFetch();
+
+// 按时间顺序取出至多 maxCount 个排队的有效样本，返回取出的个数
+size_t mpuTakeSamples(MpuQueuedSample *out, size_t maxCount);
+// 队列满时丢弃的样本数（loop 长时间阻塞）
+uint32_t mpuDroppedSamples();
+
+// 取出传感器任务检测到的碰撞/堵转事件（取后清除）
+CollisionKind mpuTakeCollision();
+
+// 重新配置传感器（不重新校准），用于故障后恢复；任务运行时由任务在下个周期执行
+bool mpuRecover();
+
+// 以下返回最近一次 mpuFetch 的快照
 const MpuState &mpuGetState();
+const MpuSample &mpuGetSample();
+MpuDriftMetrics mpuGetDriftMetrics();
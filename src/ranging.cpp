@@ -0,0 +1,88 @@
+#include "ranging.h"
+
+static RangingMetrics metrics = {};
+static bool hasSample = false;
+static bool hasValid = false;
+static uint32_t lastSampleMs = 0;
+static uint32_t lastValidMs = 0;
+
+uint32_t rangingIntervalMs(int speedAbs, float lastDistanceCm)
+{
+    if (speedAbs <= 0)
+    {
+        return RANGING_IDLE_INTERVAL_MS;
+    }
+    if (lastDistanceCm >= 0.0f && lastDistanceCm < RANGING_NEAR_DISTANCE_CM)
+    {
+        return RANGING_MIN_INTERVAL_MS;
+    }
+
+    // 按估计车速换算：每次测距之间最多行驶 RANGING_TRAVEL_PER_SAMPLE_CM
+    const float speedCmPerS = RANGING_FULL_SPEED_CM_PER_S * (speedAbs > 255 ? 255 : speedAbs) / 255.0f;
+    const float intervalMs = RANGING_TRAVEL_PER_SAMPLE_CM / speedCmPerS * 1000.0f;
+    if (intervalMs <= RANGING_MIN_INTERVAL_MS)
+    {
+        return RANGING_MIN_INTERVAL_MS;
+    }
+    if (intervalMs >= RANGING_MAX_MOVING_INTERVAL_MS)
+    {
+        return RANGING_MAX_MOVING_INTERVAL_MS;
+    }
+    return static_cast<uint32_t>(intervalMs);
+}
+
+bool rangingDue(uint32_t nowMs, int speedAbs, float lastDistanceCm)
+{
+    metrics.targetIntervalMs = rangingIntervalMs(speedAbs, lastDistanceCm);
+    return !hasSample || nowMs - lastSampleMs >= metrics.targetIntervalMs;
+}
+
+void rangingRecord(uint32_t nowMs, bool valid)
+{
+    if (hasSample)
+    {
+        metrics.lastIntervalMs = nowMs - lastSampleMs;
+        if (metrics.samples == 1)
+        {
+            metrics.meanIntervalMs = static_cast<float>(metrics.lastIntervalMs);
+        }
+        else
+        {
+            metrics.meanIntervalMs += (metrics.lastIntervalMs - metrics.meanIntervalMs) * 0.1f;
+        }
+    }
+    hasSample = true;
+    lastSampleMs = nowMs;
+    ++metrics.samples;
+
+    if (!valid)
+    {
+        ++metrics.timeouts;
+        return;
+    }
+    if (hasValid && nowMs - lastValidMs > metrics.maxStalenessMs)
+    {
+        metrics.maxStalenessMs = nowMs - lastValidMs;
+    }
+    hasValid = true;
+    lastValidMs = nowMs;
+}
+
+void rangingReset()
+{
+    metrics = {};
+    hasSample = false;
+    hasValid = false;
+    lastSampleMs = 0;
+    lastValidMs = 0;
+}
+
+uint32_t rangingStalenessMs(uint32_t nowMs)
+{
+    return hasValid ? nowMs - lastValidMs : UINT32_MAX;
+}
+
+const RangingMetrics &rangingGetMetrics()
+{
+    return metrics;
+}
@@ -0,0 +1,44 @@
+#pragma once
+#include <stdint.h>
+
+// 测距调度：与显示刷新解耦，按当前电机命令与上次距离自适应调整测距间隔。
+// 纯逻辑模块（不依赖 Arduino），时间由调用方传入，便于主机端仿真。
+
+// HC-SR04 两次测量之间至少间隔 60 ms，避免上一次回波干扰
+static constexpr uint32_t RANGING_MIN_INTERVAL_MS = 60;
+// 行驶中的最长间隔
+static constexpr uint32_t RANGING_MAX_MOVING_INTERVAL_MS = 200;
+// 电机停止时低频测距，仅用于显示
+static constexpr uint32_t RANGING_IDLE_INTERVAL_MS = 1000;
+// 距离低于该值时按传感器极限频率测距
+static constexpr float RANGING_NEAR_DISTANCE_CM = 60.0f;
+// 满占空比（255）时的估计车速与两次测距之间允许行驶的距离
+static constexpr float RANGING_FULL_SPEED_CM_PER_S = 100.0f;
+static constexpr float RANGING_TRAVEL_PER_SAMPLE_CM = 5.0f;
+
+struct RangingMetrics
+{
+    uint32_t samples;          // 测距次数（含超时）
+    uint32_t timeouts;         // 超时/无回波次数
+    uint32_t lastIntervalMs;   // 最近两次测距的实际间隔
+    float meanIntervalMs;      // 实际间隔的指数平均
+    uint32_t targetIntervalMs; // 当前策略给出的间隔
+    uint32_t maxStalenessMs;   // 有效距离的最大陈旧时间
+};
+
+// 测距间隔策略：speedAbs 为两路电机命令绝对值的最大值（0~255），lastDistanceCm < 0 表示未知
+uint32_t rangingIntervalMs(int speedAbs, float lastDistanceCm);
+
+// 判断本次是否应测距
+bool rangingDue(uint32_t nowMs, int speedAbs, float lastDistanceCm);
+
+// 记录一次测距结果（valid=false 表示超时）
+void rangingRecord(uint32_t nowMs, bool valid);
+
+// 清除调度状态与统计，回到从未测距的状态
+void rangingReset();
+
+// 距最近一次有效距离的时间，从未成功时返回 UINT32_MAX
+uint32_t rangingStalenessMs(uint32_t nowMs);
+
+const RangingMetrics &rangingGetMetrics();
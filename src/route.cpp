@@ -0,0 +1,334 @@
+#include "route.h"
+#include "inputlog_codec.h"
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+// 单条记录最大长度：5 个最长 5 字节的变长整数
+static constexpr size_t MAX_RECORD_SIZE = 25;
+
+static uint8_t buffer[ROUTE_CAPACITY];
+static size_t used = 0;
+static RouteMetrics metrics = {};
+static RouteConfig config = ROUTE_DEFAULT_CONFIG;
+
+// 录制状态：最后写入的量化值
+static bool recording = false;
+static bool hasWritten = false;
+static uint32_t recordStartMs = 0;
+static float recordStartYaw = 0.0f;
+static float recordStartDistance = 0.0f;
+static uint32_t lastWrittenMs = 0;
+static int lastSpeedA = 0;
+static int lastSpeedB = 0;
+static int32_t lastYawTenths = 0;
+static int32_t lastDistanceCm = 0;
+
+// 复现状态
+static bool playing = false;
+static bool paused = false;
+static size_t playPos = 0;
+static bool hasNext = false;
+static RoutePoint current = {};
+static RoutePoint next = {};
+static uint32_t playMs = 0;
+static uint32_t lastUpdateMs = 0;
+static float playStartYaw = 0.0f;
+static float playStartDistance = 0.0f;
+
+static uint32_t zigzag(int32_t value)
+{
+    return (static_cast<uint32_t>(value) << 1) ^ static_cast<uint32_t>(value >> 31);
+}
+
+static int32_t unzigzag(uint32_t value)
+{
+    return static_cast<int32_t>(value >> 1) ^ -static_cast<int32_t>(value & 1);
+}
+
+static int clampSpeed(int speed)
+{
+    return speed > 255 ? 255 : (speed < -255 ? -255 : speed);
+}
+
+// 就近取 ROUTE_SPEED_STEP 的整数倍；非零命令至少保留一步，停车与起步始终能被区分。
+// 与上次写入值同向且相差不到一步时沿用上次的值，在量化边界附近抖动的命令不会来回切换
+static int quantizeSpeed(int speed, int last)
+{
+    if (speed == 0)
+    {
+        return 0;
+    }
+    if (hasWritten && last != 0 && (speed > 0) == (last > 0) && abs(speed - last) < ROUTE_SPEED_STEP)
+    {
+        return last;
+    }
+    const int magnitude = (abs(clampSpeed(speed)) + ROUTE_SPEED_STEP / 2) / ROUTE_SPEED_STEP * ROUTE_SPEED_STEP;
+    const int quantized = magnitude < ROUTE_SPEED_STEP ? ROUTE_SPEED_STEP : (magnitude > 255 ? 255 : magnitude);
+    return speed < 0 ? -quantized : quantized;
+}
+
+static void appendRecord(uint32_t nowMs, int speedA, int speedB, float yaw, float distanceM)
+{
+    const uint32_t timeMs = nowMs - recordStartMs;
+    const int32_t yawTenths = static_cast<int32_t>(lroundf((yaw - recordStartYaw) * 10.0f));
+    const int32_t distanceCm = static_cast<int32_t>(lroundf((distanceM - recordStartDistance) * 100.0f));
+
+    uint8_t *p = buffer + used;
+    size_t n = inputLogPutVarint(p, hasWritten ? nowMs - lastWrittenMs : timeMs);
+    n += inputLogPutVarint(p + n, zigzag(speedA - lastSpeedA));
+    n += inputLogPutVarint(p + n, zigzag(speedB - lastSpeedB));
+    n += inputLogPutVarint(p + n, zigzag(yawTenths - lastYawTenths));
+    n += inputLogPutVarint(p + n, zigzag(distanceCm - lastDistanceCm));
+    used += n;
+
+    hasWritten = true;
+    lastWrittenMs = nowMs;
+    lastSpeedA = speedA;
+    lastSpeedB = speedB;
+    lastYawTenths = yawTenths;
+    lastDistanceCm = distanceCm;
+
+    ++metrics.points;
+    metrics.bytes = used;
+    metrics.durationMs = timeMs;
+    metrics.distanceM = distanceCm / 100.0f;
+}
+
+void routeRecordBegin(uint32_t nowMs, float yaw, float distanceM)
+{
+    routePlaybackStop();
+    buffer[0] = 'R';
+    buffer[1] = 'T';
+    buffer[2] = ROUTE_FORMAT_VERSION;
+    buffer[3] = 0;
+    used = ROUTE_HEADER_SIZE;
+    metrics = {};
+    metrics.bytes = used;
+
+    recording = true;
+    hasWritten = false;
+    recordStartMs = nowMs;
+    recordStartYaw = yaw;
+    recordStartDistance = distanceM;
+    lastSpeedA = 0;
+    lastSpeedB = 0;
+    lastYawTenths = 0;
+    lastDistanceCm = 0;
+}
+
+bool routeRecordSample(uint32_t nowMs, int speedA, int speedB, float yaw, float distanceM)
+{
+    if (!recording)
+    {
+        return false;
+    }
+    speedA = quantizeSpeed(speedA, lastSpeedA);
+    speedB = quantizeSpeed(speedB, lastSpeedB);
+    const bool changed = !hasWritten || speedA != lastSpeedA || speedB != lastSpeedB;
+    // 停车时不记录位姿，时间差留给下一条记录
+    const bool stopped = speedA == 0 && speedB == 0;
+    if (!changed && (stopped || nowMs - lastWrittenMs < ROUTE_POSE_INTERVAL_MS))
+    {
+        return true;
+    }
+    // 始终为结束时的停车记录留出空间
+    if (used + 2 * MAX_RECORD_SIZE > ROUTE_CAPACITY)
+    {
+        metrics.truncated = true;
+        routeRecordEnd(nowMs, yaw, distanceM);
+        return false;
+    }
+    appendRecord(nowMs, speedA, speedB, yaw, distanceM);
+    return true;
+}
+
+void routeRecordEnd(uint32_t nowMs, float yaw, float distanceM)
+{
+    if (!recording)
+    {
+        return;
+    }
+    appendRecord(nowMs, 0, 0, yaw, distanceM);
+    recording = false;
+}
+
+bool routeRecording()
+{
+    return recording;
+}
+
+const uint8_t *routeData()
+{
+    return buffer;
+}
+
+size_t routeSize()
+{
+    return recording ? 0 : used;
+}
+
+bool routeDecodeNext(const uint8_t *data, size_t size, size_t *pos, RoutePoint *point)
+{
+    uint32_t fields[5];
+    size_t p = *pos;
+    for (uint32_t &field : fields)
+    {
+        const size_t n = p < size ? inputLogGetVarint(data + p, size - p, &field) : 0;
+        if (n == 0)
+        {
+            return false;
+        }
+        p += n;
+    }
+    *pos = p;
+    point->timeMs += fields[0];
+    point->speedA += unzigzag(fields[1]);
+    point->speedB += unzigzag(fields[2]);
+    point->yawDeg += unzigzag(fields[3]) / 10.0f;
+    point->distanceM += unzigzag(fields[4]) / 100.0f;
+    return true;
+}
+
+bool routeLoad(const uint8_t *data, size_t size)
+{
+    if (size < ROUTE_HEADER_SIZE || size > ROUTE_CAPACITY || data[0] != 'R' || data[1] != 'T' ||
+        data[2] != ROUTE_FORMAT_VERSION)
+    {
+        return false;
+    }
+    size_t pos = ROUTE_HEADER_SIZE;
+    RoutePoint point = {};
+    uint32_t points = 0;
+    while (routeDecodeNext(data, size, &pos, &point))
+    {
+        ++points;
+    }
+    if (pos != size || points == 0)
+    {
+        return false;
+    }
+
+    routePlaybackStop();
+    recording = false;
+    memcpy(buffer, data, size);
+    used = size;
+    metrics = {};
+    metrics.bytes = size;
+    metrics.points = points;
+    metrics.durationMs = point.timeMs;
+    metrics.distanceM = point.distanceM;
+    return true;
+}
+
+void routeConfigure(const RouteConfig &newConfig)
+{
+    config = newConfig;
+}
+
+const RouteConfig &routeGetConfig()
+{
+    return config;
+}
+
+bool routePlaybackBegin(uint32_t nowMs, float yaw, float distanceM)
+{
+    if (recording || metrics.points == 0)
+    {
+        return false;
+    }
+    playPos = ROUTE_HEADER_SIZE;
+    current = {};
+    next = {};
+    hasNext = routeDecodeNext(buffer, used, &playPos, &next);
+    playing = true;
+    paused = false;
+    playMs = 0;
+    lastUpdateMs = nowMs;
+    playStartYaw = yaw;
+    playStartDistance = distanceM;
+    metrics.lastHeadingErrorDeg = 0.0f;
+    metrics.maxHeadingErrorDeg = 0.0f;
+    metrics.pauses = 0;
+    metrics.pausedMs = 0;
+    metrics.distanceErrorM = 0.0f;
+    return true;
+}
+
+RouteOutput routePlaybackUpdate(const RouteInput &in)
+{
+    RouteOutput out = {0, 0, false, false};
+    if (!playing)
+    {
+        out.done = true;
+        return out;
+    }
+    const uint32_t dt = in.nowMs - lastUpdateMs;
+    lastUpdateMs = in.nowMs;
+
+    if (in.blocked)
+    {
+        if (!paused)
+        {
+            paused = true;
+            ++metrics.pauses;
+        }
+        metrics.pausedMs += dt;
+        out.paused = true;
+        return out;
+    }
+    paused = false;
+    playMs += dt;
+
+    // next 在解码时以 current 为基准累加，因此推进前先让两者相同
+    while (hasNext && playMs >= next.timeMs)
+    {
+        current = next;
+        hasNext = routeDecodeNext(buffer, used, &playPos, &next);
+    }
+    if (!hasNext)
+    {
+        playing = false;
+        metrics.distanceErrorM = (in.distanceM - playStartDistance) - current.distanceM;
+        out.done = true;
+        return out;
+    }
+
+    // 在相邻两条记录之间线性插值目标偏航
+    const float span = static_cast<float>(next.timeMs - current.timeMs);
+    const float fraction = span > 0.0f ? (playMs - current.timeMs) / span : 0.0f;
+    const float targetYaw = current.yawDeg + (next.yawDeg - current.yawDeg) * fraction;
+
+    out.speedA = current.speedA;
+    out.speedB = current.speedB;
+    if (in.yawValid && (current.speedA != 0 || current.speedB != 0))
+    {
+        const float error = targetYaw - (in.yaw - playStartYaw);
+        const float limit = static_cast<float>(config.maxCorrection);
+        const float turn = fmaxf(-limit, fminf(limit, error * config.headingGain * config.yawPerRightTurn));
+        out.speedA = clampSpeed(current.speedA + static_cast<int>(turn));
+        out.speedB = clampSpeed(current.speedB - static_cast<int>(turn));
+        metrics.lastHeadingErrorDeg = error;
+        if (fabsf(error) > metrics.maxHeadingErrorDeg)
+        {
+            metrics.maxHeadingErrorDeg = fabsf(error);
+        }
+    }
+    return out;
+}
+
+void routePlaybackStop()
+{
+    playing = false;
+    paused = false;
+}
+
+bool routePlaying()
+{
+    return playing;
+}
+
+const RouteMetrics &routeGetMetrics()
+{
+    return metrics;
+}
@@ -0,0 +1,101 @@
+#pragma once
+#include <stddef.h>
+#include <stdint.h>
+
+// 示教-复现：把一次驾驶（按键或串口遥控）录制为带时间戳的电机命令与位姿（陀螺偏航、行驶距离）流，
+// 差分 + 变长整数编码进固定大小的缓冲，可保存到闪存。复现时按录制的时间轴重放电机命令，
+// 以录制的偏航角为目标做差速航向修正；前方受阻时暂停时间轴，清除后从原处继续。
+// 纯逻辑模块（不依赖 Arduino），时间与传感器值由调用方传入，便于主机端测试。
+//
+// 编码格式：
+//   头部：'R' 'T' 版本号 0
+//   记录：varint(距上一记录的毫秒) zigzag(A 速度差) zigzag(B 速度差) zigzag(偏航差，0.1°) zigzag(距离差，cm)
+// 偏航与距离都相对录制开始时的位姿，只在命令变化或每隔 ROUTE_POSE_INTERVAL_MS 记录一条。
+// 命令先按 ROUTE_SPEED_STEP 量化并带一步的回差：限速器逐周期微调的速度不会每次都产生一条记录。
+
+#ifndef ROUTE_CAPACITY
+#define ROUTE_CAPACITY 4096u
+#endif
+
+static constexpr uint8_t ROUTE_FORMAT_VERSION = 1;
+static constexpr size_t ROUTE_HEADER_SIZE = 4;
+static constexpr uint32_t ROUTE_POSE_INTERVAL_MS = 250; // 命令不变时的位姿采样间隔
+static constexpr int ROUTE_SPEED_STEP = 16;             // 录制命令的量化步长（非零命令不会量化为 0）
+
+struct RoutePoint
+{
+    uint32_t timeMs; // 相对录制开始
+    int speedA;
+    int speedB;
+    float yawDeg;    // 相对录制开始
+    float distanceM;
+};
+
+struct RouteConfig
+{
+    float headingGain;     // 每度航向误差的差速修正量
+    float yawPerRightTurn; // 右转（turn > 0）时偏航的变化方向：Z 轴朝上为 -1，传感器倒装时取 +1
+    int maxCorrection;     // 差速修正上限
+};
+
+static constexpr RouteConfig ROUTE_DEFAULT_CONFIG = {4.0f, -1.0f, 60};
+
+struct RouteInput
+{
+    uint32_t nowMs;
+    float yaw;       // °
+    bool yawValid;   // IMU 降级时不做航向修正
+    float distanceM; // 累计行驶距离
+    bool blocked;    // 前方受阻（由调用方按避障距离判定）：输出 0 并暂停时间轴
+};
+
+struct RouteOutput
+{
+    int speedA;
+    int speedB;
+    bool paused; // 前方受阻，时间轴暂停
+    bool done;   // 已走完全程（本次输出为 0）
+};
+
+struct RouteMetrics
+{
+    size_t bytes;
+    uint32_t points;
+    uint32_t durationMs;
+    float distanceM;           // 录制的行驶距离
+    bool truncated;            // 缓冲写满提前结束录制
+    float lastHeadingErrorDeg; // 复现中行驶时的航向误差
+    float maxHeadingErrorDeg;
+    uint32_t pauses;
+    uint32_t pausedMs;
+    float distanceErrorM;      // 复现结束时实际距离与录制距离之差
+};
+
+// ---- 录制 ----
+void routeRecordBegin(uint32_t nowMs, float yaw, float distanceM);
+// 每次 loop 调用；缓冲将满时写入停车记录并结束录制，返回 false
+bool routeRecordSample(uint32_t nowMs, int speedA, int speedB, float yaw, float distanceM);
+// 追加一条停车记录并结束录制
+void routeRecordEnd(uint32_t nowMs, float yaw, float distanceM);
+bool routeRecording();
+
+// ---- 路线数据（录制结果或载入的路线） ----
+const uint8_t *routeData();
+size_t routeSize();
+// 校验头部与全部记录后复制到内部缓冲
+bool routeLoad(const uint8_t *data, size_t size);
+
+// 逐条解码：pos 从 ROUTE_HEADER_SIZE 开始、point 初始为全零，每次在 point 上累加一条记录；
+// 没有更多记录或数据损坏时返回 false
+bool routeDecodeNext(const uint8_t *data, size_t size, size_t *pos, RoutePoint *point);
+
+// ---- 复现 ----
+void routeConfigure(const RouteConfig &config);
+const RouteConfig &routeGetConfig();
+// 没有可复现的路线时返回 false
+bool routePlaybackBegin(uint32_t nowMs, float yaw, float distanceM);
+RouteOutput routePlaybackUpdate(const RouteInput &in);
+void routePlaybackStop();
+bool routePlaying();
+
+const RouteMetrics &routeGetMetrics();
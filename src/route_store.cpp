@@ -0,0 +1,38 @@
+#include <Arduino.h>
+#include <Preferences.h>
+#include "route_store.h"
+#include "route.h"
+
+static const char *const NAMESPACE = "route";
+static const char *const KEY = "data";
+
+bool routeStoreSave()
+{
+    const size_t size = routeSize();
+    if (size == 0)
+    {
+        return false;
+    }
+    Preferences prefs;
+    if (!prefs.begin(NAMESPACE, false))
+    {
+        return false;
+    }
+    const bool ok = prefs.putBytes(KEY, routeData(), size) == size;
+    prefs.end();
+    return ok;
+}
+
+bool routeStoreLoad()
+{
+    Preferences prefs;
+    if (!prefs.begin(NAMESPACE, true))
+    {
+        return false;
+    }
+    // 只在载入时使用的暂存区，放在静态区避免占用 loop 栈
+    static uint8_t scratch[ROUTE_CAPACITY];
+    const size_t size = prefs.getBytes(KEY, scratch, sizeof(scratch));
+    prefs.end();
+    return size > 0 && routeLoad(scratch, size);
+}
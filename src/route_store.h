@@ -0,0 +1,7 @@
+#pragma once
+#include <stddef.h>
+
+// 路线的闪存存储（NVS，命名空间 "route"），断电后保留最近一次保存的路线
+bool routeStoreSave();
+// 载入闪存中的路线到 route 模块，没有或校验失败时返回 false
+bool routeStoreLoad();
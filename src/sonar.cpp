@@ -0,0 +1,152 @@
+#include "sonar.h"
+#include <math.h>
+
+static float readings[SONAR_MAX_PINGS];
+static size_t count = 0;
+static bool active = false;
+static uint32_t startMs = 0;
+static uint32_t lastPingMs = 0;
+static SonarMetrics metrics = {};
+
+float sonarSpeedOfSound(float temperatureC)
+{
+    const float t = temperatureC < -20.0f ? -20.0f : (temperatureC > 60.0f ? 60.0f : temperatureC);
+    return 331.3f + 0.606f * t;
+}
+
+float sonarEchoToCm(uint32_t echoUs, float temperatureC)
+{
+    // 往返时间 × 声速 / 2，us·m/s 换算为 cm
+    return echoUs * sonarSpeedOfSound(temperatureC) / 20000.0f;
+}
+
+void sonarBurstBegin(uint32_t nowMs)
+{
+    active = true;
+    count = 0;
+    startMs = nowMs;
+    lastPingMs = nowMs;
+    ++metrics.bursts;
+}
+
+bool sonarBurstActive()
+{
+    return active;
+}
+
+bool sonarPingDue(uint32_t nowMs)
+{
+    return active && nowMs - lastPingMs >= SONAR_PING_GAP_MS;
+}
+
+void sonarBurstAbort()
+{
+    active = false;
+    count = 0;
+}
+
+// 无回波视为无穷远，参与排序与一致性判断
+static float key(float cm)
+{
+    return cm < 0.0f ? INFINITY : cm;
+}
+
+static float tolerance(float cm)
+{
+    return SONAR_AGREE_CM + SONAR_AGREE_RATIO * cm;
+}
+
+static bool agree(float a, float b)
+{
+    if (isinf(a) || isinf(b))
+    {
+        return isinf(a) && isinf(b);
+    }
+    return fabsf(a - b) <= tolerance(fminf(a, b));
+}
+
+static void finish(uint32_t nowMs, SonarResult *out)
+{
+    float sorted[SONAR_MAX_PINGS] = {};
+    for (size_t i = 0; i < count; ++i)
+    {
+        const float value = key(readings[i]);
+        size_t j = i;
+        for (; j > 0 && sorted[j - 1] > value; --j)
+        {
+            sorted[j] = sorted[j - 1];
+        }
+        sorted[j] = value;
+    }
+    const float low = sorted[(count - 1) / 2];
+    const float high = sorted[count / 2];
+    const float median = isinf(high) ? high : (low + high) * 0.5f;
+
+    // 置信度：与中位数一致的读数比例，再按其离散程度（相对容差）最多扣 50%；
+    // 三次中两次一致时不低于 0.5，三次互不一致时不超过 1/3
+    size_t inliers = 0;
+    float minInlier = INFINITY;
+    float maxInlier = -INFINITY;
+    for (size_t i = 0; i < count; ++i)
+    {
+        if (agree(sorted[i], median))
+        {
+            ++inliers;
+            minInlier = fminf(minInlier, sorted[i]);
+            maxInlier = fmaxf(maxInlier, sorted[i]);
+        }
+    }
+    float tightness = 1.0f;
+    if (!isinf(median) && inliers > 0)
+    {
+        tightness = 1.0f - fminf((maxInlier - minInlier) / (4.0f * tolerance(median)), 0.5f);
+    }
+
+    out->distanceCm = isinf(median) ? -1.0f : median;
+    out->confidence = static_cast<float>(inliers) / count * tightness;
+    out->pings = static_cast<uint8_t>(count);
+    out->latencyMs = nowMs - startMs;
+
+    metrics.outliers += static_cast<uint32_t>(count - inliers);
+    metrics.lastLatencyMs = out->latencyMs;
+    if (out->latencyMs > metrics.maxLatencyMs)
+    {
+        metrics.maxLatencyMs = out->latencyMs;
+    }
+    if (out->confidence < SONAR_MIN_CONFIDENCE)
+    {
+        ++metrics.lowConfidence;
+    }
+    active = false;
+    count = 0;
+}
+
+bool sonarBurstAdd(uint32_t nowMs, float cm, SonarResult *out)
+{
+    if (!active)
+    {
+        return false;
+    }
+    readings[count++] = cm;
+    lastPingMs = nowMs;
+    ++metrics.pings;
+
+    // 前两次一致即可给出结果，只有不一致时才多测一次
+    if (count == 2 && agree(key(readings[0]), key(readings[1])))
+    {
+        ++metrics.earlyStops;
+        finish(nowMs, out);
+        return true;
+    }
+    if (count == SONAR_MAX_PINGS)
+    {
+        finish(nowMs, out);
+        return true;
+    }
+    return false;
+}
+
+const SonarMetrics &sonarGetMetrics()
+{
+    return metrics;
+}
@@ -0,0 +1,58 @@
+#pragma once
+#include <stddef.h>
+#include <stdint.h>
+
+// 超声波测距的计算部分：
+//   声速按气温修正：c = 331.3 + 0.606·T（m/s），0~40 °C 之间相差约 7%，固定按 343 m/s 换算会随季节与车内温升偏差数厘米；
+//   每次测距改为一组间隔固定的连续测量：前两次一致即提前结束，否则再测一次取中位数，
+//   并按与中位数一致的读数比例及其离散程度给出置信度。单次杂散回波（多径、地面反射）或漏检不再直接触发避障。
+// 纯逻辑模块（不依赖 Arduino），时间由调用方传入，便于主机端用带噪声的回波模型评估。
+
+static constexpr float SONAR_DEFAULT_TEMPERATURE_C = 20.0f; // 没有温度读数时使用
+static constexpr float SONAR_IMU_DIE_OFFSET_C = 3.0f;       // MPU6050 芯片自热，读数比气温高（估计值）
+// 组内两次测量的间隔：HC-SR04 的测量周期至少 60 ms（与 RANGING_MIN_INTERVAL_MS 相同），
+// 更短时上一次发出的声波经远处墙面反射后仍可能落入下一次的回波窗口；两次一致的组延迟因此为 60 ms
+static constexpr uint32_t SONAR_PING_GAP_MS = 60;
+static constexpr size_t SONAR_MAX_PINGS = 3;
+// 两次读数视为一致的容差：固定部分加按距离的比例
+static constexpr float SONAR_AGREE_CM = 3.0f;
+static constexpr float SONAR_AGREE_RATIO = 0.05f;
+// 置信度低于该值的结果不用于避障与调速
+static constexpr float SONAR_MIN_CONFIDENCE = 0.5f;
+
+struct SonarResult
+{
+    float distanceCm;   // 一致读数的中位数（cm）；多数读数无回波时为 -1
+    float confidence;   // 0~1
+    uint8_t pings;      // 本组测量次数
+    uint32_t latencyMs; // 从第一次测量到给出结果
+};
+
+struct SonarMetrics
+{
+    uint32_t bursts;
+    uint32_t pings;
+    uint32_t outliers;      // 与中位数不一致而被剔除的读数
+    uint32_t earlyStops;    // 前两次一致提前结束的组
+    uint32_t lowConfidence; // 置信度低于 SONAR_MIN_CONFIDENCE 的组
+    uint32_t lastLatencyMs; // 最近一组从第一次测量到给出结果
+    uint32_t maxLatencyMs;
+};
+
+// 声速（m/s），温度超出 -20~60 °C 时按边界计算
+float sonarSpeedOfSound(float temperatureC);
+
+// 回波高电平时长（往返，us）换算为距离（cm）
+float sonarEchoToCm(uint32_t echoUs, float temperatureC);
+
+// 开始一组测量，第一次测量应立即进行
+void sonarBurstBegin(uint32_t nowMs);
+bool sonarBurstActive();
+// 组内下一次测量是否到时间
+bool sonarPingDue(uint32_t nowMs);
+// 加入一次读数（cm，负数表示无回波），本组结束时写入 out 并返回 true
+bool sonarBurstAdd(uint32_t nowMs, float cm, SonarResult *out);
+// 模块无响应等情况下放弃本组
+void sonarBurstAbort();
+
+const SonarMetrics &sonarGetMetrics();
@@ -0,0 +1,314 @@
+#include "spectrum.h"
+#include <math.h>
+#include <string.h>
+
+// 有 esp-dsp 时复数 FFT 使用其 SIMD 内核（S3 上为 aes3 实现），否则使用下面的可移植实现；
+// 定义 SPECTRUM_PORTABLE_FFT 可强制使用可移植实现以便对照
+#if !defined(SPECTRUM_PORTABLE_FFT) && defined(__has_include)
+#if __has_include("esp_dsp.h")
+#include "esp_dsp.h"
+#define SPECTRUM_USE_ESP_DSP 1
+#endif
+#endif
+
+static_assert((SPECTRUM_WINDOW & (SPECTRUM_WINDOW - 1)) == 0, "SPECTRUM_WINDOW 必须是 2 的幂");
+
+// N 点实数序列按 N/2 点复数序列做 FFT，再拆分出实数谱
+static constexpr size_t HALF = SPECTRUM_WINDOW / 2;
+static constexpr size_t BINS = HALF + 1;
+static const float BAND_LOW_HZ[SPECTRUM_BANDS] = {0.5f, 5.0f, 15.0f, 30.0f};
+
+// 计算用的热数据放在内部 SRAM，采样窗口放在调用方提供的缓冲中
+static float hann[SPECTRUM_WINDOW];
+static float hannPower = 0.0f; // Σw²，用于把功率谱归一化为均方值
+static float twiddleCos[HALF]; // e^{-2πik/N} 的实部
+static float twiddleSin[HALF]; // e^{-2πik/N} 的虚部
+alignas(16) static float work[SPECTRUM_WINDOW];
+static float power[BINS];
+static bool tablesReady = false;
+static bool simdReady = false;
+
+static float *buffers[2] = {nullptr, nullptr};
+static size_t fillBuffer = 0;
+static size_t fillCount = 0;
+static uint32_t fillStartMicros = 0;
+static int computeBuffer = -1; // 待算窗口所在缓冲，-1 表示空闲
+static size_t computeChannel = 0;
+static float computeRateHz = 0.0f;
+static uint32_t windowCpuAccumUs = 0;
+
+static SpectrumResult pending[SPECTRUM_CHANNELS];
+static SpectrumResult results[SPECTRUM_CHANNELS];
+static SpectrumMetrics metrics = {};
+
+static void initTables()
+{
+    hannPower = 0.0f;
+    for (size_t i = 0; i < SPECTRUM_WINDOW; ++i)
+    {
+        hann[i] = static_cast<float>(0.5 - 0.5 * cos(2.0 * M_PI * i / SPECTRUM_WINDOW));
+        hannPower += hann[i] * hann[i];
+    }
+    for (size_t k = 0; k < HALF; ++k)
+    {
+        twiddleCos[k] = static_cast<float>(cos(2.0 * M_PI * k / SPECTRUM_WINDOW));
+        twiddleSin[k] = static_cast<float>(-sin(2.0 * M_PI * k / SPECTRUM_WINDOW));
+    }
+#ifdef SPECTRUM_USE_ESP_DSP
+    simdReady = dsps_fft2r_init_fc32(nullptr, HALF) == ESP_OK;
+#endif
+    metrics.simd = simdReady;
+    tablesReady = true;
+}
+
+// 基 2 迭代复数 FFT，data 为 m 个交织存放的复数（实部、虚部）
+static void fftComplexPortable(float *data, size_t m)
+{
+    for (size_t i = 1, j = 0; i < m; ++i)
+    {
+        size_t bit = m >> 1;
+        for (; j & bit; bit >>= 1)
+        {
+            j ^= bit;
+        }
+        j ^= bit;
+        if (i < j)
+        {
+            const float re = data[2 * i];
+            const float im = data[2 * i + 1];
+            data[2 * i] = data[2 * j];
+            data[2 * i + 1] = data[2 * j + 1];
+            data[2 * j] = re;
+            data[2 * j + 1] = im;
+        }
+    }
+
+    for (size_t len = 2; len <= m; len <<= 1)
+    {
+        const size_t half = len / 2;
+        const size_t stride = SPECTRUM_WINDOW / len; // e^{-2πik/len} = e^{-2πi(k·stride)/N}
+        for (size_t start = 0; start < m; start += len)
+        {
+            for (size_t k = 0; k < half; ++k)
+            {
+                const float wr = twiddleCos[k * stride];
+                const float wi = twiddleSin[k * stride];
+                float *a = data + 2 * (start + k);
+                float *b = data + 2 * (start + k + half);
+                const float tr = b[0] * wr - b[1] * wi;
+                const float ti = b[0] * wi + b[1] * wr;
+                b[0] = a[0] - tr;
+                b[1] = a[1] - ti;
+                a[0] += tr;
+                a[1] += ti;
+            }
+        }
+    }
+}
+
+// work 中为 N 个实数，原地变换后把 N/2+1 个频点的 |X[k]|² 写入 out
+static void realFftPower(float *out)
+{
+#ifdef SPECTRUM_USE_ESP_DSP
+    if (simdReady)
+    {
+        dsps_fft2r_fc32(work, HALF);
+        dsps_bit_rev_fc32(work, HALF);
+    }
+    else
+#endif
+    {
+        fftComplexPortable(work, HALF);
+    }
+
+    // 偶数点为实部、奇数点为虚部的复数序列 z 的频谱 Z，拆分为 X[k] = E[k] + W^k·O[k]
+    for (size_t k = 0; k <= HALF; ++k)
+    {
+        const size_t a = k % HALF;
+        const size_t b = (HALF - k) % HALF;
+        const float zr = work[2 * a];
+        const float zi = work[2 * a + 1];
+        const float cr = work[2 * b];
+        const float ci = -work[2 * b + 1];
+        const float er = 0.5f * (zr + cr);
+        const float ei = 0.5f * (zi + ci);
+        const float or_ = 0.5f * (zi - ci);
+        const float oi = -0.5f * (zr - cr);
+        const float wr = k < HALF ? twiddleCos[k] : -1.0f;
+        const float wi = k < HALF ? twiddleSin[k] : 0.0f;
+        const float xr = er + wr * or_ - wi * oi;
+        const float xi = ei + wr * oi + wi * or_;
+        out[k] = xr * xr + xi * xi;
+    }
+}
+
+void spectrumRealFftPower(const float *in, float *powerOut)
+{
+    if (!tablesReady)
+    {
+        initTables();
+    }
+    memcpy(work, in, sizeof(work));
+    realFftPower(powerOut);
+}
+
+float spectrumBandLowHz(size_t band)
+{
+    return band < SPECTRUM_BANDS ? BAND_LOW_HZ[band] : 0.0f;
+}
+
+bool spectrumInit(float *storage)
+{
+    if (!tablesReady)
+    {
+        initTables();
+    }
+    buffers[0] = storage;
+    buffers[1] = storage != nullptr ? storage + SPECTRUM_CHANNELS * SPECTRUM_WINDOW : nullptr;
+    fillBuffer = 0;
+    fillCount = 0;
+    computeBuffer = -1;
+    return storage != nullptr;
+}
+
+void spectrumPush(uint32_t sampleMicros, const float accel[3], const float gyro[3])
+{
+    if (buffers[0] == nullptr)
+    {
+        return;
+    }
+    float *dst = buffers[fillBuffer];
+    if (fillCount == 0)
+    {
+        fillStartMicros = sampleMicros;
+    }
+    for (size_t axis = 0; axis < 3; ++axis)
+    {
+        dst[axis * SPECTRUM_WINDOW + fillCount] = accel[axis];
+        dst[(axis + 3) * SPECTRUM_WINDOW + fillCount] = gyro[axis];
+    }
+    if (++fillCount < SPECTRUM_WINDOW)
+    {
+        return;
+    }
+
+    fillCount = 0;
+    if (computeBuffer >= 0)
+    {
+        // 上一窗还没算完：丢弃本窗，在同一缓冲中重新采集
+        ++metrics.droppedWindows;
+        return;
+    }
+    const uint32_t spanUs = sampleMicros - fillStartMicros;
+    computeRateHz = spanUs > 0 ? (SPECTRUM_WINDOW - 1) * 1e6f / spanUs : 0.0f;
+    computeBuffer = static_cast<int>(fillBuffer);
+    computeChannel = 0;
+    fillBuffer ^= 1;
+}
+
+static void analyseChannel(const float *samples, float rateHz, SpectrumResult *out)
+{
+    float mean = 0.0f;
+    for (size_t i = 0; i < SPECTRUM_WINDOW; ++i)
+    {
+        mean += samples[i];
+    }
+    mean /= SPECTRUM_WINDOW;
+    for (size_t i = 0; i < SPECTRUM_WINDOW; ++i)
+    {
+        work[i] = (samples[i] - mean) * hann[i];
+    }
+    realFftPower(power);
+
+    // 单边谱归一化为均方值：Σ|X|² / (N·Σw²)，除直流与奈奎斯特点外乘 2
+    const float scale = 1.0f / (SPECTRUM_WINDOW * hannPower);
+    const float binHz = rateHz / SPECTRUM_WINDOW;
+    memset(out, 0, sizeof(*out));
+    float total = 0.0f;
+    size_t peak = 1;
+    for (size_t k = 1; k < BINS; ++k)
+    {
+        power[k] *= (k < HALF ? 2.0f : 1.0f) * scale;
+        total += power[k];
+        if (power[k] > power[peak])
+        {
+            peak = k;
+        }
+        const float hz = k * binHz;
+        for (size_t band = SPECTRUM_BANDS; band-- > 0;)
+        {
+            if (hz >= BAND_LOW_HZ[band])
+            {
+                out->bandEnergy[band] += power[k];
+                break;
+            }
+        }
+    }
+
+    // 抛物线插值估计峰值在两个频点之间的位置
+    float offset = 0.0f;
+    if (peak + 1 < BINS)
+    {
+        const float a = power[peak - 1] * (peak == 1 ? 0.0f : 1.0f);
+        const float b = power[peak];
+        const float c = power[peak + 1];
+        const float denom = a - 2.0f * b + c;
+        if (denom < 0.0f)
+        {
+            offset = 0.5f * (a - c) / denom;
+        }
+    }
+    // 全零输入（例如传感器未就绪）不给出主频
+    out->dominantHz = power[peak] > 0.0f ? (peak + offset) * binHz : 0.0f;
+    out->dominantPower = power[peak];
+    out->rms = sqrtf(total);
+}
+
+bool spectrumStep()
+{
+    if (computeBuffer < 0)
+    {
+        return false;
+    }
+    const float *samples = buffers[computeBuffer] + computeChannel * SPECTRUM_WINDOW;
+    analyseChannel(samples, computeRateHz, &pending[computeChannel]);
+    if (++computeChannel == SPECTRUM_CHANNELS)
+    {
+        memcpy(results, pending, sizeof(results));
+        metrics.sampleRateHz = computeRateHz;
+        ++metrics.windows;
+        computeBuffer = -1;
+    }
+    return true;
+}
+
+void spectrumReportDuration(uint32_t durationUs)
+{
+    metrics.lastStepUs = durationUs;
+    if (durationUs > metrics.maxStepUs)
+    {
+        metrics.maxStepUs = durationUs;
+    }
+    windowCpuAccumUs += durationUs;
+    if (computeBuffer < 0)
+    {
+        metrics.windowCpuUs = windowCpuAccumUs;
+        windowCpuAccumUs = 0;
+    }
+}
+
+const SpectrumResult &spectrumGetResult(SpectrumChannel channel)
+{
+    return results[static_cast<size_t>(channel) < SPECTRUM_CHANNELS ? static_cast<size_t>(channel) : 0];
+}
+
+const SpectrumMetrics &spectrumGetMetrics()
+{
+    return metrics;
+}
+
+const char *spectrumChannelName(SpectrumChannel channel)
+{
+    static const char *const NAMES[SPECTRUM_CHANNELS] = {"Ax", "Ay", "Az", "Gx", "Gy", "Gz"};
+    return static_cast<size_t>(channel) < SPECTRUM_CHANNELS ? NAMES[static_cast<size_t>(channel)] : "?";
+}
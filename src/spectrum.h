@@ -0,0 +1,64 @@
+#pragma once
+#include <stddef.h>
+#include <stdint.h>
+
+// 振动频谱：按 IMU 采样率把加速度与角速度分窗存入（PSRAM）缓冲，去均值加 Hann 窗后做实数 FFT，
+// 输出各频带能量与主频。每次调用只处理一个通道，单窗的计算量固定，不会在某一次 loop 中集中占用 CPU。
+// 纯逻辑模块（不依赖 Arduino），时间由调用方传入；有 esp-dsp 时 FFT 内核使用其 S3 SIMD 优化实现。
+
+static constexpr size_t SPECTRUM_WINDOW = 256; // 每窗采样点数，必须是 2 的幂
+static constexpr size_t SPECTRUM_CHANNELS = 6; // 加速度 XYZ + 角速度 XYZ
+static constexpr size_t SPECTRUM_BANDS = 4;
+// 采样缓冲（双缓冲：一个采集、一个计算），由调用方分配，建议放在 PSRAM
+static constexpr size_t SPECTRUM_STORAGE_BYTES = 2 * SPECTRUM_CHANNELS * SPECTRUM_WINDOW * sizeof(float);
+
+enum class SpectrumChannel : uint8_t
+{
+    AccelX,
+    AccelY,
+    AccelZ,
+    GyroX,
+    GyroY,
+    GyroZ
+};
+
+struct SpectrumResult
+{
+    float dominantHz;                // 主频（抛物线插值）
+    float dominantPower;             // 主频所在频点的均方值
+    float rms;                       // 去均值后的均方根
+    float bandEnergy[SPECTRUM_BANDS]; // 各频带均方值（加速度 (m/s²)²，角速度 (°/s)²）
+};
+
+struct SpectrumMetrics
+{
+    uint32_t windows;        // 已完成的窗口数
+    uint32_t droppedWindows; // 上一窗未算完时新窗已采满，被丢弃的窗口数
+    float sampleRateHz;      // 最近一窗的实测采样率
+    uint32_t lastStepUs;     // 最近一次单通道计算耗时
+    uint32_t maxStepUs;
+    uint32_t windowCpuUs;    // 最近一窗全部通道的计算耗时
+    bool simd;               // 是否使用 esp-dsp 内核
+};
+
+// 频带边界（Hz），最后一个频带到奈奎斯特频率为止
+float spectrumBandLowHz(size_t band);
+
+// storage 至少 SPECTRUM_STORAGE_BYTES 字节；传入 nullptr 时频谱分析停用
+bool spectrumInit(float *storage);
+
+// 追加一个样本：sampleMicros 为传感器的采样时刻（用于计算实际采样率，须逐个样本连续输入），accel 为 m/s²，gyro 为 °/s
+void spectrumPush(uint32_t sampleMicros, const float accel[3], const float gyro[3]);
+
+// 处理待算窗口中的一个通道，没有待算数据时返回 false
+bool spectrumStep();
+
+// 上报最近一次 spectrumStep 的耗时
+void spectrumReportDuration(uint32_t durationUs);
+
+const SpectrumResult &spectrumGetResult(SpectrumChannel channel);
+const SpectrumMetrics &spectrumGetMetrics();
+const char *spectrumChannelName(SpectrumChannel channel);
+
+// 实数 FFT：in 为 SPECTRUM_WINDOW 个实数，输出 SPECTRUM_WINDOW/2+1 个频点的 |X[k]|²（未归一化）
+void spectrumRealFftPower(const float *in, float *powerOut);
@@ -0,0 +1,173 @@
+#include "stripchart.h"
+#include <math.h>
+#include <string.h>
+
+struct TraceConfig
+{
+    bool symmetric;  // 有正负（显示零线）
+    float minSpan;   // 量程按 minSpan·2^k 取值，避免频繁变化
+    float maxSpan;
+    uint8_t top;     // 所在条带的首行与行数
+    uint8_t height;
+};
+
+// 条带之间第 21、43 行为虚线分隔
+static const TraceConfig TRACES[STRIP_TRACES] = {
+    {false, 25.0f, 400.0f, 0, 21},
+    {true, 8.0f, 512.0f, 22, 21},
+    {true, 32.0f, 256.0f, 44, 20},
+};
+static const uint8_t SEPARATOR_ROWS[] = {21, 43};
+// 量程只在历史最大值低于其该比例时缩小，避免在边界附近来回重绘
+static constexpr float SHRINK_RATIO = 0.4f;
+
+static float history[STRIP_TRACES][STRIP_WIDTH];
+static float spans[STRIP_TRACES];
+static size_t head = STRIP_WIDTH - 1;
+static size_t filled = 0;
+static StripChartMetrics metrics = {};
+
+void stripChartReset()
+{
+    for (size_t t = 0; t < STRIP_TRACES; ++t)
+    {
+        spans[t] = TRACES[t].minSpan;
+    }
+    head = STRIP_WIDTH - 1;
+    filled = 0;
+    metrics = {};
+}
+
+static size_t wrap(size_t x)
+{
+    return x % STRIP_WIDTH;
+}
+
+static bool columnFilled(size_t x)
+{
+    return filled == STRIP_WIDTH || x < filled;
+}
+
+// 能容纳 magnitude 的最小量程
+static float spanFor(const TraceConfig &config, float magnitude)
+{
+    float span = config.minSpan;
+    while (span < magnitude && span < config.maxSpan)
+    {
+        span *= 2.0f;
+    }
+    return span;
+}
+
+bool stripChartPush(const float values[STRIP_TRACES])
+{
+    head = wrap(head + 1);
+    if (filled < STRIP_WIDTH)
+    {
+        ++filled;
+    }
+    ++metrics.columns;
+
+    bool rescaled = false;
+    for (size_t t = 0; t < STRIP_TRACES; ++t)
+    {
+        history[t][head] = values[t];
+        // 光标列不显示，不参与量程
+        float peak = 0.0f;
+        for (size_t x = 0; x < filled; ++x)
+        {
+            if (x != wrap(head + 1) && !isnan(history[t][x]))
+            {
+                peak = fmaxf(peak, fabsf(history[t][x]));
+            }
+        }
+        const float needed = spanFor(TRACES[t], peak);
+        if (needed > spans[t] || (needed < spans[t] && peak < spans[t] * SHRINK_RATIO))
+        {
+            spans[t] = needed;
+            rescaled = true;
+        }
+    }
+    if (rescaled)
+    {
+        ++metrics.rescales;
+    }
+    return rescaled;
+}
+
+size_t stripChartHead()
+{
+    return head;
+}
+
+size_t stripChartCursor()
+{
+    return wrap(head + 1);
+}
+
+static void setRow(uint8_t out[STRIP_PAGES], int row)
+{
+    out[row / 8] |= static_cast<uint8_t>(1u << (row % 8));
+}
+
+// 数值对应的行，超出量程时限制在条带内
+static int rowOf(size_t trace, float value)
+{
+    const TraceConfig &config = TRACES[trace];
+    const float low = config.symmetric ? -spans[trace] : 0.0f;
+    const float fraction = (value - low) / (spans[trace] - low);
+    const int level = static_cast<int>(lroundf(fraction * (config.height - 1)));
+    const int clamped = level < 0 ? 0 : (level > config.height - 1 ? config.height - 1 : level);
+    return config.top + config.height - 1 - clamped;
+}
+
+void stripChartColumn(size_t x, uint8_t out[STRIP_PAGES])
+{
+    memset(out, 0, STRIP_PAGES);
+    if (filled > 0 && x == stripChartCursor())
+    {
+        return;
+    }
+    if (x % 4 == 0)
+    {
+        for (uint8_t row : SEPARATOR_ROWS)
+        {
+            setRow(out, row);
+        }
+    }
+    for (size_t t = 0; t < STRIP_TRACES; ++t)
+    {
+        if (TRACES[t].symmetric && x % 4 == 2)
+        {
+            setRow(out, rowOf(t, 0.0f));
+        }
+        if (!columnFilled(x) || isnan(history[t][x]))
+        {
+            continue;
+        }
+        // 与前一列的点连成竖线，快速变化时曲线不断开
+        const int row = rowOf(t, history[t][x]);
+        const size_t previous = wrap(x + STRIP_WIDTH - 1);
+        int from = row;
+        if (columnFilled(previous) && !isnan(history[t][previous]))
+        {
+            from = rowOf(t, history[t][previous]);
+        }
+        const int first = from < row ? from : row;
+        const int last = from < row ? row : from;
+        for (int r = first; r <= last; ++r)
+        {
+            setRow(out, r);
+        }
+    }
+}
+
+float stripChartSpan(StripTrace trace)
+{
+    return spans[static_cast<size_t>(trace)];
+}
+
+const StripChartMetrics &stripChartGetMetrics()
+{
+    return metrics;
+}
@@ -0,0 +1,46 @@
+#pragma once
+#include <stddef.h>
+#include <stdint.h>
+
+// OLED 曲线页：前方距离、偏航角速度、电机命令三条曲线的历史，上中下三条带各一条，纵轴自动量程。
+// 按扫描方式显示（类似心电监护）：第 N 个样本画在第 N % 128 列，其后一列留空作为扫描光标，
+// 每次更新只需写入这两列（16 字节），整屏重绘只在进入页面或量程变化时发生。
+// 列的光栅化是纯逻辑（不依赖 Arduino），输出与 SSD1306 显存相同的列格式：每列 8 字节，
+// 第 p 字节为第 p 页（8 行），bit0 在上，便于主机端对照帧缓冲模型验证。
+
+static constexpr size_t STRIP_WIDTH = 128;
+static constexpr size_t STRIP_PAGES = 8; // 64 行
+static constexpr size_t STRIP_TRACES = 3;
+// 每个样本对应一列：40 ms 一列，整屏约 5 s
+static constexpr uint32_t STRIP_INTERVAL_MS = 40;
+
+enum class StripTrace : uint8_t
+{
+    DistanceCm, // 前方距离（cm），无回波或未知时传 NAN
+    YawRate,    // 偏航角速度（°/s）
+    Motor       // 两侧电机命令的平均（-255~255）
+};
+
+struct StripChartMetrics
+{
+    uint32_t columns;  // 追加的样本数
+    uint32_t rescales; // 量程变化（需要整屏重绘）次数
+};
+
+// 清空历史并恢复最小量程，须在其他函数之前调用一次
+void stripChartReset();
+
+// 追加一列样本（按 StripTrace 顺序），任一曲线的量程因此变化时返回 true，此时屏上已有的列需按新量程重绘
+bool stripChartPush(const float values[STRIP_TRACES]);
+
+// 最新样本所在的列与其后的光栅光标列
+size_t stripChartHead();
+size_t stripChartCursor();
+
+// 按当前历史与量程光栅化第 x 列
+void stripChartColumn(size_t x, uint8_t out[STRIP_PAGES]);
+
+// 当前量程：对称曲线为 ±span，距离为 0~span
+float stripChartSpan(StripTrace trace);
+
+const StripChartMetrics &stripChartGetMetrics();
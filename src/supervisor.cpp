@@ -0,0 +1,157 @@
+#include "supervisor.h"
+#include "logger.h"
+
+// 预算：IMU 每次 loop 都应有新数据；测距仅在有行驶命令时要求新鲜；显示与控制步不检查新鲜度
+static const SupervisorBudget BUDGETS[SUBSYSTEM_COUNT] = {
+    {5000, 100, 3, 5},  // Imu
+    {35000, 500, 2, 2}, // Ranging
+    {40000, 0, 1, 1},   // Display
+    {60000, 0, 1, 1},   // Control
+};
+
+static const char *const NAMES[SUBSYSTEM_COUNT] = {"IMU", "测距", "显示", "控制"};
+
+static SubsystemHealth health[SUBSYSTEM_COUNT] = {};
+
+static SubsystemHealth &at(Subsystem subsystem)
+{
+    return health[static_cast<size_t>(subsystem)];
+}
+
+static const SupervisorBudget &budget(Subsystem subsystem)
+{
+    return BUDGETS[static_cast<size_t>(subsystem)];
+}
+
+static void degrade(Subsystem subsystem, const char *reason)
+{
+    SubsystemHealth &h = at(subsystem);
+    if (h.degraded)
+    {
+        return;
+    }
+    h.degraded = true;
+    h.consecutiveFresh = 0;
+    ++h.degradations;
+    LOG_WARN("监督：{}{}，进入降级模式", supervisorName(subsystem), reason);
+}
+
+void supervisorInit(uint32_t nowMs)
+{
+    for (size_t i = 0; i < SUBSYSTEM_COUNT; ++i)
+    {
+        health[i] = {};
+        health[i].active = true;
+        health[i].lastFreshMs = nowMs;
+        health[i].lastRetryMs = nowMs;
+    }
+}
+
+void supervisorSetActive(Subsystem subsystem, bool active)
+{
+    at(subsystem).active = active;
+}
+
+void supervisorReportFresh(Subsystem subsystem, uint32_t nowMs)
+{
+    SubsystemHealth &h = at(subsystem);
+    h.lastFreshMs = nowMs;
+    h.consecutiveFaults = 0;
+    if (!h.degraded)
+    {
+        return;
+    }
+    if (++h.consecutiveFresh >= budget(subsystem).recoverThreshold)
+    {
+        h.degraded = false;
+        h.consecutiveFresh = 0;
+        ++h.recoveries;
+        LOG_WARN("监督：{}已恢复", supervisorName(subsystem));
+    }
+}
+
+void supervisorReportFault(Subsystem subsystem, uint32_t)
+{
+    SubsystemHealth &h = at(subsystem);
+    ++h.faults;
+    h.consecutiveFresh = 0;
+    if (h.consecutiveFaults < 255)
+    {
+        ++h.consecutiveFaults;
+    }
+    if (h.consecutiveFaults >= budget(subsystem).faultThreshold)
+    {
+        degrade(subsystem, "故障");
+    }
+}
+
+void supervisorReportDuration(Subsystem subsystem, uint32_t durationUs)
+{
+    SubsystemHealth &h = at(subsystem);
+    h.lastDurationUs = durationUs;
+    if (durationUs > h.maxDurationUs)
+    {
+        h.maxDurationUs = durationUs;
+    }
+    if (durationUs > budget(subsystem).deadlineUs)
+    {
+        ++h.deadlineMisses;
+        h.lastMissUs = durationUs;
+    }
+}
+
+bool supervisorEvaluate(uint32_t nowMs)
+{
+    bool changed = false;
+    for (size_t i = 0; i < SUBSYSTEM_COUNT; ++i)
+    {
+        const Subsystem subsystem = static_cast<Subsystem>(i);
+        SubsystemHealth &h = health[i];
+        const uint32_t freshness = BUDGETS[i].freshnessMs;
+        if (!h.active)
+        {
+            // 重新激活时从当前时刻重新计算新鲜度
+            h.lastFreshMs = nowMs;
+            continue;
+        }
+        if (freshness == 0 || h.degraded || nowMs - h.lastFreshMs <= freshness)
+        {
+            continue;
+        }
+        ++h.staleEvents;
+        degrade(subsystem, "数据陈旧");
+        changed = true;
+    }
+    return changed;
+}
+
+bool supervisorDegraded(Subsystem subsystem)
+{
+    return at(subsystem).degraded;
+}
+
+bool supervisorShouldRetry(Subsystem subsystem, uint32_t nowMs, uint32_t intervalMs)
+{
+    SubsystemHealth &h = at(subsystem);
+    if (nowMs - h.lastRetryMs < intervalMs)
+    {
+        return false;
+    }
+    h.lastRetryMs = nowMs;
+    return true;
+}
+
+const SubsystemHealth &supervisorGetHealth(Subsystem subsystem)
+{
+    return at(subsystem);
+}
+
+const SupervisorBudget &supervisorGetBudget(Subsystem subsystem)
+{
+    return budget(subsystem);
+}
+
+const char *supervisorName(Subsystem subsystem)
+{
+    return NAMES[static_cast<size_t>(subsystem)];
+}
@@ -0,0 +1,66 @@
+#pragma once
+#include <stddef.h>
+#include <stdint.h>
+
+// 实时监督：为各子系统设定单步截止时间与数据新鲜度预算，检测超时、陈旧数据与故障，
+// 并给出降级状态，恢复后自动回到正常模式（无需重启）。纯逻辑模块，时间由调用方传入。
+
+enum class Subsystem : uint8_t
+{
+    Imu,
+    Ranging,
+    Display,
+    Control
+};
+
+static constexpr size_t SUBSYSTEM_COUNT = 4;
+
+struct SupervisorBudget
+{
+    uint32_t deadlineUs;     // 单步最长耗时，超过计一次截止时间错过
+    uint32_t freshnessMs;    // 最近一次有效数据的最长间隔，0 表示不检查
+    uint8_t faultThreshold;  // 连续故障多少次进入降级
+    uint8_t recoverThreshold; // 降级后连续多少次有效数据判定恢复
+};
+
+struct SubsystemHealth
+{
+    bool degraded;
+    bool active;             // 非活动子系统不检查新鲜度
+    uint8_t consecutiveFaults;
+    uint8_t consecutiveFresh;
+    uint32_t lastFreshMs;
+    uint32_t lastRetryMs;
+    uint32_t faults;
+    uint32_t staleEvents;
+    uint32_t deadlineMisses;
+    uint32_t degradations;
+    uint32_t recoveries;
+    uint32_t lastDurationUs;
+    uint32_t maxDurationUs;
+    uint32_t lastMissUs;     // 最近一次错过截止时间的耗时
+};
+
+// 以当前时间作为所有子系统的新鲜度起点
+void supervisorInit(uint32_t nowMs);
+
+void supervisorSetActive(Subsystem subsystem, bool active);
+
+// 上报一次有效数据 / 明确故障（读失败、NACK、数据冻结）
+void supervisorReportFresh(Subsystem subsystem, uint32_t nowMs);
+void supervisorReportFault(Subsystem subsystem, uint32_t nowMs);
+
+// 上报一次单步耗时（超过预算计一次截止时间错过）
+void supervisorReportDuration(Subsystem subsystem, uint32_t durationUs);
+
+// 检查新鲜度预算，返回 true 表示本次有子系统因数据陈旧进入降级
+bool supervisorEvaluate(uint32_t nowMs);
+
+bool supervisorDegraded(Subsystem subsystem);
+
+// 降级期间限速的恢复尝试：距上次尝试超过 intervalMs 时返回 true 并记下本次时间
+bool supervisorShouldRetry(Subsystem subsystem, uint32_t nowMs, uint32_t intervalMs);
+
+const SubsystemHealth &supervisorGetHealth(Subsystem subsystem);
+const SupervisorBudget &supervisorGetBudget(Subsystem subsystem);
+const char *supervisorName(Subsystem subsystem);
@@ -0,0 +1,187 @@
+#include "thermal_bias.h"
+#include <math.h>
+
+static ThermalBiasTable table = {THERMAL_BIAS_TABLE_VERSION, {}};
+static uint32_t samples = 0;
+
+// 温度在表中的连续位置，限制在表的范围内
+static float position(float temperatureC)
+{
+    const float p = (temperatureC - THERMAL_BIAS_MIN_C) / THERMAL_BIAS_STEP_C;
+    const float last = static_cast<float>(THERMAL_BIAS_BINS - 1);
+    return p < 0.0f ? 0.0f : (p > last ? last : p);
+}
+
+void thermalBiasReset()
+{
+    table = {};
+    table.version = THERMAL_BIAS_TABLE_VERSION;
+    samples = 0;
+}
+
+bool thermalBiasLoad(const ThermalBiasTable &stored)
+{
+    thermalBiasReset();
+    if (stored.version != THERMAL_BIAS_TABLE_VERSION)
+    {
+        return false;
+    }
+    table = stored;
+    return true;
+}
+
+void thermalBiasGetTable(ThermalBiasTable *out)
+{
+    *out = table;
+}
+
+// 表点上的一组通道：陀螺三轴或加速度计 Z 轴
+struct Fit
+{
+    ThermalBiasMoments &moments;
+    float *means;
+    float *meansT;
+    size_t channels;
+};
+
+static Fit fitOf(ThermalBiasBin &bin, bool accel)
+{
+    if (accel)
+    {
+        return {bin.accelMoments, &bin.accelZ, &bin.accelZT, 1};
+    }
+    return {bin.gyroMoments, bin.gyro, bin.gyroT, 3};
+}
+
+// 计入一个样本，逐项做加权平均（权重封顶后变为固定窗口的指数平均）
+static void accumulate(const Fit &fit, const float *values, float offsetC, float share)
+{
+    ThermalBiasMoments &m = fit.moments;
+    m.weight = fminf(m.weight + share, THERMAL_BIAS_MAX_WEIGHT);
+    const float alpha = share / m.weight;
+    m.meanT += (offsetC - m.meanT) * alpha;
+    m.meanTT += (offsetC * offsetC - m.meanTT) * alpha;
+    for (size_t c = 0; c < fit.channels; ++c)
+    {
+        fit.means[c] += (values[c] - fit.means[c]) * alpha;
+        fit.meansT[c] += (values[c] * offsetC - fit.meansT[c]) * alpha;
+    }
+}
+
+// 按到两侧表点的距离分配权重
+static void learn(float temperatureC, bool accel, const float *values)
+{
+    const float p = position(temperatureC);
+    const size_t low = static_cast<size_t>(p);
+    const size_t high = low + 1 < THERMAL_BIAS_BINS ? low + 1 : low;
+    const float fraction = p - low;
+    const float offsetC = temperatureC - (THERMAL_BIAS_MIN_C + low * THERMAL_BIAS_STEP_C);
+    if (fraction < 1.0f)
+    {
+        accumulate(fitOf(table.bins[low], accel), values, offsetC, 1.0f - fraction);
+    }
+    if (fraction > 0.0f)
+    {
+        accumulate(fitOf(table.bins[high], accel), values, offsetC - THERMAL_BIAS_STEP_C, fraction);
+    }
+    ++samples;
+}
+
+void thermalBiasLearnGyro(float temperatureC, const float gyroRaw[3])
+{
+    learn(temperatureC, false, gyroRaw);
+}
+
+void thermalBiasLearnAccelZ(float temperatureC, float accelZ)
+{
+    learn(temperatureC, true, &accelZ);
+}
+
+static bool valid(ThermalBiasBin &bin, bool accel)
+{
+    return fitOf(bin, accel).moments.weight >= THERMAL_BIAS_MIN_WEIGHT;
+}
+
+// 加权线性回归在表点温度处的值：y(0) = ȳ − k·t̄，k = cov(t, y) / (var(t) + 先验)
+static float atBin(ThermalBiasBin &bin, bool accel, size_t channel)
+{
+    const Fit fit = fitOf(bin, accel);
+    const ThermalBiasMoments &m = fit.moments;
+    const float variance = fmaxf(m.meanTT - m.meanT * m.meanT, 0.0f);
+    const float mean = fit.means[channel];
+    const float slope = (fit.meansT[channel] - m.meanT * mean) / (variance + THERMAL_BIAS_SLOPE_PRIOR);
+    return mean - slope * m.meanT;
+}
+
+// 在两侧最近的可用表点之间线性插值，只有一侧可用时取该表点
+static bool lookup(float temperatureC, bool accel, float *out)
+{
+    const float p = position(temperatureC);
+    int below = -1;
+    int above = -1;
+    for (size_t i = 0; i < THERMAL_BIAS_BINS; ++i)
+    {
+        if (!valid(table.bins[i], accel))
+        {
+            continue;
+        }
+        if (static_cast<float>(i) <= p)
+        {
+            below = static_cast<int>(i);
+        }
+        if (static_cast<float>(i) >= p && above < 0)
+        {
+            above = static_cast<int>(i);
+        }
+    }
+    if (below < 0 && above < 0)
+    {
+        return false;
+    }
+    const size_t channels = accel ? 1 : 3;
+    if (below < 0 || above < 0 || below == above)
+    {
+        ThermalBiasBin &bin = table.bins[below >= 0 ? below : above];
+        for (size_t c = 0; c < channels; ++c)
+        {
+            out[c] = atBin(bin, accel, c);
+        }
+        return true;
+    }
+    const float t = (p - below) / (above - below);
+    for (size_t c = 0; c < channels; ++c)
+    {
+        const float a = atBin(table.bins[below], accel, c);
+        const float b = atBin(table.bins[above], accel, c);
+        out[c] = a + (b - a) * t;
+    }
+    return true;
+}
+
+bool thermalBiasGyro(float temperatureC, float out[3])
+{
+    return lookup(temperatureC, false, out);
+}
+
+bool thermalBiasAccelZ(float temperatureC, float *out)
+{
+    return lookup(temperatureC, true, out);
+}
+
+size_t thermalBiasValidBins()
+{
+    size_t count = 0;
+    for (size_t i = 0; i < THERMAL_BIAS_BINS; ++i)
+    {
+        if (valid(table.bins[i], false))
+        {
+            ++count;
+        }
+    }
+    return count;
+}
+
+uint32_t thermalBiasSamples()
+{
+    return samples;
+}
@@ -0,0 +1,69 @@
+#pragma once
+#include <stddef.h>
+#include <stdint.h>
+
+// 温度-零偏模型：MPU6050 的陀螺与加速度计零偏随芯片温度变化（电机与稳压器发热时尤其明显），
+// 开机校准与静止时的在线跟踪只在停车时有效，行驶中的温升会变成航向漂移。
+// 按芯片温度分段（10~65 °C，每 5 °C 一个表点），静止期间把原始读数（即当时的零偏）按线性权重计入相邻两个表点，
+// 每个表点对附近的数据做加权线性回归取表点处的值（升温过程中边缘表点只有单侧数据，直接平均会偏向数据一侧），
+// 查询时在有数据的表点之间线性插值，超出范围取最近的表点。
+// 加速度计只学习 Z 轴：X/Y 轴零偏与车身倾斜无法区分，Z 轴在倾斜 3° 以内时误差 < 0.014 m/s²。
+// 纯逻辑模块（不依赖 Arduino），便于主机端用合成的升温过程验证。
+
+static constexpr float THERMAL_BIAS_MIN_C = 10.0f;
+static constexpr float THERMAL_BIAS_STEP_C = 5.0f;
+static constexpr size_t THERMAL_BIAS_BINS = 12;
+// 表点权重（样本数）上限：达到后按该窗口长度继续缓慢更新，跟踪器件老化
+static constexpr float THERMAL_BIAS_MAX_WEIGHT = 5000.0f;
+// 权重达到该值的表点才参与插值（500 Hz 下约 0.5 s 静止）
+static constexpr float THERMAL_BIAS_MIN_WEIGHT = 250.0f;
+// 回归斜率的正则项（°C²）：温度跨度小于约 0.2 °C 时斜率收缩到 0，退化为加权平均；
+// 不能再大：升温中的边缘表点只有 1~2 °C 的单侧数据，方差约 0.5 °C²，正则项与之相当时斜率减半，表点值又偏向数据一侧
+static constexpr float THERMAL_BIAS_SLOPE_PRIOR = 0.05f;
+static constexpr uint8_t THERMAL_BIAS_TABLE_VERSION = 1;
+
+// 温度的加权统计量（相对表点温度的偏移）
+struct ThermalBiasMoments
+{
+    float weight;
+    float meanT;
+    float meanTT;
+};
+
+// 读数的加权平均 y 与 y·t 的加权平均，配合 ThermalBiasMoments 求回归
+struct ThermalBiasBin
+{
+    ThermalBiasMoments gyroMoments;
+    float gyro[3];     // 陀螺零偏（°/s）
+    float gyroT[3];
+    ThermalBiasMoments accelMoments;
+    float accelZ;      // 静止水平时的 Z 轴原始读数（m/s²）
+    float accelZT;
+};
+
+struct ThermalBiasTable
+{
+    uint8_t version;
+    ThermalBiasBin bins[THERMAL_BIAS_BINS];
+};
+
+// 清空模型
+void thermalBiasReset();
+
+// 载入保存的模型，版本不符时返回 false 且模型保持为空
+bool thermalBiasLoad(const ThermalBiasTable &table);
+void thermalBiasGetTable(ThermalBiasTable *out);
+
+// 静止期间每个样本调用：原始角速度（°/s）
+void thermalBiasLearnGyro(float temperatureC, const float gyroRaw[3]);
+// 静止且接近水平时调用：Z 轴原始加速度（m/s²）
+void thermalBiasLearnAccelZ(float temperatureC, float accelZ);
+
+// 查询该温度下的零偏，模型中还没有可用表点时返回 false
+bool thermalBiasGyro(float temperatureC, float out[3]);
+bool thermalBiasAccelZ(float temperatureC, float *out);
+
+// 有可用数据的表点数（陀螺）
+size_t thermalBiasValidBins();
+// 累计学习的样本数（判断是否需要保存）
+uint32_t thermalBiasSamples();
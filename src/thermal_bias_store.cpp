@@ -0,0 +1,36 @@
+#include <Arduino.h>
+#include <Preferences.h>
+#include "thermal_bias_store.h"
+
+static const char *const NAMESPACE = "thermbias";
+static const char *const KEY = "table";
+
+bool thermalBiasStoreSave(const ThermalBiasTable &table)
+{
+    Preferences prefs;
+    if (!prefs.begin(NAMESPACE, false))
+    {
+        return false;
+    }
+    const bool ok = prefs.putBytes(KEY, &table, sizeof(table)) == sizeof(table);
+    prefs.end();
+    return ok;
+}
+
+bool thermalBiasStoreLoad(ThermalBiasTable *table)
+{
+    Preferences prefs;
+    if (!prefs.begin(NAMESPACE, true))
+    {
+        return false;
+    }
+    ThermalBiasTable stored;
+    const size_t size = prefs.getBytes(KEY, &stored, sizeof(stored));
+    prefs.end();
+    if (size != sizeof(stored) || stored.version != THERMAL_BIAS_TABLE_VERSION)
+    {
+        return false;
+    }
+    *table = stored;
+    return true;
+}
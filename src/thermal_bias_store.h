@@ -0,0 +1,7 @@
+#pragma once
+#include "thermal_bias.h"
+
+// 温度-零偏模型的闪存存储（NVS，命名空间 "thermbias"）
+bool thermalBiasStoreSave(const ThermalBiasTable &table);
+// 没有保存过或版本不符时返回 false
+bool thermalBiasStoreLoad(ThermalBiasTable *table);
@@ -1,10 +1,12 @@
 #include "ultrasonic.h"
+#include "sonar.h"
 
 // 固定引脚（可按需修改）
 #define ULTRASONIC_TRIG 20
 #define ULTRASONIC_ECHO 21
 
 static bool ultrasonicInited = false;
+static float temperatureC = SONAR_DEFAULT_TEMPERATURE_C;
 
 bool initUltrasonic()
 {
@@ -15,10 +17,15 @@ bool initUltrasonic()
     return true;
 }
 
+void ultrasonicSetTemperature(float celsius)
+{
+    temperatureC = celsius;
+}
+
 float ultrasonicReadCm()
 {
     if (!ultrasonicInited)
-        return -1.0f;
+        return ULTRASONIC_NO_RESPONSE;
 
     // 触发 10us 脉冲
     digitalWrite(ULTRASONIC_TRIG, LOW);
@@ -30,8 +37,10 @@ float ultrasonicReadCm()
     // 读取回波，30ms 超时（约 5m）
     unsigned long duration = pulseIn(ULTRASONIC_ECHO, HIGH, 30000UL);
     if (duration == 0)
-        return -1.0f;
+    {
+        // 超时时 ECHO 仍为高：模块在工作，只是量程内没有回波；一直为低说明模块无响应
+        return digitalRead(ULTRASONIC_ECHO) == HIGH ? ULTRASONIC_NO_ECHO : ULTRASONIC_NO_RESPONSE;
+    }
 
-    // 距离(cm) = (us * 17) / 1000
-    return (duration * 17.0f) / 1000.0f;
+    return sonarEchoToCm(duration, temperatureC);
 }
@@ -4,5 +4,14 @@
 // 初始化超声波传感器（内部固定引脚）
 bool initUltrasonic();
 
-// 读取距离（cm），失败/超时返回 -1.0f
+// 量程内无回波（模块正常）
+#define ULTRASONIC_NO_ECHO -1.0f
+// 模块无响应（未接或损坏）
+#define ULTRASONIC_NO_RESPONSE -2.0f
+
+// 设置声速修正所用的气温（°C），默认 20 °C
+void ultrasonicSetTemperature(float celsius);
+
+// 单次测距（cm，按当前气温换算声速），失败时返回 ULTRASONIC_NO_ECHO 或 ULTRASONIC_NO_RESPONSE；
+// 连续测距取中位数见 sonar.h
 float ultrasonicReadCm();
@@ -0,0 +1,103 @@
+#include "zupt.h"
+#include <math.h>
+
+static ZuptMetrics metrics = {};
+static float bootBiasZ = 0.0f;
+static float accelMean = 0.0f;
+static float accelVar = 0.0f;
+static bool accelPrimed = false;
+static float quietMs = 0.0f;
+// 进入静止前的保持窗口内累积的残余角速度，用于估计运动期间的航向漂移
+static float quietResidualSum = 0.0f;
+static float quietBootSum = 0.0f;
+static uint32_t quietSamples = 0;
+
+void zuptInit(const float gyroBias[3])
+{
+    metrics = {};
+    for (int i = 0; i < 3; ++i)
+    {
+        metrics.gyroBias[i] = gyroBias[i];
+    }
+    bootBiasZ = gyroBias[2];
+    accelMean = 0.0f;
+    accelVar = 0.0f;
+    accelPrimed = false;
+    quietMs = 0.0f;
+    quietResidualSum = 0.0f;
+    quietBootSum = 0.0f;
+    quietSamples = 0;
+}
+
+void zuptCorrectGyro(const float gyroRaw[3], float out[3])
+{
+    for (int i = 0; i < 3; ++i)
+    {
+        out[i] = gyroRaw[i] - metrics.gyroBias[i];
+    }
+}
+
+bool zuptUpdate(float deltaTime, const float accel[3], const float gyroRaw[3], bool motorsIdle)
+{
+    // 加速度幅值的指数滑动均值与方差
+    const float magnitude = sqrtf(accel[0] * accel[0] + accel[1] * accel[1] + accel[2] * accel[2]);
+    if (!accelPrimed)
+    {
+        accelMean = magnitude;
+        accelVar = 0.0f;
+        accelPrimed = true;
+    }
+    const float alpha = fminf(deltaTime / ZUPT_ACCEL_TAU_S, 1.0f);
+    const float deviation = magnitude - accelMean;
+    accelMean += deviation * alpha;
+    accelVar += (deviation * deviation - accelVar) * alpha;
+
+    float gyro[3];
+    zuptCorrectGyro(gyroRaw, gyro);
+    const float gyroMagnitude = sqrtf(gyro[0] * gyro[0] + gyro[1] * gyro[1] + gyro[2] * gyro[2]);
+
+    const bool quiet = motorsIdle && accelVar < ZUPT_ACCEL_VAR_THRESHOLD && gyroMagnitude < ZUPT_GYRO_THRESHOLD_DPS;
+    if (!quiet)
+    {
+        quietMs = 0.0f;
+        quietResidualSum = 0.0f;
+        quietBootSum = 0.0f;
+        quietSamples = 0;
+    }
+    else
+    {
+        quietMs += deltaTime * 1000.0f;
+        quietResidualSum += gyro[2];
+        quietBootSum += gyroRaw[2] - bootBiasZ;
+        ++quietSamples;
+    }
+
+    const bool stationary = quietMs >= ZUPT_HOLD_MS;
+    if (stationary && !metrics.stationary)
+    {
+        // 真实角速度为零，保持窗口内的平均读数就是刚才运动期间生效的零偏误差
+        ++metrics.stationaryCount;
+        const float residual = quietResidualSum / quietSamples * 60.0f;
+        const float boot = quietBootSum / quietSamples * 60.0f;
+        const bool first = metrics.stationaryCount == 1;
+        metrics.headingDriftDegPerMin = first ? residual : metrics.headingDriftDegPerMin + (residual - metrics.headingDriftDegPerMin) * 0.3f;
+        metrics.bootBiasDriftDegPerMin = first ? boot : metrics.bootBiasDriftDegPerMin + (boot - metrics.bootBiasDriftDegPerMin) * 0.3f;
+    }
+    metrics.stationary = stationary;
+    if (!stationary)
+    {
+        return false;
+    }
+
+    const float biasAlpha = fminf(deltaTime / ZUPT_BIAS_TAU_S, 1.0f);
+    for (int i = 0; i < 3; ++i)
+    {
+        metrics.gyroBias[i] += gyro[i] * biasAlpha;
+    }
+    return true;
+}
+
+const ZuptMetrics &zuptGetMetrics()
+{
+    return metrics;
+}
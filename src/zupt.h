@@ -0,0 +1,35 @@
+#pragma once
+#include <stdint.h>
+
+// 静止检测（零速更新）：加速度幅值方差 + 陀螺角速度幅值 + 电机停止三者同时满足并持续一段时间判定为静止。
+// 静止期间在线重估陀螺零偏，并统计航向漂移。纯逻辑模块（不依赖 Arduino），便于主机端用合成轨迹验证。
+
+// 加速度幅值方差阈值（(m/s²)²）与平滑时间常数
+static constexpr float ZUPT_ACCEL_VAR_THRESHOLD = 0.02f;
+static constexpr float ZUPT_ACCEL_TAU_S = 0.25f;
+// 扣除当前零偏后的陀螺角速度幅值阈值（°/s）
+static constexpr float ZUPT_GYRO_THRESHOLD_DPS = 2.0f;
+// 条件需持续的时间
+static constexpr uint32_t ZUPT_HOLD_MS = 250;
+// 静止期间零偏跟踪的时间常数
+static constexpr float ZUPT_BIAS_TAU_S = 2.0f;
+
+struct ZuptMetrics
+{
+    bool stationary;
+    uint32_t stationaryCount;     // 进入静止的次数
+    float gyroBias[3];            // 当前陀螺零偏（°/s）
+    float headingDriftDegPerMin;  // 每次进入静止时测得的残余航向漂移（使用跟踪零偏）
+    float bootBiasDriftDegPerMin; // 同一时刻若只用开机零偏的航向漂移（对照）
+};
+
+// 以开机校准的零偏初始化
+void zuptInit(const float gyroBias[3]);
+
+// 输入原始加速度（m/s²）与原始角速度（°/s），返回当前是否静止
+bool zuptUpdate(float deltaTime, const float accel[3], const float gyroRaw[3], bool motorsIdle);
+
+// 用当前零偏校正角速度
+void zuptCorrectGyro(const float gyroRaw[3], float out[3]);
+
+const ZuptMetrics &zuptGetMetrics();
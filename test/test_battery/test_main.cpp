@@ -0,0 +1,166 @@
+// 电池补偿的仿真放电检查：2S 锂电池开路电压随放电从 8.4 V 降到 6.2 V，内阻 0.15 Ω，
+// 电机电流与施加在电机两端的有效电压成正比（负载越大压降越大）。每 50 ms 输入一次 ADC 平均值（带噪声）。
+// 补偿后同一命令下电机两端的有效电压应基本不变；电量等级只随放电单向变化，不被负载压降触发。
+#include <unity.h>
+#include <math.h>
+#include <stdio.h>
+#include "battery.h"
+
+static constexpr uint32_t SAMPLE_MS = 50;
+static constexpr float INTERNAL_OHMS = 0.15f;
+static constexpr float AMPS_PER_VOLT = 0.4f; // 两个电机在有效电压下的总电流
+
+static uint32_t noiseState = 1;
+
+static float noise(float amplitude)
+{
+    noiseState = noiseState * 1664525u + 1013904223u;
+    return ((noiseState >> 8) / 16777216.0f * 2.0f - 1.0f) * amplitude;
+}
+
+struct Pack
+{
+    float openV;
+    float terminalV;
+};
+
+// 按当前端电压与补偿后的占空比求负载电流，再求端电压（两次迭代足以收敛）
+static float effectiveVolts(Pack &pack, int command)
+{
+    float effective = 0.0f;
+    for (int i = 0; i < 2; ++i)
+    {
+        effective = pack.terminalV * batteryCompensate(command) / 255.0f;
+        pack.terminalV = pack.openV - INTERNAL_OHMS * AMPS_PER_VOLT * fabsf(effective);
+    }
+    return effective;
+}
+
+void setUp()
+{
+    noiseState = 1;
+    batteryConfigure(BATTERY_DEFAULT_CONFIG);
+    batteryUpdate(0, 0.0f); // 未接电池：滤波器与等级复位
+}
+
+void tearDown()
+{
+}
+
+void test_absent_battery_does_not_scale()
+{
+    TEST_ASSERT_EQUAL(static_cast<int>(BatteryLevel::Absent), static_cast<int>(batteryLevel()));
+    batteryUpdate(100, 0.4f); // USB 供电，分压输入只有噪声
+    TEST_ASSERT_EQUAL_FLOAT(1.0f, batteryDutyScale());
+    TEST_ASSERT_EQUAL(200, batteryCompensate(200));
+    TEST_ASSERT_EQUAL(static_cast<int>(BatteryLevel::Absent), static_cast<int>(batteryLevel()));
+}
+
+// 接上电池后滤波器直接跳到当前值，第一次更新就得到正确的系数
+void test_scale_follows_reference_and_clamps()
+{
+    TEST_ASSERT_TRUE(batteryUpdate(0, 8.4f));
+    TEST_ASSERT_EQUAL(static_cast<int>(BatteryLevel::Normal), static_cast<int>(batteryLevel()));
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, 7.0f / 8.4f, batteryDutyScale());
+    TEST_ASSERT_EQUAL(static_cast<int>(lroundf(200 * 7.0f / 8.4f)), batteryCompensate(200));
+    TEST_ASSERT_EQUAL(-255, batteryCompensate(-400));
+
+    // 电压过低时放大系数封顶并计数
+    for (uint32_t t = SAMPLE_MS; t <= 2000; t += SAMPLE_MS)
+    {
+        batteryUpdate(t, 5.0f);
+    }
+    const BatteryMetrics &metrics = batteryGetMetrics();
+    TEST_ASSERT_EQUAL_FLOAT(BATTERY_DEFAULT_CONFIG.maxScale, batteryDutyScale());
+    TEST_ASSERT_GREATER_THAN_UINT32(0, metrics.saturated);
+    TEST_ASSERT_EQUAL(255, batteryCompensate(220));
+}
+
+// 放电 20 分钟，期间以 150 命令行驶并每 4 s 急停/起步一次：有效电压误差与等级变化
+void test_discharge_keeps_motor_voltage_and_levels_are_monotonic()
+{
+    static constexpr uint32_t DURATION_MS = 20u * 60u * 1000u;
+    Pack pack = {8.4f, 8.4f};
+    const float target = BATTERY_DEFAULT_CONFIG.referenceV * 150 / 255.0f;
+    float worstError = 0.0f;
+    float uncompensatedSpread[2] = {1e9f, 0.0f};
+    int changes = 0;
+    BatteryLevel levels[3] = {};
+    uint32_t lowAtMs = 0;
+    for (uint32_t t = 0; t <= DURATION_MS; t += SAMPLE_MS)
+    {
+        pack.openV = 8.4f - 2.2f * t / DURATION_MS;
+        const bool driving = (t / 4000) % 4 != 3;
+        const float effective = effectiveVolts(pack, driving ? 150 : 0);
+        if (batteryUpdate(t, pack.terminalV + noise(0.03f)))
+        {
+            TEST_ASSERT_LESS_THAN(3, changes);
+            levels[changes++] = batteryLevel();
+            if (batteryLevel() == BatteryLevel::Low)
+            {
+                lowAtMs = t;
+            }
+        }
+        // 起步后快速滤波需要几个时间常数跟上压降，稳态后再统计；补偿封顶之后不再要求
+        const bool steady = driving && (t % 4000) >= 1000;
+        if (steady && batteryGetMetrics().scale < BATTERY_DEFAULT_CONFIG.maxScale)
+        {
+            worstError = fmaxf(worstError, fabsf(effective - target) / target);
+            const float raw = pack.terminalV * 150 / 255.0f;
+            uncompensatedSpread[0] = fminf(uncompensatedSpread[0], raw);
+            uncompensatedSpread[1] = fmaxf(uncompensatedSpread[1], raw);
+        }
+    }
+    char message[128];
+    snprintf(message, sizeof(message), "有效电压最大误差 %.1f%%（未补偿 %.2f~%.2f V，目标 %.2f V），低电量于 %.0f s，等级变化 %d 次",
+             worstError * 100.0f, uncompensatedSpread[0], uncompensatedSpread[1], target, lowAtMs / 1000.0f, changes);
+    TEST_MESSAGE(message);
+    TEST_ASSERT_LESS_THAN_FLOAT(0.02f, worstError);
+    TEST_ASSERT_GREATER_THAN_FLOAT(0.5f, uncompensatedSpread[1] - uncompensatedSpread[0]);
+    // 开路电压 8.4 -> 6.2，依次 正常 -> 低电量 -> 严重低电量，没有来回切换
+    TEST_ASSERT_EQUAL(3, changes);
+    TEST_ASSERT_EQUAL(static_cast<int>(BatteryLevel::Normal), static_cast<int>(levels[0]));
+    TEST_ASSERT_EQUAL(static_cast<int>(BatteryLevel::Low), static_cast<int>(levels[1]));
+    TEST_ASSERT_EQUAL(static_cast<int>(BatteryLevel::Critical), static_cast<int>(levels[2]));
+    TEST_ASSERT_LESS_THAN_FLOAT(BATTERY_DEFAULT_CONFIG.lowV, batteryGetMetrics().minFastV);
+}
+
+// 短时负载压降（每 2 s 有 0.5 s 掉到低电量阈值以下）不触发低电量；回升需超过滞回量才退出
+void test_load_dip_does_not_trigger_and_hysteresis_holds()
+{
+    uint32_t t = 0;
+    for (; t <= 10000; t += SAMPLE_MS)
+    {
+        const bool dip = (t % 2000) >= 1500;
+        TEST_ASSERT_FALSE(batteryUpdate(t, dip ? 6.5f : 7.2f) && t > 0);
+    }
+    TEST_ASSERT_EQUAL(static_cast<int>(BatteryLevel::Normal), static_cast<int>(batteryLevel()));
+    TEST_ASSERT_LESS_THAN_FLOAT(6.8f, batteryGetMetrics().minFastV);
+
+    for (; t <= 40000; t += SAMPLE_MS)
+    {
+        batteryUpdate(t, 6.7f);
+    }
+    TEST_ASSERT_EQUAL(static_cast<int>(BatteryLevel::Low), static_cast<int>(batteryLevel()));
+    // 回升到阈值与阈值加滞回量之间：保持低电量
+    for (; t <= 70000; t += SAMPLE_MS)
+    {
+        batteryUpdate(t, 6.9f);
+    }
+    TEST_ASSERT_EQUAL(static_cast<int>(BatteryLevel::Low), static_cast<int>(batteryLevel()));
+    for (; t <= 100000; t += SAMPLE_MS)
+    {
+        batteryUpdate(t, 7.1f);
+    }
+    TEST_ASSERT_EQUAL(static_cast<int>(BatteryLevel::Normal), static_cast<int>(batteryLevel()));
+}
+
+int main(int, char **)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_absent_battery_does_not_scale);
+    RUN_TEST(test_scale_follows_reference_and_clamps);
+    RUN_TEST(test_discharge_keeps_motor_voltage_and_levels_are_monotonic);
+    RUN_TEST(test_load_dip_does_not_trigger_and_hysteresis_holds);
+    return UNITY_END();
+}
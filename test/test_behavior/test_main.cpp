@@ -0,0 +1,310 @@
+// 协作式行为脚本的调度检查：脚本按挂起点顺序推进，SLEEP 按调用方传入的时间计时（含 32 位回绕），
+// UNTIL 每次推进重新求值；重新开始不调用 onCancel，取消只在运行中调用一次，正常结束不调用；
+// 与原先 enum + switch 状态机相比，每次推进的额外开销（主机计时）。
+#include <unity.h>
+#include <chrono>
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+#include "behavior.h"
+
+static constexpr uint32_t LOOP_MS = 5;
+
+// 跨挂起点的状态放在文件作用域，与设备端脚本的写法一致
+static char trace[64];
+static bool conditionMet = false;
+static int cancelCalls = 0;
+static uint32_t stepStartMs[3];
+
+static void mark(char c)
+{
+    const size_t n = strlen(trace);
+    trace[n] = c;
+    trace[n + 1] = '\0';
+}
+
+// 与避障脚本同样的形状：动作 -> 等待条件 -> 暂停 -> 动作 -> 暂停
+static bool sequenceScript(Behavior &self, uint32_t nowMs)
+{
+    BEHAVIOR_BEGIN(self);
+    mark('a');
+    stepStartMs[0] = nowMs;
+    BEHAVIOR_UNTIL(self, conditionMet);
+    mark('b');
+    stepStartMs[1] = nowMs;
+    BEHAVIOR_SLEEP(self, nowMs, 2000);
+    mark('c');
+    stepStartMs[2] = nowMs;
+    BEHAVIOR_SLEEP(self, nowMs, 500);
+    mark('d');
+    BEHAVIOR_END(self);
+}
+
+static void onCancel()
+{
+    ++cancelCalls;
+}
+
+static Behavior sequence = {sequenceScript, onCancel, 0, false, 0};
+
+// 推进到脚本结束或超时，返回结束时刻
+static uint32_t runUntilDone(Behavior &behavior, uint32_t nowMs, uint32_t limitMs)
+{
+    const uint32_t startMs = nowMs;
+    while (behaviorStep(behavior, nowMs) && nowMs - startMs < limitMs)
+    {
+        nowMs += LOOP_MS;
+    }
+    return nowMs;
+}
+
+void setUp()
+{
+    trace[0] = '\0';
+    conditionMet = false;
+    cancelCalls = 0;
+    sequence.running = false;
+    sequence.resumeLine = 0;
+}
+
+void tearDown()
+{
+}
+
+void test_start_runs_to_first_suspension()
+{
+    behaviorStart(sequence, 1000);
+    TEST_ASSERT_TRUE(behaviorRunning(sequence));
+    TEST_ASSERT_EQUAL_STRING("a", trace);
+    // 条件不成立时反复推进不会重复执行前面的代码
+    for (uint32_t t = 1005; t < 1100; t += LOOP_MS)
+    {
+        TEST_ASSERT_TRUE(behaviorStep(sequence, t));
+    }
+    TEST_ASSERT_EQUAL_STRING("a", trace);
+}
+
+void test_sleep_durations_follow_caller_time()
+{
+    behaviorStart(sequence, 1000);
+    conditionMet = true;
+    const uint32_t endMs = runUntilDone(sequence, 1005, 10000);
+    TEST_ASSERT_FALSE(behaviorRunning(sequence));
+    TEST_ASSERT_EQUAL_STRING("abcd", trace);
+    TEST_ASSERT_EQUAL_UINT32(1005, stepStartMs[1]);
+    TEST_ASSERT_EQUAL_UINT32(stepStartMs[1] + 2000, stepStartMs[2]);
+    TEST_ASSERT_EQUAL_UINT32(stepStartMs[2] + 500, endMs);
+    TEST_ASSERT_EQUAL(0, cancelCalls); // 正常结束不调用 onCancel
+    TEST_ASSERT_EQUAL(0, sequence.resumeLine);
+    TEST_ASSERT_FALSE(behaviorStep(sequence, endMs + LOOP_MS));
+    TEST_ASSERT_EQUAL_STRING("abcd", trace);
+}
+
+// millis() 约 49.7 天回绕：跨越回绕点的 SLEEP 仍按差值计时
+void test_sleep_across_wraparound()
+{
+    const uint32_t startMs = UINT32_MAX - 1000;
+    conditionMet = true;
+    behaviorStart(sequence, startMs);
+    const uint32_t endMs = runUntilDone(sequence, startMs + LOOP_MS, 10000);
+    TEST_ASSERT_EQUAL_STRING("abcd", trace);
+    TEST_ASSERT_EQUAL_UINT32(2000, stepStartMs[2] - stepStartMs[1]);
+    TEST_ASSERT_EQUAL_UINT32(2500, endMs - stepStartMs[1]);
+}
+
+void test_restart_and_cancel()
+{
+    behaviorStart(sequence, 0);
+    conditionMet = true;
+    behaviorStep(sequence, 100); // 进入 2 s 暂停
+    TEST_ASSERT_EQUAL_STRING("ab", trace);
+
+    // 运行中重新开始：从头执行，不调用 onCancel
+    conditionMet = false;
+    behaviorStart(sequence, 200);
+    TEST_ASSERT_EQUAL_STRING("aba", trace);
+    TEST_ASSERT_EQUAL(0, cancelCalls);
+
+    behaviorCancel(sequence);
+    TEST_ASSERT_FALSE(behaviorRunning(sequence));
+    TEST_ASSERT_EQUAL(1, cancelCalls);
+    behaviorCancel(sequence); // 未运行时什么也不做
+    TEST_ASSERT_EQUAL(1, cancelCalls);
+    TEST_ASSERT_FALSE(behaviorStep(sequence, 300));
+    TEST_ASSERT_EQUAL_STRING("aba", trace);
+
+    // 取消后再开始从头执行
+    behaviorStart(sequence, 400);
+    TEST_ASSERT_EQUAL_STRING("abaa", trace);
+}
+
+// 两个脚本交替推进互不影响：各自的挂起点与等待时间都在自己的结构中
+void test_independent_behaviors_interleave()
+{
+    Behavior other = {sequenceScript, nullptr, 0, false, 0};
+    conditionMet = true;
+    behaviorStart(sequence, 0);
+    behaviorStep(sequence, 5); // 进入 2 s 暂停
+    behaviorStart(other, 1000);
+    behaviorStep(other, 1005);
+    TEST_ASSERT_EQUAL_STRING("abab", trace);
+
+    TEST_ASSERT_TRUE(behaviorStep(sequence, 2000));
+    TEST_ASSERT_TRUE(behaviorStep(sequence, 2005)); // 2005 - 5 = 2000，进入 0.5 s 暂停
+    TEST_ASSERT_EQUAL_STRING("ababc", trace);
+    TEST_ASSERT_TRUE(behaviorStep(other, 2500));
+    TEST_ASSERT_EQUAL_STRING("ababc", trace);
+    TEST_ASSERT_FALSE(behaviorStep(sequence, 2505));
+    TEST_ASSERT_EQUAL_STRING("ababcd", trace);
+
+    behaviorCancel(other); // onCancel 为空
+    TEST_ASSERT_FALSE(behaviorRunning(other));
+    TEST_ASSERT_EQUAL(0, cancelCalls);
+}
+
+// ---- 推进开销对照：同一个避障序列分别写成脚本与原先的 enum + switch 状态机 ----
+static constexpr uint32_t BENCH_MOTION_MS = 3000; // 后退、转向的耗时
+static constexpr uint32_t BENCH_PAUSE_MS = 2000;
+static uint32_t benchMotionEndMs = 0;
+static uint32_t benchActions = 0;
+
+static void benchStartMotion(uint32_t nowMs)
+{
+    benchMotionEndMs = nowMs + BENCH_MOTION_MS;
+    ++benchActions;
+}
+
+static bool benchMotionActive(uint32_t nowMs)
+{
+    return static_cast<int32_t>(benchMotionEndMs - nowMs) > 0;
+}
+
+static bool benchScript(Behavior &self, uint32_t nowMs)
+{
+    BEHAVIOR_BEGIN(self);
+    benchStartMotion(nowMs);
+    BEHAVIOR_UNTIL(self, !benchMotionActive(nowMs));
+    BEHAVIOR_SLEEP(self, nowMs, BENCH_PAUSE_MS);
+    benchStartMotion(nowMs);
+    BEHAVIOR_UNTIL(self, !benchMotionActive(nowMs));
+    BEHAVIOR_SLEEP(self, nowMs, BENCH_PAUSE_MS);
+    BEHAVIOR_END(self);
+}
+
+enum class BenchState
+{
+    Idle,
+    Reversing,
+    PauseAfterReverse,
+    Rotating,
+    PauseAfterRotate
+};
+
+static BenchState benchState = BenchState::Idle;
+static uint32_t benchStateStartMs = 0;
+
+// 原 updateObstacleAvoidance 的形状；不内联，与脚本一样每次推进是一次函数调用
+__attribute__((noinline)) static bool benchSwitchStep(uint32_t nowMs)
+{
+    switch (benchState)
+    {
+    case BenchState::Idle:
+        benchStartMotion(nowMs);
+        benchState = BenchState::Reversing;
+        break;
+    case BenchState::Reversing:
+        if (!benchMotionActive(nowMs))
+        {
+            benchState = BenchState::PauseAfterReverse;
+            benchStateStartMs = nowMs;
+        }
+        break;
+    case BenchState::PauseAfterReverse:
+        if (nowMs - benchStateStartMs >= BENCH_PAUSE_MS)
+        {
+            benchStartMotion(nowMs);
+            benchState = BenchState::Rotating;
+        }
+        break;
+    case BenchState::Rotating:
+        if (!benchMotionActive(nowMs))
+        {
+            benchState = BenchState::PauseAfterRotate;
+            benchStateStartMs = nowMs;
+        }
+        break;
+    case BenchState::PauseAfterRotate:
+        if (nowMs - benchStateStartMs >= BENCH_PAUSE_MS)
+        {
+            benchState = BenchState::Idle;
+            return false;
+        }
+        break;
+    }
+    return true;
+}
+
+// 两种写法反复跑完整个序列，各取 5 轮中最快的一轮：脚本每次推进只比 switch 多一次间接调用与行号跳转，
+// 主机上两者都在几纳秒量级。上限放得很宽（额外开销小于 100 ns，单次推进小于 1 us），只为发现退化
+void test_step_overhead_matches_enum_switch()
+{
+    static constexpr int ROUNDS = 5;
+    static constexpr uint32_t TICKS = 2000000;
+    using Clock = std::chrono::steady_clock;
+    Behavior bench = {benchScript, nullptr, 0, false, 0};
+    double scriptNs = 1e9;
+    double switchNs = 1e9;
+    uint32_t scriptActions = 0;
+    uint32_t switchActions = 0;
+    for (int round = 0; round < ROUNDS; ++round)
+    {
+        benchActions = 0;
+        benchMotionEndMs = 0;
+        bench.running = false;
+        auto start = Clock::now();
+        for (uint32_t tick = 0; tick < TICKS; ++tick)
+        {
+            const uint32_t nowMs = tick * LOOP_MS;
+            if (!behaviorRunning(bench))
+            {
+                behaviorStart(bench, nowMs);
+            }
+            else
+            {
+                behaviorStep(bench, nowMs);
+            }
+        }
+        scriptNs = fmin(scriptNs, std::chrono::duration<double, std::nano>(Clock::now() - start).count() / TICKS);
+        scriptActions = benchActions;
+
+        benchActions = 0;
+        benchMotionEndMs = 0;
+        benchState = BenchState::Idle;
+        start = Clock::now();
+        for (uint32_t tick = 0; tick < TICKS; ++tick)
+        {
+            benchSwitchStep(tick * LOOP_MS);
+        }
+        switchNs = fmin(switchNs, std::chrono::duration<double, std::nano>(Clock::now() - start).count() / TICKS);
+        switchActions = benchActions;
+    }
+    char message[128];
+    snprintf(message, sizeof(message), "每次推进：脚本 %.2f ns，enum + switch %.2f ns（主机）", scriptNs, switchNs);
+    TEST_MESSAGE(message);
+    // 两种写法走过同样多的动作，计时的是同一件事
+    TEST_ASSERT_UINT32_WITHIN(2, switchActions, scriptActions);
+    TEST_ASSERT_TRUE(scriptNs < switchNs + 100.0);
+    TEST_ASSERT_TRUE(scriptNs < 1000.0);
+}
+
+int main(int, char **)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_start_runs_to_first_suspension);
+    RUN_TEST(test_sleep_durations_follow_caller_time);
+    RUN_TEST(test_sleep_across_wraparound);
+    RUN_TEST(test_restart_and_cancel);
+    RUN_TEST(test_independent_behaviors_interleave);
+    RUN_TEST(test_step_overhead_matches_enum_switch);
+    return UNITY_END();
+}
@@ -0,0 +1,161 @@
+// 启动流水线：依赖排序（失败同样解除依赖）、阶段计时与重叠后的总时长、报告格式，
+// 以及在另一个线程中结束阶段（设备上 IMU 校准在独立任务中完成）。
+#include <unity.h>
+#include <stdio.h>
+#include <string.h>
+#include <string>
+#include <thread>
+#include <vector>
+#include "boot.h"
+
+static std::vector<std::string> lines;
+
+static void collect(const char *line)
+{
+    lines.push_back(line);
+}
+
+static BootPhase phase(size_t i)
+{
+    return static_cast<BootPhase>(i);
+}
+
+void setUp()
+{
+    bootInit(1000);
+    lines.clear();
+}
+
+void tearDown()
+{
+}
+
+void test_dependencies_gate_runnable()
+{
+    TEST_ASSERT_TRUE(bootDependsOn(BootPhase::Imu, BootPhase::Display));
+    TEST_ASSERT_TRUE(bootDependsOn(BootPhase::Drive, BootPhase::Motors));
+    TEST_ASSERT_TRUE(bootDependsOn(BootPhase::Drive, BootPhase::Imu));
+    TEST_ASSERT_FALSE(bootDependsOn(BootPhase::Display, BootPhase::Imu));
+
+    TEST_ASSERT_TRUE(bootRunnable(BootPhase::Display));
+    TEST_ASSERT_FALSE(bootRunnable(BootPhase::Imu));
+    bootStart(BootPhase::Display, 1000);
+    TEST_ASSERT_FALSE(bootRunnable(BootPhase::Display)); // 已开始
+    TEST_ASSERT_FALSE(bootRunnable(BootPhase::Imu));
+    bootFinish(BootPhase::Display, 2000, true);
+    TEST_ASSERT_TRUE(bootRunnable(BootPhase::Imu));
+    TEST_ASSERT_FALSE(bootRunnable(BootPhase::Drive));
+}
+
+// 依赖失败也算结束：没有 IMU 时仍解除电机待机，小车以降级模式运行
+void test_failed_dependency_unblocks()
+{
+    bootStart(BootPhase::Motors, 1000);
+    bootFinish(BootPhase::Motors, 1500, true);
+    bootStart(BootPhase::Display, 1000);
+    bootFinish(BootPhase::Display, 3000, true);
+    bootStart(BootPhase::Imu, 3000);
+    bootFinish(BootPhase::Imu, 4000, false);
+    TEST_ASSERT_EQUAL(static_cast<int>(BootPhaseState::Failed), static_cast<int>(bootState(BootPhase::Imu)));
+    TEST_ASSERT_TRUE(bootRunnable(BootPhase::Drive));
+}
+
+// 按 setup() 的调度方式模拟：每轮启动所有可运行阶段，IMU 校准与其他阶段重叠
+void test_pipeline_overlaps_calibration()
+{
+    static const uint32_t DURATION_US[BOOT_PHASE_COUNT] = {5000, 80000, 10000000, 1000, 2000, 1000, 3000};
+    uint32_t endAt[BOOT_PHASE_COUNT] = {};
+    uint32_t nowUs = 1000;
+    int rounds = 0;
+    while (!bootComplete() && rounds < 1000)
+    {
+        for (size_t i = 0; i < BOOT_PHASE_COUNT; ++i)
+        {
+            if (bootRunnable(phase(i)))
+            {
+                bootStart(phase(i), nowUs);
+                endAt[i] = nowUs + DURATION_US[i];
+            }
+        }
+        // 推进到最早结束的运行中阶段
+        uint32_t next = UINT32_MAX;
+        for (size_t i = 0; i < BOOT_PHASE_COUNT; ++i)
+        {
+            if (bootState(phase(i)) == BootPhaseState::Running && endAt[i] < next)
+            {
+                next = endAt[i];
+            }
+        }
+        nowUs = next;
+        for (size_t i = 0; i < BOOT_PHASE_COUNT; ++i)
+        {
+            if (bootState(phase(i)) == BootPhaseState::Running && endAt[i] == nowUs)
+            {
+                bootFinish(phase(i), nowUs, true);
+            }
+        }
+        ++rounds;
+    }
+    TEST_ASSERT_TRUE(bootComplete());
+
+    uint32_t serial = 0;
+    for (uint32_t d : DURATION_US)
+    {
+        serial += d;
+    }
+    // 关键路径：显示 → IMU → 解除待机
+    const uint32_t critical = DURATION_US[1] + DURATION_US[2] + DURATION_US[5];
+    TEST_ASSERT_EQUAL_UINT32(critical, bootTotalUs());
+    TEST_ASSERT_EQUAL_UINT32(serial, bootSerialUs());
+    const BootTiming imu = bootGetTiming(BootPhase::Imu);
+    TEST_ASSERT_EQUAL_UINT32(DURATION_US[1], imu.startUs);
+    TEST_ASSERT_EQUAL_UINT32(0, bootGetTiming(BootPhase::Buttons).startUs);
+
+    bootReport(collect);
+    TEST_ASSERT_EQUAL(BOOT_PHASE_COUNT + 1, lines.size());
+    TEST_ASSERT_EQUAL_STRING("[boot] imu            80.0 ms ->  10080.0 ms  (10000.0 ms) ok", lines[2].c_str());
+    char expected[96];
+    snprintf(expected, sizeof(expected), "[boot] 总计 %.1f ms（串行需 %.1f ms）", critical / 1000.0, serial / 1000.0);
+    TEST_ASSERT_EQUAL_STRING(expected, lines.back().c_str());
+}
+
+void test_report_marks_unfinished_and_failed()
+{
+    bootStart(BootPhase::Display, 1000);
+    bootFinish(BootPhase::Display, 2000, false);
+    bootStart(BootPhase::Imu, 2000);
+    bootReport(collect);
+    TEST_ASSERT_NOT_NULL(strstr(lines[1].c_str(), "FAILED"));
+    TEST_ASSERT_NOT_NULL(strstr(lines[2].c_str(), "unfinished"));
+    TEST_ASSERT_NOT_NULL(strstr(lines[0].c_str(), "unfinished")); // 从未开始
+    TEST_ASSERT_FALSE(bootComplete());
+}
+
+// 校准任务在另一个线程结束 IMU 阶段，主线程轮询到后启动 Drive
+void test_finish_from_other_thread()
+{
+    bootStart(BootPhase::Motors, 1000);
+    bootFinish(BootPhase::Motors, 1100, true);
+    bootStart(BootPhase::Display, 1000);
+    bootFinish(BootPhase::Display, 1200, true);
+    bootStart(BootPhase::Imu, 1200);
+    std::thread calibration([]() { bootFinish(BootPhase::Imu, 5000, true); });
+    while (!bootRunnable(BootPhase::Drive))
+    {
+        std::this_thread::yield();
+    }
+    calibration.join();
+    TEST_ASSERT_EQUAL(static_cast<int>(BootPhaseState::Done), static_cast<int>(bootState(BootPhase::Imu)));
+    TEST_ASSERT_EQUAL_UINT32(4000, bootGetTiming(BootPhase::Imu).endUs);
+}
+
+int main(int, char **)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_dependencies_gate_runnable);
+    RUN_TEST(test_failed_dependency_unblocks);
+    RUN_TEST(test_pipeline_overlaps_calibration);
+    RUN_TEST(test_report_marks_unfinished_and_failed);
+    RUN_TEST(test_finish_from_other_thread);
+    return UNITY_END();
+}
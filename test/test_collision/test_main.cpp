@@ -0,0 +1,183 @@
+// 碰撞与堵转检测的合成轨迹评估：500 Hz 样本，行驶时叠加车轮振动与噪声。
+// 撞击为水平方向的半正弦减速脉冲，按峰值与持续时间扫描检出率与检出延迟（从脉冲开始到判定的样本时刻）；
+// 急刹、坑洼（竖直冲击）、停车时被推动与原地转向不应误报。
+#include <unity.h>
+#include <math.h>
+#include <stdio.h>
+#include "collision.h"
+
+static constexpr uint32_t SAMPLE_US = 2000;
+static constexpr float GRAVITY = 9.81f;
+static constexpr float PI_F = 3.14159265f;
+
+static uint32_t noiseState = 1;
+
+static float noise(float amplitude)
+{
+    noiseState = noiseState * 1664525u + 1013904223u;
+    return ((noiseState >> 8) / 16777216.0f * 2.0f - 1.0f) * amplitude;
+}
+
+struct Trace
+{
+    int commandA;
+    int commandB;
+    float vibration;    // 行驶振动幅值（m/s²），0 表示车身静止
+    float pulsePeak;    // 水平脉冲峰值（m/s²，负值为减速），0 表示没有
+    uint32_t pulseMs;   // 脉冲持续时间
+    float verticalPeak; // 竖直冲击峰值
+    float brakeDecel;   // 急刹：脉冲期间的平稳减速度（斜坡 100 ms）
+};
+
+struct Outcome
+{
+    CollisionKind kind;
+    int32_t delayUs; // 相对事件开始，未检出为 -1
+};
+
+static constexpr uint32_t EVENT_US = 1000000; // 事件在 1 s 时发生，之前为正常行驶
+
+static Outcome run(const Trace &trace, uint32_t durationUs)
+{
+    collisionReset();
+    noiseState = 7;
+    Outcome outcome = {CollisionKind::None, -1};
+    for (uint32_t t = 0; t < durationUs; t += SAMPLE_US)
+    {
+        const float s = t / 1e6f;
+        float accel[3] = {noise(0.05f), noise(0.05f), GRAVITY + noise(0.05f)};
+        float gyro[3] = {noise(0.5f), noise(0.5f), noise(0.5f)};
+        if (trace.vibration > 0.0f)
+        {
+            accel[0] += trace.vibration * 0.5f * sinf(2.0f * PI_F * 25.0f * s) + noise(0.4f);
+            accel[2] += trace.vibration * sinf(2.0f * PI_F * 25.0f * s + 0.3f) + noise(0.4f);
+            gyro[0] += 4.0f * sinf(2.0f * PI_F * 11.0f * s);
+        }
+        if (t >= EVENT_US)
+        {
+            const float since = (t - EVENT_US) / 1e6f;
+            const float pulseS = trace.pulseMs / 1000.0f;
+            if (trace.pulsePeak != 0.0f && since < pulseS)
+            {
+                accel[0] += trace.pulsePeak * sinf(PI_F * since / pulseS);
+            }
+            if (trace.verticalPeak != 0.0f && since < 0.015f)
+            {
+                accel[2] += trace.verticalPeak * sinf(PI_F * since / 0.015f);
+            }
+            if (trace.brakeDecel != 0.0f)
+            {
+                accel[0] -= trace.brakeDecel * fminf(since / 0.1f, 1.0f) * (since < 0.6f ? 1.0f : 0.0f);
+            }
+        }
+        const CollisionKind kind = collisionUpdate(t, accel, gyro, trace.commandA, trace.commandB);
+        if (kind != CollisionKind::None && outcome.kind == CollisionKind::None)
+        {
+            outcome.kind = kind;
+            outcome.delayUs = static_cast<int32_t>(t) - static_cast<int32_t>(EVENT_US);
+        }
+    }
+    return outcome;
+}
+
+void setUp()
+{
+}
+
+void tearDown()
+{
+}
+
+// 检出延迟：脉冲上升到阈值所需时间（行驶振动可能抵消一部分脉冲，按阈值加振动幅值计）加一个采样周期以内
+void test_bump_sweep_detection_and_delay()
+{
+    static const float PEAKS[] = {-8.0f, -12.0f, -20.0f, -30.0f};
+    static const uint32_t DURATIONS_MS[] = {10, 20, 40};
+    int detected = 0;
+    int total = 0;
+    int32_t worstDelayUs = 0;
+    for (float peak : PEAKS)
+    {
+        for (uint32_t durationMs : DURATIONS_MS)
+        {
+            const Trace trace = {150, 150, 1.5f, peak, durationMs, 0.0f, 0.0f};
+            const Outcome outcome = run(trace, 1500000);
+            ++total;
+            if (outcome.kind == CollisionKind::Bump)
+            {
+                ++detected;
+                worstDelayUs = outcome.delayUs > worstDelayUs ? outcome.delayUs : worstDelayUs;
+                const float crossMs = asinf(fminf((COLLISION_ACCEL_THRESHOLD + trace.vibration) / fabsf(peak), 1.0f)) / PI_F * durationMs;
+                TEST_ASSERT_LESS_OR_EQUAL(static_cast<int32_t>(crossMs * 1000.0f) + static_cast<int32_t>(SAMPLE_US), outcome.delayUs);
+            }
+            char message[96];
+            snprintf(message, sizeof(message), "峰值 %.0f m/s² 持续 %u ms：%s，延迟 %.1f ms", peak, static_cast<unsigned>(durationMs),
+                     outcome.kind == CollisionKind::Bump ? "检出" : "未检出", outcome.delayUs / 1000.0f);
+            TEST_MESSAGE(message);
+        }
+    }
+    char message[64];
+    snprintf(message, sizeof(message), "检出 %d/%d，最长延迟 %.1f ms", detected, total, worstDelayUs / 1000.0f);
+    TEST_MESSAGE(message);
+    TEST_ASSERT_EQUAL(total, detected);
+    // 最慢的是 8 m/s²、40 ms 的软碰撞（缓冲泡沫）：上升到阈值本身就要约 12 ms
+    TEST_ASSERT_LESS_OR_EQUAL(15000, worstDelayUs);
+}
+
+void test_no_false_positives()
+{
+    static const struct
+    {
+        const char *name;
+        Trace trace;
+    } CASES[] = {
+        {"正常行驶", {150, 150, 1.5f, 0.0f, 0, 0.0f, 0.0f}},
+        {"急刹 4 m/s²", {150, 150, 1.5f, 0.0f, 0, 0.0f, 4.0f}},
+        {"坑洼竖直冲击 25 m/s²", {150, 150, 1.5f, 0.0f, 0, 25.0f, 0.0f}},
+        {"停车时被推动", {0, 0, 0.0f, -20.0f, 20, 0.0f, 0.0f}},
+        {"原地转向", {150, -150, 0.0f, 0.0f, 0, 0.0f, 0.0f}},
+    };
+    for (const auto &c : CASES)
+    {
+        const Outcome outcome = run(c.trace, 3000000);
+        char message[96];
+        snprintf(message, sizeof(message), "%s：%s", c.name, collisionName(outcome.kind));
+        TEST_MESSAGE(message);
+        TEST_ASSERT_EQUAL(static_cast<int>(CollisionKind::None), static_cast<int>(outcome.kind));
+    }
+}
+
+// 两侧同向驱动而车身静止：持续 COLLISION_STALL_MS 后判定堵转（方差估计需要几个时间常数先收敛）
+void test_stall_detected_after_hold()
+{
+    const Trace trace = {150, 150, 0.0f, 0.0f, 0, 0.0f, 0.0f};
+    const Outcome outcome = run(trace, 2000000);
+    char message[64];
+    const int32_t detectedUs = outcome.delayUs + static_cast<int32_t>(EVENT_US); // 从开始驱动算起
+    snprintf(message, sizeof(message), "堵转判定于 %.0f ms", detectedUs / 1000.0f);
+    TEST_MESSAGE(message);
+    TEST_ASSERT_EQUAL(static_cast<int>(CollisionKind::Stall), static_cast<int>(outcome.kind));
+    TEST_ASSERT_GREATER_OR_EQUAL(static_cast<int32_t>(COLLISION_STALL_MS * 1000u), detectedUs);
+    TEST_ASSERT_LESS_OR_EQUAL(static_cast<int32_t>(COLLISION_STALL_MS * 1000u) + 200000, detectedUs);
+}
+
+void test_latency_metrics_track_bus_share()
+{
+    collisionReportLatency(900, 450);
+    collisionReportLatency(600, 200);
+    const CollisionMetrics &metrics = collisionGetMetrics();
+    TEST_ASSERT_EQUAL_UINT32(600, metrics.lastLatencyUs);
+    TEST_ASSERT_EQUAL_UINT32(900, metrics.maxLatencyUs);
+    TEST_ASSERT_EQUAL_UINT32(200, metrics.lastBusUs);
+    TEST_ASSERT_EQUAL_UINT32(450, metrics.maxBusUs);
+}
+
+int main(int, char **)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_bump_sweep_detection_and_delay);
+    RUN_TEST(test_no_false_positives);
+    RUN_TEST(test_stall_detected_after_hold);
+    RUN_TEST(test_latency_metrics_track_bus_share);
+    return UNITY_END();
+}
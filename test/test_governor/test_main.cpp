@@ -0,0 +1,384 @@
+// 调速器的停车距离仿真：小车沿直线驶向墙面（不转向），电机为一阶响应加死区，
+// 测距为一组两次一致的连续测量（间隔 SONAR_PING_GAP_MS，结果取两次的平均，在第二次测量时给出），
+// 组间再隔一个测量周期；调速器每 5 ms 更新；stop 时停车（由避障接管），记录离墙最近距离。
+// 对照仿真：在方形房间内用同样的测距与电机模型分别运行原固定区间逻辑（45 cm 内差速转弯、25 cm 内后退）
+// 与调速器，停车后都执行同一套后退-暂停-原地转 45°-暂停的避障流程，比较平均前进速度与后退次数。
+#include <unity.h>
+#include <math.h>
+#include <stdio.h>
+#include "governor.h"
+#include "sonar.h"
+
+static constexpr uint32_t LOOP_MS = 5;
+static constexpr uint32_t RANGE_INTERVAL_MS = 2 * SONAR_PING_GAP_MS;
+static constexpr uint32_t RANGE_LATENCY_MS = SONAR_PING_GAP_MS;
+static constexpr float TAU_S = 0.1f;
+static constexpr float FULL_SPEED_CM_S = 100.0f; // 与 GOVERNOR_DEFAULT_CONFIG 的估计一致
+
+struct Approach
+{
+    bool stopped;
+    bool stalled;
+    uint32_t stopMs;      // 从起步到 stop 的时间
+    float stopRawCm;      // stop 时刻的真实距离
+    float minDistanceCm;  // 停车后滑行结束时离墙的距离
+    float maxSpeedCmS;
+};
+
+// deadband：低于该占空比车轮不转（地毯、爬坡时更高）
+static Approach approach(int levelSpeed, float startCm, int deadband, uint32_t limitMs)
+{
+    governorConfigure(GOVERNOR_DEFAULT_CONFIG);
+    governorReset(0);
+    governorObserve(0, -1.0f);
+    Approach result = {false, false, 0, 0.0f, startCm, 0.0f};
+    float distanceCm = startCm;
+    float speedCmS = 0.0f;
+    float pendingCm = -1.0f; // 本组第一次测量的距离，组结束前为正
+    uint32_t pendingAtMs = 0;
+    int throttle = 0;
+    for (uint32_t nowMs = 0; nowMs < limitMs; nowMs += LOOP_MS)
+    {
+        if (nowMs % RANGE_INTERVAL_MS == 0)
+        {
+            pendingCm = distanceCm;
+            pendingAtMs = nowMs + RANGE_LATENCY_MS;
+        }
+        if (pendingCm >= 0.0f && nowMs >= pendingAtMs)
+        {
+            governorObserve(nowMs, (pendingCm + distanceCm) * 0.5f);
+            pendingCm = -1.0f;
+        }
+        if (!result.stopped)
+        {
+            const GovernorOutput out = governorUpdate(nowMs, levelSpeed);
+            throttle = out.throttle;
+            if (out.stop)
+            {
+                result = {true, out.stalled, nowMs, distanceCm, distanceCm, result.maxSpeedCmS};
+                throttle = 0;
+            }
+        }
+        const float target = throttle < deadband ? 0.0f : FULL_SPEED_CM_S * throttle / 255.0f;
+        speedCmS += (target - speedCmS) * (LOOP_MS / 1000.0f) / (TAU_S + LOOP_MS / 1000.0f);
+        distanceCm -= speedCmS * LOOP_MS / 1000.0f;
+        result.maxSpeedCmS = fmaxf(result.maxSpeedCmS, speedCmS);
+        result.minDistanceCm = fminf(result.minDistanceCm, distanceCm);
+    }
+    return result;
+}
+
+// ---- 对照仿真 ----
+static constexpr float ROOM_CM = 600.0f;     // 后退 3 s 不会撞到背后的墙
+static constexpr float SONAR_RANGE_CM = 400.0f; // 超出量程视为无回波
+static constexpr float TRACK_CM = 15.0f;    // 左右轮距
+static constexpr float BUMPER_CM = 5.0f;    // 车头到测距中心的距离，小于该值视为碰撞
+static constexpr float LEGACY_STOP_CM = 25.0f;
+static constexpr float LEGACY_TURN_CM = 45.0f;
+static constexpr float LEGACY_TURN_RATIO = 0.7f;
+static constexpr uint32_t REVERSE_MS = 3000; // 与 main.cpp 的避障脚本一致
+static constexpr uint32_t PAUSE_MS = 2000;
+static constexpr float ROTATE_RAD = 45.0f * 3.14159265f / 180.0f;
+
+struct Room
+{
+    float x;
+    float y;
+    float heading; // 弧度，0 指向 +x，右转为负
+    float left;    // 左右轮车速 cm/s
+    float right;
+};
+
+// 沿车头方向到墙面的距离
+static float rayToWall(const Room &room)
+{
+    const float dx = cosf(room.heading);
+    const float dy = sinf(room.heading);
+    float best = 1e9f;
+    if (dx > 1e-6f)
+    {
+        best = fminf(best, (ROOM_CM - room.x) / dx);
+    }
+    else if (dx < -1e-6f)
+    {
+        best = fminf(best, -room.x / dx);
+    }
+    if (dy > 1e-6f)
+    {
+        best = fminf(best, (ROOM_CM - room.y) / dy);
+    }
+    else if (dy < -1e-6f)
+    {
+        best = fminf(best, -room.y / dy);
+    }
+    return best;
+}
+
+static float wheelStep(float speedCmS, int command, int deadband)
+{
+    const int magnitude = command < 0 ? -command : command;
+    const float target = magnitude < deadband ? 0.0f : FULL_SPEED_CM_S * command / 255.0f;
+    return speedCmS + (target - speedCmS) * (LOOP_MS / 1000.0f) / (TAU_S + LOOP_MS / 1000.0f);
+}
+
+enum class AvoidStep
+{
+    None,
+    Reversing,
+    PauseAfterReverse,
+    Rotating,
+    PauseAfterRotate
+};
+
+struct Tour
+{
+    float meanSpeedCmS; // 平均前进速度（后退计为负）
+    int reversals;      // 进入避障（后退）的次数
+    int collisions;     // 其中因碰撞触发的次数
+};
+
+// governed 为 false 时运行原固定区间逻辑
+static Tour tour(bool governed, int levelSpeed, float startHeading, uint32_t limitMs)
+{
+    static constexpr int DEADBAND = 60;
+    governorConfigure(GOVERNOR_DEFAULT_CONFIG);
+    governorReset(0);
+    governorObserve(0, -1.0f);
+    Room room = {ROOM_CM / 2.0f, ROOM_CM / 2.0f, startHeading, 0.0f, 0.0f};
+    Tour result = {0.0f, 0, 0};
+    AvoidStep step = AvoidStep::None;
+    uint32_t stepStartMs = 0;
+    float rotateStart = 0.0f;
+    int commandLeft = levelSpeed;
+    int commandRight = levelSpeed;
+    bool wasGoverning = false;
+    float pendingCm = -1.0f;
+    uint32_t pendingAtMs = 0;
+    double travelled = 0.0;
+    for (uint32_t nowMs = 0; nowMs < limitMs; nowMs += LOOP_MS)
+    {
+        float freshCm = -1.0f;
+        if (nowMs % RANGE_INTERVAL_MS == 0)
+        {
+            pendingCm = fminf(rayToWall(room), SONAR_RANGE_CM);
+            pendingAtMs = nowMs + RANGE_LATENCY_MS;
+        }
+        if (pendingCm >= 0.0f && nowMs >= pendingAtMs)
+        {
+            const float secondCm = rayToWall(room);
+            freshCm = secondCm < SONAR_RANGE_CM && pendingCm < SONAR_RANGE_CM ? (pendingCm + secondCm) * 0.5f : -1.0f;
+            governorObserve(nowMs, freshCm);
+            pendingCm = -1.0f;
+        }
+
+        bool startAvoid = false;
+        if (step == AvoidStep::None)
+        {
+            if (governed)
+            {
+                if (!wasGoverning)
+                {
+                    governorReset((commandLeft + commandRight) / 2);
+                }
+                const GovernorOutput out = governorUpdate(nowMs, levelSpeed);
+                commandLeft = out.throttle + out.turn; // 两轮时混控不会超出 255
+                commandRight = out.throttle - out.turn;
+                startAvoid = out.stop || (freshCm > 0.0f && freshCm < GOVERNOR_DEFAULT_CONFIG.stopDistanceCm);
+                wasGoverning = true;
+            }
+            else if (freshCm > 0.0f)
+            {
+                // 原逻辑只在拿到有效测距时切换区间，无回波时保持上一区间
+                if (freshCm < LEGACY_STOP_CM)
+                {
+                    startAvoid = true;
+                }
+                else if (freshCm < LEGACY_TURN_CM)
+                {
+                    commandLeft = levelSpeed;
+                    commandRight = static_cast<int>(levelSpeed * LEGACY_TURN_RATIO);
+                }
+                else
+                {
+                    commandLeft = levelSpeed;
+                    commandRight = levelSpeed;
+                }
+            }
+            if (rayToWall(room) < BUMPER_CM && !startAvoid)
+            {
+                startAvoid = true;
+                ++result.collisions;
+            }
+            if (startAvoid)
+            {
+                ++result.reversals;
+                step = AvoidStep::Reversing;
+                stepStartMs = nowMs;
+                commandLeft = -levelSpeed;
+                commandRight = -levelSpeed;
+            }
+        }
+        else
+        {
+            wasGoverning = false;
+            switch (step)
+            {
+            case AvoidStep::Reversing:
+                if (nowMs - stepStartMs >= REVERSE_MS)
+                {
+                    step = AvoidStep::PauseAfterReverse;
+                    stepStartMs = nowMs;
+                    commandLeft = commandRight = 0;
+                }
+                break;
+            case AvoidStep::PauseAfterReverse:
+                if (nowMs - stepStartMs >= PAUSE_MS)
+                {
+                    step = AvoidStep::Rotating;
+                    rotateStart = room.heading;
+                    commandLeft = levelSpeed;
+                    commandRight = -levelSpeed;
+                }
+                break;
+            case AvoidStep::Rotating:
+                if (rotateStart - room.heading >= ROTATE_RAD)
+                {
+                    step = AvoidStep::PauseAfterRotate;
+                    stepStartMs = nowMs;
+                    commandLeft = commandRight = 0;
+                }
+                break;
+            case AvoidStep::PauseAfterRotate:
+                if (nowMs - stepStartMs >= PAUSE_MS)
+                {
+                    step = AvoidStep::None;
+                    commandLeft = commandRight = levelSpeed;
+                }
+                break;
+            case AvoidStep::None:
+                break;
+            }
+        }
+
+        room.left = wheelStep(room.left, commandLeft, DEADBAND);
+        room.right = wheelStep(room.right, commandRight, DEADBAND);
+        // 顶住墙时位置不变，只计实际位移在车头方向上的分量
+        const float forward = (room.left + room.right) * 0.5f;
+        room.heading -= (room.left - room.right) / TRACK_CM * (LOOP_MS / 1000.0f);
+        const float x = fminf(fmaxf(room.x + forward * cosf(room.heading) * LOOP_MS / 1000.0f, 0.0f), ROOM_CM);
+        const float y = fminf(fmaxf(room.y + forward * sinf(room.heading) * LOOP_MS / 1000.0f, 0.0f), ROOM_CM);
+        travelled += (x - room.x) * cosf(room.heading) + (y - room.y) * sinf(room.heading);
+        room.x = x;
+        room.y = y;
+    }
+    result.meanSpeedCmS = static_cast<float>(travelled / (limitMs / 1000.0));
+    return result;
+}
+
+void setUp()
+{
+}
+
+void tearDown()
+{
+}
+
+// 各档速度：stop 发生在真实距离接近停车距离处，停车后滑行不碰墙
+void test_stops_before_wall_at_each_level()
+{
+    static const int LEVELS[] = {120, 180, 255};
+    const float stopCm = GOVERNOR_DEFAULT_CONFIG.stopDistanceCm;
+    for (int level : LEVELS)
+    {
+        const Approach result = approach(level, 200.0f, 60, 20000);
+        char message[128];
+        snprintf(message, sizeof(message), "档位 %d：%u ms 停车，停车时距离 %.1f cm，滑行后 %.1f cm，最高车速 %.0f cm/s", level,
+                 static_cast<unsigned>(result.stopMs), result.stopRawCm, result.minDistanceCm, result.maxSpeedCmS);
+        TEST_MESSAGE(message);
+        TEST_ASSERT_TRUE(result.stopped);
+        TEST_ASSERT_FALSE(result.stalled);
+        // 预估距离计入延迟，停车时的真实距离不低于停车距离减去一个测距周期的蠕行量
+        TEST_ASSERT_GREATER_THAN_FLOAT(stopCm - 3.0f, result.stopRawCm);
+        TEST_ASSERT_LESS_THAN_FLOAT(stopCm + 10.0f, result.stopRawCm);
+        TEST_ASSERT_GREATER_THAN_FLOAT(stopCm / 2.0f, result.minDistanceCm);
+    }
+}
+
+// 蠕行速度推不动小车：距离停在停车距离之外，必须按卡住停车，否则永远不会交给避障
+void test_stall_at_creep_speed_stops()
+{
+    const GovernorMetrics before = governorGetMetrics();
+    const Approach result = approach(180, 200.0f, 100, 20000);
+    char message[128];
+    snprintf(message, sizeof(message), "死区 100：%u ms 按卡住停车，距离 %.1f cm", static_cast<unsigned>(result.stopMs), result.stopRawCm);
+    TEST_MESSAGE(message);
+    TEST_ASSERT_TRUE(result.stopped);
+    TEST_ASSERT_TRUE(result.stalled);
+    TEST_ASSERT_GREATER_THAN_FLOAT(GOVERNOR_DEFAULT_CONFIG.stopDistanceCm, result.stopRawCm);
+    TEST_ASSERT_LESS_THAN_FLOAT(GOVERNOR_DEFAULT_CONFIG.steerDistanceCm, result.stopRawCm);
+    TEST_ASSERT_EQUAL_UINT32(before.stalls + 1, governorGetMetrics().stalls);
+}
+
+// 前方空旷：不限速、不停车
+void test_open_road_is_not_limited()
+{
+    governorConfigure(GOVERNOR_DEFAULT_CONFIG);
+    governorReset(0);
+    governorObserve(0, -1.0f);
+    GovernorOutput out = {};
+    for (uint32_t nowMs = 0; nowMs < 3000; nowMs += LOOP_MS)
+    {
+        out = governorUpdate(nowMs, 200);
+    }
+    TEST_ASSERT_EQUAL(200, out.throttle);
+    TEST_ASSERT_EQUAL(0, out.turn);
+    TEST_ASSERT_FALSE(out.stop);
+    TEST_ASSERT_FALSE(out.limited);
+}
+
+// 同一房间、同一起点与朝向：调速器靠减速和差速提前绕开，平均前进速度不低于原逻辑，后退更少
+void test_governor_beats_fixed_bands()
+{
+    static const int LEVELS[] = {150, 200, 255};
+    static const float HEADINGS[] = {0.0f, 0.4f, -0.9f};
+    for (int level : LEVELS)
+    {
+        float legacySpeed = 0.0f;
+        float governorSpeed = 0.0f;
+        int legacyReversals = 0;
+        int governorReversals = 0;
+        int legacyCollisions = 0;
+        int governorCollisions = 0;
+        for (float heading : HEADINGS)
+        {
+            const Tour legacy = tour(false, level, heading, 60000);
+            const Tour governed = tour(true, level, heading, 60000);
+            legacySpeed += legacy.meanSpeedCmS;
+            governorSpeed += governed.meanSpeedCmS;
+            legacyReversals += legacy.reversals;
+            legacyCollisions += legacy.collisions;
+            governorReversals += governed.reversals;
+            governorCollisions += governed.collisions;
+        }
+        const float count = sizeof(HEADINGS) / sizeof(HEADINGS[0]);
+        legacySpeed /= count;
+        governorSpeed /= count;
+        char message[160];
+        snprintf(message, sizeof(message), "档位 %d：原逻辑 %.1f cm/s 后退 %d 次（碰撞 %d），调速器 %.1f cm/s 后退 %d 次（碰撞 %d）", level,
+                 legacySpeed, legacyReversals, legacyCollisions, governorSpeed, governorReversals, governorCollisions);
+        TEST_MESSAGE(message);
+        TEST_ASSERT_TRUE(governorSpeed >= legacySpeed);
+        TEST_ASSERT_LESS_THAN(legacyReversals, governorReversals);
+        TEST_ASSERT_EQUAL(0, governorCollisions);
+    }
+}
+
+int main(int, char **)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_stops_before_wall_at_each_level);
+    RUN_TEST(test_stall_at_creep_speed_stops);
+    RUN_TEST(test_open_road_is_not_limited);
+    RUN_TEST(test_governor_beats_fixed_bands);
+    return UNITY_END();
+}
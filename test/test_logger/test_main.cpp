@@ -0,0 +1,225 @@
+// 延迟日志队列：满队列的丢弃计数、丢弃提示行、输出顺序、最高占用与占位符格式化；
+// 多个生产者线程并发写入时，入队 + 丢弃 = 尝试次数，排空后输出数 = 入队数；
+// 热路径（入队、队列满丢弃）与输出任务格式化的单次耗时（主机计时）。
+#include <unity.h>
+#include <stdio.h>
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+#include "logger.h"
+
+static std::vector<std::string> lines;
+
+static void collect(const char *line)
+{
+    lines.push_back(line);
+}
+
+static void drainAll()
+{
+    while (logDrain(collect, LOG_QUEUE_SIZE) > 0)
+    {
+    }
+}
+
+static uint32_t fakeNowMs = 0;
+
+static uint32_t fakeClock()
+{
+    return fakeNowMs;
+}
+
+void setUp()
+{
+    drainAll(); // 上一个用例留下的条目
+    lines.clear();
+    fakeNowMs = 0;
+    logSetClock(fakeClock);
+}
+
+void tearDown()
+{
+}
+
+void test_format_placeholders()
+{
+    const LogArg args[] = {logArg(42), logArg(-1.5f), logArg("abc")};
+    char out[LOG_LINE_MAX];
+    logFormat(out, sizeof(out), LOG_LEVEL_WARN, 1234, "a={} b={} c={} d={}", args, 3);
+    TEST_ASSERT_EQUAL_STRING("[1234 W] a=42 b=-1.50 c=abc d={}", out);
+
+    // 无符号参数超过 INT32_MAX 时按无符号输出
+    const LogArg wide[] = {logArg(3000000000UL), logArg(4294967295U), logArg(-7L)};
+    logFormat(out, sizeof(out), LOG_LEVEL_INFO, 0, "{} {} {}", wide, 3);
+    TEST_ASSERT_EQUAL_STRING("[0 I] 3000000000 4294967295 -7", out);
+
+    // 截断时仍以 '\0' 结尾
+    char small[12];
+    const size_t n = logFormat(small, sizeof(small), LOG_LEVEL_INFO, 7, "0123456789", args, 0);
+    TEST_ASSERT_EQUAL(sizeof(small) - 1, n);
+    TEST_ASSERT_EQUAL_STRING("[7 I] 01234", small);
+}
+
+void test_full_queue_counts_drops_and_reports_once()
+{
+    const LogStats before = logGetStats();
+    fakeNowMs = 500;
+    const int extra = 10;
+    for (int i = 0; i < static_cast<int>(LOG_QUEUE_SIZE) + extra; ++i)
+    {
+        LOG_INFO("第 {} 条", i);
+    }
+    const LogStats full = logGetStats();
+    TEST_ASSERT_EQUAL_UINT32(LOG_QUEUE_SIZE, full.pushed - before.pushed);
+    TEST_ASSERT_EQUAL_UINT32(extra, full.dropped - before.dropped);
+    TEST_ASSERT_EQUAL_UINT32(LOG_QUEUE_SIZE, full.highWater);
+
+    drainAll();
+    // 第一行是丢弃提示，其后按入队顺序输出，丢弃的是最后 extra 条
+    TEST_ASSERT_EQUAL(LOG_QUEUE_SIZE + 1, lines.size());
+    char expected[64];
+    snprintf(expected, sizeof(expected), "[log] 队列已满，丢弃 %d 条", extra);
+    TEST_ASSERT_EQUAL_STRING(expected, lines[0].c_str());
+    TEST_ASSERT_EQUAL_STRING("[500 I] 第 0 条", lines[1].c_str());
+    snprintf(expected, sizeof(expected), "[500 I] 第 %d 条", static_cast<int>(LOG_QUEUE_SIZE) - 1);
+    TEST_ASSERT_EQUAL_STRING(expected, lines.back().c_str());
+
+    const LogStats after = logGetStats();
+    TEST_ASSERT_EQUAL_UINT32(full.pushed - before.pushed, after.emitted - before.emitted);
+
+    // 丢弃提示只报告新增部分：没有新的丢弃时不再出现
+    lines.clear();
+    LOG_INFO("恢复");
+    drainAll();
+    TEST_ASSERT_EQUAL(1, lines.size());
+}
+
+void test_drain_respects_max_lines()
+{
+    for (int i = 0; i < 5; ++i)
+    {
+        LOG_WARN("w{}", i);
+    }
+    TEST_ASSERT_EQUAL(2, logDrain(collect, 2));
+    TEST_ASSERT_EQUAL(3, logDrain(collect, 8));
+    TEST_ASSERT_EQUAL(0, logDrain(collect, 8));
+    TEST_ASSERT_EQUAL(5, lines.size());
+    TEST_ASSERT_EQUAL_STRING("[0 W] w4", lines[4].c_str());
+}
+
+// 4 个生产者并发写入，同时有消费者排空：任何一条要么入队要么计入丢弃，入队的最终都会输出
+void test_concurrent_producers_account_every_push()
+{
+    static constexpr int PRODUCERS = 4;
+    static constexpr int PER_PRODUCER = 20000;
+    const LogStats before = logGetStats();
+    std::atomic<int> running(PRODUCERS);
+    std::vector<std::thread> producers;
+    for (int p = 0; p < PRODUCERS; ++p)
+    {
+        producers.emplace_back([p, &running]() {
+            for (int i = 0; i < PER_PRODUCER; ++i)
+            {
+                LOG_INFO("p{} {}", p, i);
+                if (i % 32 == 0)
+                {
+                    std::this_thread::yield(); // 设备上生产者按控制周期写日志，不会连续占满
+                }
+            }
+            --running;
+        });
+    }
+    size_t consumed = 0;
+    while (running.load() > 0)
+    {
+        lines.clear();
+        consumed += logDrain(collect, 16);
+    }
+    for (std::thread &t : producers)
+    {
+        t.join();
+    }
+    lines.clear();
+    size_t n;
+    while ((n = logDrain(collect, LOG_QUEUE_SIZE)) > 0)
+    {
+        consumed += n;
+    }
+
+    const LogStats after = logGetStats();
+    const uint32_t pushed = after.pushed - before.pushed;
+    const uint32_t dropped = after.dropped - before.dropped;
+    char message[96];
+    snprintf(message, sizeof(message), "入队 %u，丢弃 %u，输出 %u", static_cast<unsigned>(pushed), static_cast<unsigned>(dropped),
+             static_cast<unsigned>(consumed));
+    TEST_MESSAGE(message);
+    TEST_ASSERT_EQUAL_UINT32(PRODUCERS * PER_PRODUCER, pushed + dropped);
+    TEST_ASSERT_EQUAL_UINT32(pushed, consumed);
+    TEST_ASSERT_EQUAL_UINT32(pushed, after.emitted - before.emitted);
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32(LOG_QUEUE_SIZE, after.highWater);
+}
+
+static void discard(const char *)
+{
+}
+
+// 热路径只拷贝指针与参数：入队与丢弃每次都应远小于 1 us（主机上为十几到几十 ns），
+// 格式化在输出任务中完成，单条也应在 20 us 以内。上限放得很宽，只为发现退化成加锁或格式化。
+void test_enqueue_and_drop_paths_are_cheap()
+{
+    static constexpr int ROUNDS = 2000;
+    using Clock = std::chrono::steady_clock;
+    Clock::duration enqueueTime(0);
+    Clock::duration drainTime(0);
+    for (int r = 0; r < ROUNDS; ++r)
+    {
+        const auto start = Clock::now();
+        for (size_t i = 0; i < LOG_QUEUE_SIZE; ++i)
+        {
+            LOG_INFO("t={} v={} s={}", r, 1.25f, "ok");
+        }
+        const auto filled = Clock::now();
+        logDrain(discard, LOG_QUEUE_SIZE);
+        enqueueTime += filled - start;
+        drainTime += Clock::now() - filled;
+    }
+
+    for (size_t i = 0; i < LOG_QUEUE_SIZE; ++i)
+    {
+        LOG_INFO("fill {}", static_cast<int>(i));
+    }
+    const LogStats before = logGetStats();
+    const auto dropStart = Clock::now();
+    for (int r = 0; r < ROUNDS * static_cast<int>(LOG_QUEUE_SIZE); ++r)
+    {
+        LOG_INFO("t={} v={} s={}", r, 1.25f, "ok");
+    }
+    const auto dropTime = Clock::now() - dropStart;
+    const LogStats after = logGetStats();
+    drainAll();
+
+    const double calls = static_cast<double>(ROUNDS) * LOG_QUEUE_SIZE;
+    const double enqueueNs = std::chrono::duration<double, std::nano>(enqueueTime).count() / calls;
+    const double dropNs = std::chrono::duration<double, std::nano>(dropTime).count() / calls;
+    const double drainNs = std::chrono::duration<double, std::nano>(drainTime).count() / calls;
+    char message[128];
+    snprintf(message, sizeof(message), "入队 %.1f ns/条，丢弃 %.1f ns/条，格式化 %.1f ns/条（主机）", enqueueNs, dropNs, drainNs);
+    TEST_MESSAGE(message);
+    TEST_ASSERT_EQUAL_UINT32(ROUNDS * LOG_QUEUE_SIZE, after.dropped - before.dropped);
+    TEST_ASSERT_TRUE(enqueueNs < 1000.0);
+    TEST_ASSERT_TRUE(dropNs < 1000.0);
+    TEST_ASSERT_TRUE(drainNs < 20000.0);
+}
+
+int main(int, char **)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_format_placeholders);
+    RUN_TEST(test_full_queue_counts_drops_and_reports_once);
+    RUN_TEST(test_drain_respects_max_lines);
+    RUN_TEST(test_concurrent_producers_account_every_push);
+    RUN_TEST(test_enqueue_and_drop_paths_are_cheap);
+    return UNITY_END();
+}
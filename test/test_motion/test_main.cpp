@@ -0,0 +1,189 @@
+// 运动原语的动力学模型检查：一阶电机响应、刹车时减速度受限（滑行），输出延迟一个控制周期。
+// 调用方式与直接使用原语的代码相同：只在 motionUpdate 返回 true 时把输出交给电机。
+#include <unity.h>
+#include <math.h>
+#include <stdio.h>
+#include "motion.h"
+
+static constexpr uint32_t LOOP_MS = 5;
+static constexpr float FULL_SPEED_MPS = 1.0f;
+static constexpr float FULL_RATE_DPS = 360.0f;
+static constexpr float TAU_S = 0.08f;
+static constexpr float DRIVE_DECEL_MPS2 = 1.5f;
+static constexpr float ROTATE_DECEL_DPS2 = 600.0f;
+static constexpr int DEADBAND = 40;
+
+struct Vehicle
+{
+    uint32_t nowMs;
+    float odometerM;
+    float speedMps; // 带符号
+    float yaw;
+    float yawRate;
+    int speedA; // 当前施加的电机命令
+    int speedB;
+};
+
+static float approachValue(float value, float target, float dt, float decelLimit)
+{
+    float step = (target - value) * dt / (TAU_S + dt);
+    // 目标幅值更小（减速/刹车）时受最大减速度限制
+    if (fabsf(target) < fabsf(value) && fabsf(step) > decelLimit * dt)
+    {
+        step = step > 0.0f ? decelLimit * dt : -decelLimit * dt;
+    }
+    return value + step;
+}
+
+static float command(int speed)
+{
+    return abs(speed) < DEADBAND ? 0.0f : speed / 255.0f;
+}
+
+static void step(Vehicle &v)
+{
+    const float dt = LOOP_MS / 1000.0f;
+    const float a = command(v.speedA);
+    const float b = command(v.speedB);
+    v.speedMps = approachValue(v.speedMps, (a + b) * 0.5f * FULL_SPEED_MPS, dt, DRIVE_DECEL_MPS2);
+    v.yawRate = approachValue(v.yawRate, (a - b) * 0.5f * FULL_RATE_DPS, dt, ROTATE_DECEL_DPS2);
+    v.odometerM += fabsf(v.speedMps) * dt;
+    v.yaw += v.yawRate * dt;
+    v.nowMs += LOOP_MS;
+}
+
+static MotionInput input(const Vehicle &v)
+{
+    return {v.nowMs, v.yaw, v.yawRate, v.odometerM, fabsf(v.speedMps)};
+}
+
+// 推进到原语结束（或超时），返回结束时刻
+static uint32_t run(Vehicle &v, uint32_t limitMs)
+{
+    const uint32_t startMs = v.nowMs;
+    while (v.nowMs - startMs < limitMs)
+    {
+        MotionOutput out;
+        if (motionUpdate(input(v), &out))
+        {
+            v.speedA = out.speedA;
+            v.speedB = out.speedB;
+        }
+        if (!motionActive())
+        {
+            return v.nowMs - startMs;
+        }
+        step(v);
+    }
+    return limitMs;
+}
+
+static void settleVehicle(Vehicle &v)
+{
+    for (int i = 0; i < 400; ++i)
+    {
+        step(v);
+    }
+}
+
+static Vehicle vehicle = {};
+
+void setUp()
+{
+    vehicle = {1000, 0.0f, 0.0f, 0.0f, 0.0f, 0, 0};
+    motionCancel();
+}
+
+void tearDown()
+{
+}
+
+// 原语结束时最后一次输出必须是零：直接调用者据此停车
+void test_drive_distance_ends_with_zero_output()
+{
+    motionDriveDistance(input(vehicle), 200, 0.5f);
+    const uint32_t durationMs = run(vehicle, 5000);
+    TEST_ASSERT_LESS_THAN_UINT32(5000, durationMs);
+    TEST_ASSERT_EQUAL(0, vehicle.speedA);
+    TEST_ASSERT_EQUAL(0, vehicle.speedB);
+    MotionOutput out;
+    TEST_ASSERT_FALSE(motionUpdate(input(vehicle), &out));
+}
+
+// 定距行驶在车速降到静止阈值以下才结束，超调按静止后的实际位置计算
+void test_drive_distance_settles_on_speed()
+{
+    static const struct
+    {
+        int speed;
+        float distanceM;
+    } CASES[] = {{150, 0.3f}, {200, 0.5f}, {255, 1.0f}};
+    for (const auto &c : CASES)
+    {
+        setUp();
+        motionDriveDistance(input(vehicle), c.speed, c.distanceM);
+        const uint32_t durationMs = run(vehicle, 8000);
+        TEST_ASSERT_LESS_OR_EQUAL_FLOAT(MOTION_SETTLE_SPEED_MPS, fabsf(vehicle.speedMps));
+        const MotionMetrics &metrics = motionGetMetrics();
+        const float endM = vehicle.odometerM;
+        settleVehicle(vehicle);
+        char message[128];
+        snprintf(message, sizeof(message), "速度 %d 目标 %.2f m：%u ms 完成，超调 %+.1f mm（静止后再滑行 %.1f mm）", c.speed, c.distanceM,
+                 static_cast<unsigned>(durationMs), metrics.lastOvershootM * 1000.0f, (vehicle.odometerM - endM) * 1000.0f);
+        TEST_MESSAGE(message);
+        TEST_ASSERT_EQUAL_UINT32(durationMs, metrics.lastDurationMs);
+        TEST_ASSERT_FLOAT_WITHIN(0.002f, vehicle.odometerM - c.distanceM, metrics.lastOvershootM);
+        TEST_ASSERT_FLOAT_WITHIN(0.03f, 0.0f, metrics.lastOvershootM);
+        TEST_ASSERT_LESS_THAN_UINT32(static_cast<uint32_t>(c.distanceM / (FULL_SPEED_MPS * c.speed / 255.0f) * 1000.0f) + 1500, durationMs);
+    }
+}
+
+void test_rotate_settles_and_reports_overshoot()
+{
+    static const float TARGETS[] = {45.0f, -90.0f, 180.0f};
+    for (float target : TARGETS)
+    {
+        setUp();
+        motionRotateBy(input(vehicle), 180, target);
+        const uint32_t durationMs = run(vehicle, 5000);
+        TEST_ASSERT_LESS_OR_EQUAL_FLOAT(MOTION_SETTLE_RATE_DPS, fabsf(vehicle.yawRate));
+        TEST_ASSERT_EQUAL(0, vehicle.speedA);
+        const MotionMetrics &metrics = motionGetMetrics();
+        char message[128];
+        snprintf(message, sizeof(message), "转向 %+.0f°：%u ms 完成，超调 %+.2f°，减速度估计 %.0f°/s²", target,
+                 static_cast<unsigned>(durationMs), metrics.lastOvershootDeg, metrics.rotateDecelDps2);
+        TEST_MESSAGE(message);
+        TEST_ASSERT_FLOAT_WITHIN(0.5f, fabsf(vehicle.yaw) - fabsf(target), metrics.lastOvershootDeg);
+        TEST_ASSERT_FLOAT_WITHIN(4.0f, 0.0f, metrics.lastOvershootDeg);
+    }
+}
+
+void test_drive_for_ends_with_zero_output()
+{
+    motionDriveFor(vehicle.nowMs, -200, 1000);
+    const uint32_t durationMs = run(vehicle, 3000);
+    TEST_ASSERT_UINT32_WITHIN(LOOP_MS, 1000, durationMs);
+    TEST_ASSERT_EQUAL(0, vehicle.speedA);
+    TEST_ASSERT_EQUAL(0, vehicle.speedB);
+}
+
+void test_cancel_stops_without_output()
+{
+    motionDriveDistance(input(vehicle), 200, 1.0f);
+    run(vehicle, 200);
+    motionCancel();
+    MotionOutput out;
+    TEST_ASSERT_FALSE(motionUpdate(input(vehicle), &out));
+    TEST_ASSERT_FALSE(motionActive());
+}
+
+int main(int, char **)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_drive_distance_ends_with_zero_output);
+    RUN_TEST(test_drive_distance_settles_on_speed);
+    RUN_TEST(test_rotate_settles_and_reports_overshoot);
+    RUN_TEST(test_drive_for_ends_with_zero_output);
+    RUN_TEST(test_cancel_stops_without_output);
+    return UNITY_END();
+}
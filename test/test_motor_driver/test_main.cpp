@@ -0,0 +1,236 @@
+// 电机驱动层真值表：用记录引脚电平与 PWM 占空比的后端代替 LEDC，检查各驱动芯片的方向/刹车编码、
+// 使能引脚、四驱布局的车轮分发与差速混控缩放。
+#include <unity.h>
+#include "motor_driver.h"
+
+struct RecordingPins
+{
+    static constexpr int PIN_COUNT = 64;
+    static constexpr int CHANNEL_COUNT = 16;
+
+    static bool output[PIN_COUNT];
+    static int level[PIN_COUNT];    // -1 表示从未写入
+    static int attached[PIN_COUNT]; // 绑定的 LEDC 通道，-1 表示未绑定
+    static int duty[CHANNEL_COUNT];
+    static int channelBits[CHANNEL_COUNT];
+
+    static void reset()
+    {
+        for (int i = 0; i < PIN_COUNT; ++i)
+        {
+            output[i] = false;
+            level[i] = -1;
+            attached[i] = -1;
+        }
+        for (int i = 0; i < CHANNEL_COUNT; ++i)
+        {
+            duty[i] = -1;
+            channelBits[i] = 0;
+        }
+    }
+
+    static void pinOutput(int pin) { output[pin] = true; }
+    static void write(int pin, bool high) { level[pin] = high ? 1 : 0; }
+    static void pwmSetup(int channel, int, int bits) { channelBits[channel] = bits; }
+    static void pwmAttach(int pin, int channel) { attached[pin] = channel; }
+    static void pwmWrite(int channel, int value) { duty[channel] = value; }
+};
+
+bool RecordingPins::output[RecordingPins::PIN_COUNT];
+int RecordingPins::level[RecordingPins::PIN_COUNT];
+int RecordingPins::attached[RecordingPins::PIN_COUNT];
+int RecordingPins::duty[RecordingPins::CHANNEL_COUNT];
+int RecordingPins::channelBits[RecordingPins::CHANNEL_COUNT];
+
+using Pins = RecordingPins;
+
+// 与 motors.cpp 默认布局相同的前轮接线，后轮为示例接线
+using FrontLeft = Tb6612Motor<Pins, 40, 41, 42, 0>;
+using FrontRight = Tb6612Motor<Pins, 38, 37, 36, 1>;
+using RearLeft = Tb6612Motor<Pins, 6, 7, 8, 2>;
+using RearRight = Tb6612Motor<Pins, 9, 10, 11, 3>;
+using Bank4wd = MotorBank<MotorEnablePins<Pins, 39, 12>, FrontLeft, FrontRight, RearLeft, RearRight>;
+using Mixer4wd = DiffMixer<WHEEL_LEFT, WHEEL_RIGHT, WHEEL_LEFT, WHEEL_RIGHT>;
+
+void setUp()
+{
+    Pins::reset();
+}
+
+void tearDown()
+{
+}
+
+// TB6612：IN1 IN2 PWM
+//   正转  H  L  |speed|
+//   反转  L  H  |speed|
+//   停止  H  H  0（短路刹车）
+void test_tb6612_truth_table()
+{
+    using M = Tb6612Motor<Pins, 1, 2, 3, 4>;
+    M::init();
+    TEST_ASSERT_TRUE(Pins::output[1] && Pins::output[2]);
+    TEST_ASSERT_EQUAL(4, Pins::attached[3]);
+    TEST_ASSERT_EQUAL(MOTOR_PWM_BITS, Pins::channelBits[4]);
+
+    static const struct
+    {
+        int speed;
+        int in1;
+        int in2;
+        int duty;
+    } ROWS[] = {
+        {200, 1, 0, 200},
+        {1, 1, 0, 1},
+        {-90, 0, 1, 90},
+        {-255, 0, 1, 255},
+        {0, 1, 1, 0},
+    };
+    for (const auto &row : ROWS)
+    {
+        M::drive(row.speed);
+        TEST_ASSERT_EQUAL(row.in1, Pins::level[1]);
+        TEST_ASSERT_EQUAL(row.in2, Pins::level[2]);
+        TEST_ASSERT_EQUAL(row.duty, Pins::duty[4]);
+    }
+    M::drive(120);
+    M::brake();
+    TEST_ASSERT_EQUAL(1, Pins::level[1]);
+    TEST_ASSERT_EQUAL(1, Pins::level[2]);
+    TEST_ASSERT_EQUAL(0, Pins::duty[4]);
+}
+
+// DRV8833：IN1 IN2（均为 PWM）
+//   正转  |speed|  0
+//   反转  0  |speed|
+//   停止  255  255（慢衰减刹车）
+void test_drv8833_truth_table()
+{
+    using M = Drv8833Motor<Pins, 1, 2, 5, 6>;
+    M::init();
+    TEST_ASSERT_EQUAL(5, Pins::attached[1]);
+    TEST_ASSERT_EQUAL(6, Pins::attached[2]);
+
+    static const struct
+    {
+        int speed;
+        int duty1;
+        int duty2;
+    } ROWS[] = {
+        {150, 150, 0},
+        {-60, 0, 60},
+        {0, MOTOR_MAX_DUTY, MOTOR_MAX_DUTY},
+    };
+    for (const auto &row : ROWS)
+    {
+        M::drive(row.speed);
+        TEST_ASSERT_EQUAL(row.duty1, Pins::duty[5]);
+        TEST_ASSERT_EQUAL(row.duty2, Pins::duty[6]);
+    }
+}
+
+void test_enable_pins_drive_all_boards()
+{
+    using Enable = MotorEnablePins<Pins, 39, 12>;
+    Enable::init();
+    TEST_ASSERT_TRUE(Pins::output[39] && Pins::output[12]);
+    TEST_ASSERT_EQUAL(1, Pins::level[39]);
+    TEST_ASSERT_EQUAL(1, Pins::level[12]);
+    Enable::set(false);
+    TEST_ASSERT_EQUAL(0, Pins::level[39]);
+    TEST_ASSERT_EQUAL(0, Pins::level[12]);
+}
+
+// 四驱布局：init 后每个引脚只属于一路电机，每路电机使用独立的 LEDC 通道
+void test_4wd_bank_pins_and_channels_are_distinct()
+{
+    Bank4wd::init();
+    static const int DIRECTION_PINS[] = {40, 41, 38, 37, 6, 7, 9, 10, 39, 12};
+    for (int pin : DIRECTION_PINS)
+    {
+        TEST_ASSERT_TRUE(Pins::output[pin]);
+        TEST_ASSERT_EQUAL(-1, Pins::attached[pin]);
+    }
+    static const int PWM_PINS[] = {42, 36, 8, 11};
+    for (int wheel = 0; wheel < 4; ++wheel)
+    {
+        TEST_ASSERT_EQUAL(wheel, Pins::attached[PWM_PINS[wheel]]);
+        TEST_ASSERT_FALSE(Pins::output[PWM_PINS[wheel]]);
+    }
+}
+
+void test_4wd_bank_dispatches_by_index()
+{
+    Bank4wd::init();
+    const int commands[] = {100, -120, 300, 0};
+    for (size_t wheel = 0; wheel < Bank4wd::COUNT; ++wheel)
+    {
+        Bank4wd::drive(wheel, commands[wheel]);
+    }
+    TEST_ASSERT_EQUAL(100, Pins::duty[0]);
+    TEST_ASSERT_EQUAL(120, Pins::duty[1]);
+    TEST_ASSERT_EQUAL(1, Pins::level[37]); // 右前反转：BIN2=H
+    TEST_ASSERT_EQUAL(255, Pins::duty[2]); // 超出范围按 255 输出
+    TEST_ASSERT_EQUAL(0, Pins::duty[3]);
+    TEST_ASSERT_EQUAL(1, Pins::level[9]); // 右后停止：短路刹车
+    TEST_ASSERT_EQUAL(1, Pins::level[10]);
+
+    int before[Bank4wd::COUNT];
+    for (size_t wheel = 0; wheel < Bank4wd::COUNT; ++wheel)
+    {
+        before[wheel] = Pins::duty[wheel];
+    }
+    Bank4wd::drive(4, 200); // 越界编号忽略，不改动任何一路
+    for (size_t wheel = 0; wheel < Bank4wd::COUNT; ++wheel)
+    {
+        TEST_ASSERT_EQUAL(before[wheel], Pins::duty[wheel]);
+    }
+
+    Bank4wd::brakeAll();
+    for (size_t wheel = 0; wheel < Bank4wd::COUNT; ++wheel)
+    {
+        TEST_ASSERT_EQUAL(0, Pins::duty[wheel]);
+    }
+    TEST_ASSERT_EQUAL(1, Pins::level[40]); // 左前刹车：AIN1=AIN2=H
+    TEST_ASSERT_EQUAL(1, Pins::level[41]);
+
+    Bank4wd::standby();
+    TEST_ASSERT_EQUAL(0, Pins::level[39]);
+    TEST_ASSERT_EQUAL(0, Pins::level[12]);
+    Bank4wd::wakeup();
+    TEST_ASSERT_EQUAL(1, Pins::level[12]);
+}
+
+// 混控：同侧车轮命令相同；超出 255 时整体缩放，保持左右比例
+void test_4wd_mixer_sides_and_scaling()
+{
+    int out[4];
+    Mixer4wd::mix(150, 40, out);
+    TEST_ASSERT_EQUAL(190, out[0]);
+    TEST_ASSERT_EQUAL(110, out[1]);
+    TEST_ASSERT_EQUAL(out[0], out[2]);
+    TEST_ASSERT_EQUAL(out[1], out[3]);
+
+    Mixer4wd::mix(250, 100, out);
+    TEST_ASSERT_EQUAL(255, out[0]);
+    TEST_ASSERT_EQUAL(150 * 255 / 350, out[1]);
+    TEST_ASSERT_EQUAL(out[1], out[3]);
+
+    Mixer4wd::mix(0, -200, out); // 原地左转
+    TEST_ASSERT_EQUAL(-200, out[0]);
+    TEST_ASSERT_EQUAL(200, out[1]);
+    TEST_ASSERT_EQUAL(WHEEL_LEFT, Mixer4wd::side(2));
+    TEST_ASSERT_EQUAL(0, Mixer4wd::side(4));
+}
+
+int main(int, char **)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_tb6612_truth_table);
+    RUN_TEST(test_drv8833_truth_table);
+    RUN_TEST(test_enable_pins_drive_all_boards);
+    RUN_TEST(test_4wd_bank_pins_and_channels_are_distinct);
+    RUN_TEST(test_4wd_bank_dispatches_by_index);
+    RUN_TEST(test_4wd_mixer_sides_and_scaling);
+    return UNITY_END();
+}
@@ -0,0 +1,222 @@
+// 电机辨识的仿真检查：每侧、每个方向用“死区 + 饱和非线性 + 一阶响应”的电机模型，
+// 单侧驱动时偏航角速度与该侧车轮速度成正比，叠加测量噪声。
+// 完整跑一遍阶梯后拟合查找表，补偿后两侧在相同命令下速度一致、速度与命令近似成正比。
+#include <unity.h>
+#include <math.h>
+#include <stdio.h>
+#include "motorid.h"
+
+static constexpr uint32_t LOOP_MS = 5;
+static constexpr float TAU_S = 0.06f;
+
+struct MotorModel
+{
+    float deadband; // 占空比
+    float gain;     // 每单位占空比（超过死区部分）的偏航角速度（°/s）
+    float curve;    // 高占空比时的饱和程度，0 为线性
+};
+
+// [侧][方向]：右侧更弱、死区更大，后退方向略有不同
+static const MotorModel MODELS[MOTORID_SIDES][MOTORID_DIRECTIONS] = {
+    {{38.0f, 1.00f, 0.30f}, {42.0f, 0.95f, 0.30f}},
+    {{55.0f, 0.85f, 0.20f}, {60.0f, 0.80f, 0.25f}},
+};
+
+static uint32_t noiseState = 1;
+
+static float noise(float amplitude)
+{
+    noiseState = noiseState * 1664525u + 1013904223u;
+    return ((noiseState >> 8) / 16777216.0f * 2.0f - 1.0f) * amplitude;
+}
+
+// 稳态偏航角速度幅值
+static float steadyRate(const MotorModel &model, int duty)
+{
+    const float over = fabsf(static_cast<float>(duty)) - model.deadband;
+    if (over <= 0.0f)
+    {
+        return 0.0f;
+    }
+    const float x = over / (255.0f - model.deadband);
+    return model.gain * (255.0f - model.deadband) * (x - model.curve * x * x * 0.5f);
+}
+
+static float rateForCommands(int speedA, int speedB)
+{
+    // 单侧驱动，另一侧为 0；带符号偏航由测量模块取绝对值
+    if (speedA != 0)
+    {
+        return steadyRate(MODELS[0][speedA > 0 ? 0 : 1], speedA);
+    }
+    if (speedB != 0)
+    {
+        return -steadyRate(MODELS[1][speedB > 0 ? 0 : 1], speedB);
+    }
+    return 0.0f;
+}
+
+// 跑完整个阶梯，返回耗时（ms），abortAtMs 之后注入撞击
+static uint32_t runSweep(uint32_t abortAtMs, MotorIdOutput *last)
+{
+    const float dt = LOOP_MS / 1000.0f;
+    float rate = 0.0f;
+    int speedA = 0;
+    int speedB = 0;
+    motorIdBegin(0);
+    for (uint32_t nowMs = 0; nowMs < 200000; nowMs += LOOP_MS)
+    {
+        rate += (rateForCommands(speedA, speedB) - rate) * dt / (TAU_S + dt);
+        const float accel[3] = {nowMs >= abortAtMs ? 20.0f : noise(0.3f), noise(0.3f), 9.81f};
+        const MotorIdOutput out = motorIdUpdate(nowMs, rate + noise(1.5f), accel);
+        speedA = out.speedA;
+        speedB = out.speedB;
+        if (out.done || out.failed)
+        {
+            *last = out;
+            return nowMs;
+        }
+    }
+    return 200000;
+}
+
+void setUp()
+{
+    noiseState = 1;
+}
+
+void tearDown()
+{
+}
+
+void test_sweep_drives_one_side_at_a_time()
+{
+    motorIdBegin(0);
+    const float accel[3] = {0.0f, 0.0f, 9.81f};
+    MotorIdOutput out = motorIdUpdate(0, 0.0f, accel);
+    TEST_ASSERT_EQUAL(0, out.speedA); // 先停车等待
+    out = motorIdUpdate(MOTORID_REST_MS, 0.0f, accel);
+    out = motorIdUpdate(MOTORID_REST_MS + LOOP_MS, 0.0f, accel);
+    TEST_ASSERT_EQUAL(motorIdLevelDuty(0), out.speedA);
+    TEST_ASSERT_EQUAL(0, out.speedB);
+    TEST_ASSERT_EQUAL(255, motorIdLevelDuty(MOTORID_LEVELS - 1));
+    motorIdAbort();
+    TEST_ASSERT_FALSE(motorIdRunning());
+}
+
+void test_fit_recovers_deadband_and_equalizes_sides()
+{
+    MotorIdOutput last = {};
+    const uint32_t durationMs = runSweep(UINT32_MAX, &last);
+    TEST_ASSERT_TRUE(last.done);
+    TEST_ASSERT_FALSE(motorIdRunning());
+    const uint32_t expectedMs = MOTORID_SIDES * MOTORID_DIRECTIONS *
+                                (MOTORID_REST_MS + MOTORID_LEVELS * (MOTORID_SETTLE_MS + MOTORID_MEASURE_MS));
+    TEST_ASSERT_UINT32_WITHIN(MOTORID_SIDES * MOTORID_DIRECTIONS * MOTORID_LEVELS * 2 * LOOP_MS, expectedMs, durationMs);
+
+    MotorIdTable table = {};
+    TEST_ASSERT_TRUE(motorIdFitLast(&table));
+    TEST_ASSERT_TRUE(motorIdTableValid(table));
+
+    float slowestTop = 1e9f;
+    for (size_t side = 0; side < MOTORID_SIDES; ++side)
+    {
+        for (size_t direction = 0; direction < MOTORID_DIRECTIONS; ++direction)
+        {
+            const MotorModel &model = MODELS[side][direction];
+            slowestTop = fminf(slowestTop, steadyRate(model, 255));
+            char message[96];
+            snprintf(message, sizeof(message), "侧 %u 方向 %u：死区 %u（真实 %.0f）", static_cast<unsigned>(side),
+                     static_cast<unsigned>(direction), table.deadband[side][direction], model.deadband);
+            TEST_MESSAGE(message);
+            // 阶梯间隔 15、转动阈值 3°/s 与测量噪声下，死区估计误差在半级以内
+            TEST_ASSERT_FLOAT_WITHIN(MOTORID_LEVEL_STEP / 2.0f, model.deadband, table.deadband[side][direction]);
+        }
+    }
+    TEST_ASSERT_FLOAT_WITHIN(slowestTop * 0.03f, slowestTop, table.maxRateDps);
+
+    // 补偿后：相同命令下两侧、两个方向的速度一致，且与命令成正比
+    float worstSideMismatch = 0.0f;
+    float worstLinearity = 0.0f;
+    for (int command = 64; command <= 255; command += 16)
+    {
+        for (int sign = -1; sign <= 1; sign += 2)
+        {
+            const size_t direction = sign > 0 ? 0 : 1;
+            const float left = steadyRate(MODELS[0][direction], motorIdApply(table, 0, sign * command));
+            const float right = steadyRate(MODELS[1][direction], motorIdApply(table, 1, sign * command));
+            const float ideal = table.maxRateDps * command / 255.0f;
+            worstSideMismatch = fmaxf(worstSideMismatch, fabsf(left - right) / ideal);
+            worstLinearity = fmaxf(worstLinearity, fmaxf(fabsf(left - ideal), fabsf(right - ideal)) / ideal);
+        }
+    }
+    char message[96];
+    snprintf(message, sizeof(message), "补偿后两侧速度差最大 %.1f%%，与理想比例偏差最大 %.1f%%", worstSideMismatch * 100.0f,
+             worstLinearity * 100.0f);
+    TEST_MESSAGE(message);
+    TEST_ASSERT_LESS_THAN_FLOAT(0.08f, worstSideMismatch);
+    TEST_ASSERT_LESS_THAN_FLOAT(0.10f, worstLinearity);
+
+    // 未补偿时同一命令下右侧明显更慢，作为对照
+    const float rawMismatch = (steadyRate(MODELS[0][0], 150) - steadyRate(MODELS[1][0], 150)) / steadyRate(MODELS[0][0], 150);
+    TEST_ASSERT_GREATER_THAN_FLOAT(0.25f, rawMismatch);
+}
+
+void test_apply_is_monotonic_and_keeps_sign()
+{
+    MotorIdOutput last = {};
+    runSweep(UINT32_MAX, &last);
+    MotorIdTable table = {};
+    TEST_ASSERT_TRUE(motorIdFitLast(&table));
+    TEST_ASSERT_EQUAL(0, motorIdApply(table, 0, 0));
+    TEST_ASSERT_EQUAL(motorIdApply(table, 1, 255), motorIdApply(table, 1, 300)); // 超出范围按 255
+    int previous = 0;
+    for (int command = 1; command <= 255; ++command)
+    {
+        const int duty = motorIdApply(table, 1, command);
+        TEST_ASSERT_GREATER_OR_EQUAL(previous, duty);
+        TEST_ASSERT_LESS_OR_EQUAL(255, duty);
+        TEST_ASSERT_LESS_THAN(0, motorIdApply(table, 1, -command));
+        previous = duty;
+    }
+    // 最小的非零命令已越过死区，车轮能转动
+    TEST_ASSERT_GREATER_OR_EQUAL(table.deadband[1][0], motorIdApply(table, 1, 1));
+}
+
+void test_abort_on_impact_and_fail_when_side_does_not_move()
+{
+    MotorIdOutput last = {};
+    runSweep(3000, &last);
+    TEST_ASSERT_TRUE(last.failed);
+    TEST_ASSERT_FALSE(motorIdRunning());
+
+    // 右侧前进在最大占空比下仍不转动（电机断线）：拟合失败
+    static MotorIdSweep sweeps[MOTORID_SIDES][MOTORID_DIRECTIONS] = {};
+    for (size_t side = 0; side < MOTORID_SIDES; ++side)
+    {
+        for (size_t direction = 0; direction < MOTORID_DIRECTIONS; ++direction)
+        {
+            for (size_t k = 0; k < MOTORID_LEVELS; ++k)
+            {
+                sweeps[side][direction].rateDps[k] = steadyRate(MODELS[side][direction], motorIdLevelDuty(k));
+            }
+        }
+    }
+    MotorIdTable table = {};
+    TEST_ASSERT_TRUE(motorIdFit(sweeps, &table));
+    for (size_t k = 0; k < MOTORID_LEVELS; ++k)
+    {
+        sweeps[1][0].rateDps[k] = 0.5f;
+    }
+    TEST_ASSERT_FALSE(motorIdFit(sweeps, &table));
+}
+
+int main(int, char **)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_sweep_drives_one_side_at_a_time);
+    RUN_TEST(test_fit_recovers_deadband_and_equalizes_sides);
+    RUN_TEST(test_apply_is_monotonic_and_keeps_sign);
+    RUN_TEST(test_abort_on_impact_and_fail_when_side_does_not_move);
+    return UNITY_END();
+}
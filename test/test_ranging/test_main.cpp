@@ -0,0 +1,126 @@
+// 测距调度的主机端仿真：小车以恒定命令驶向墙面，控制循环每 5 ms 询问一次是否测距，
+// 检查两次测距之间的行驶距离、近距离时的测距频率与陈旧时间统计。
+#include <unity.h>
+#include <stdio.h>
+#include "ranging.h"
+
+static constexpr uint32_t LOOP_MS = 5;
+
+struct ApproachResult
+{
+    float maxTravelCm;     // 两次测距之间的最大行驶距离
+    uint32_t nearMaxGapMs; // 进入近距离后两次测距的最大间隔
+    uint32_t samples;
+};
+
+// 从 startCm 以 speed 命令驶向墙面直到 stopCm，车速按 RANGING_FULL_SPEED_CM_PER_S 线性换算
+static ApproachResult approach(int speed, float startCm, float stopCm)
+{
+    rangingReset();
+    ApproachResult result = {0.0f, 0, 0};
+    const float speedCmPerS = RANGING_FULL_SPEED_CM_PER_S * speed / 255.0f;
+    float distanceCm = startCm;
+    float lastMeasuredCm = -1.0f;
+    float lastSampleAtCm = startCm;
+    uint32_t lastNearSampleMs = 0;
+    for (uint32_t nowMs = 0; distanceCm > stopCm; nowMs += LOOP_MS)
+    {
+        if (rangingDue(nowMs, speed, lastMeasuredCm))
+        {
+            rangingRecord(nowMs, true);
+            if (result.samples > 0 && lastSampleAtCm - distanceCm > result.maxTravelCm)
+            {
+                result.maxTravelCm = lastSampleAtCm - distanceCm;
+            }
+            if (lastMeasuredCm >= 0.0f && lastMeasuredCm < RANGING_NEAR_DISTANCE_CM && nowMs - lastNearSampleMs > result.nearMaxGapMs)
+            {
+                result.nearMaxGapMs = nowMs - lastNearSampleMs;
+            }
+            lastNearSampleMs = nowMs;
+            lastSampleAtCm = distanceCm;
+            lastMeasuredCm = distanceCm;
+            ++result.samples;
+        }
+        distanceCm -= speedCmPerS * LOOP_MS / 1000.0f;
+    }
+    return result;
+}
+
+void setUp()
+{
+    rangingReset();
+}
+
+void tearDown()
+{
+}
+
+void test_interval_policy()
+{
+    TEST_ASSERT_EQUAL_UINT32(RANGING_IDLE_INTERVAL_MS, rangingIntervalMs(0, 100.0f));
+    TEST_ASSERT_EQUAL_UINT32(RANGING_MIN_INTERVAL_MS, rangingIntervalMs(100, 30.0f));
+    TEST_ASSERT_EQUAL_UINT32(RANGING_MIN_INTERVAL_MS, rangingIntervalMs(255, 200.0f));
+    TEST_ASSERT_EQUAL_UINT32(RANGING_MAX_MOVING_INTERVAL_MS, rangingIntervalMs(20, 200.0f));
+    // 中间速度：两次测距之间行驶 RANGING_TRAVEL_PER_SAMPLE_CM
+    const uint32_t interval = rangingIntervalMs(100, -1.0f);
+    TEST_ASSERT_UINT32_WITHIN(1, static_cast<uint32_t>(RANGING_TRAVEL_PER_SAMPLE_CM / (RANGING_FULL_SPEED_CM_PER_S * 100 / 255.0f) * 1000.0f), interval);
+}
+
+// 各档速度下两次测距之间的行驶距离不超过预算（最短间隔限制的部分与一个控制周期的量化除外）
+void test_travel_between_samples()
+{
+    static const int SPEEDS[] = {60, 100, 150, 200, 255};
+    for (int speed : SPEEDS)
+    {
+        const ApproachResult result = approach(speed, 300.0f, 10.0f);
+        const float speedCmPerS = RANGING_FULL_SPEED_CM_PER_S * speed / 255.0f;
+        const float floorCm = speedCmPerS * RANGING_MIN_INTERVAL_MS / 1000.0f;
+        const float budgetCm = (floorCm > RANGING_TRAVEL_PER_SAMPLE_CM ? floorCm : RANGING_TRAVEL_PER_SAMPLE_CM) + speedCmPerS * LOOP_MS / 1000.0f;
+        char message[128];
+        snprintf(message, sizeof(message), "速度 %d：%u 次测距，间隔内最多行驶 %.2f cm（预算 %.2f cm），近距离最大间隔 %u ms", speed,
+                 static_cast<unsigned>(result.samples), result.maxTravelCm, budgetCm, static_cast<unsigned>(result.nearMaxGapMs));
+        TEST_MESSAGE(message);
+        TEST_ASSERT_LESS_OR_EQUAL_FLOAT(budgetCm + 0.01f, result.maxTravelCm);
+        TEST_ASSERT_LESS_OR_EQUAL_UINT32(RANGING_MIN_INTERVAL_MS + LOOP_MS, result.nearMaxGapMs);
+    }
+}
+
+void test_metrics_track_intervals()
+{
+    approach(150, 300.0f, 10.0f);
+    const RangingMetrics &metrics = rangingGetMetrics();
+    TEST_ASSERT_GREATER_THAN_UINT32(0, metrics.samples);
+    TEST_ASSERT_EQUAL_UINT32(0, metrics.timeouts);
+    TEST_ASSERT_EQUAL_UINT32(RANGING_MIN_INTERVAL_MS, metrics.targetIntervalMs);
+    TEST_ASSERT_FLOAT_WITHIN(RANGING_MIN_INTERVAL_MS * 0.2f, RANGING_MIN_INTERVAL_MS, metrics.meanIntervalMs);
+}
+
+void test_staleness_with_timeouts()
+{
+    TEST_ASSERT_EQUAL_UINT32(UINT32_MAX, rangingStalenessMs(0));
+    rangingRecord(1000, true);
+    TEST_ASSERT_EQUAL_UINT32(0, rangingStalenessMs(1000));
+    // 连续 4 次超时：陈旧时间持续增长，恢复后记录最长陈旧时间
+    for (uint32_t t = 1060; t <= 1240; t += 60)
+    {
+        rangingRecord(t, false);
+    }
+    TEST_ASSERT_EQUAL_UINT32(240, rangingStalenessMs(1240));
+    rangingRecord(1300, true);
+    const RangingMetrics &metrics = rangingGetMetrics();
+    TEST_ASSERT_EQUAL_UINT32(6, metrics.samples);
+    TEST_ASSERT_EQUAL_UINT32(4, metrics.timeouts);
+    TEST_ASSERT_EQUAL_UINT32(300, metrics.maxStalenessMs);
+    TEST_ASSERT_EQUAL_UINT32(60, metrics.lastIntervalMs);
+    TEST_ASSERT_EQUAL_UINT32(10, rangingStalenessMs(1310));
+}
+
+int main(int, char **)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_interval_policy);
+    RUN_TEST(test_travel_between_samples);
+    RUN_TEST(test_metrics_track_intervals);
+    RUN_TEST(test_staleness_with_timeouts);
+    return UNITY_END();
+}
@@ -0,0 +1,230 @@
+// 示教-复现的编码与复现检查：录制结果逐条解码后与输入一致（量化后），载入时拒绝损坏的数据；
+// 限速器逐周期微调的命令不会把缓冲写满；复现按录制时间轴输出命令，受阻时暂停，航向偏差时差速修正。
+#include <unity.h>
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+#include "route.h"
+
+static constexpr uint32_t LOOP_MS = 5;
+
+static uint32_t noiseState = 1;
+
+static float noise(float amplitude)
+{
+    noiseState = noiseState * 1664525u + 1013904223u;
+    return ((noiseState >> 8) / 16777216.0f * 2.0f - 1.0f) * amplitude;
+}
+
+static size_t countPoints(RoutePoint *last)
+{
+    size_t pos = ROUTE_HEADER_SIZE;
+    RoutePoint point = {};
+    size_t points = 0;
+    while (routeDecodeNext(routeData(), routeSize(), &pos, &point))
+    {
+        ++points;
+    }
+    TEST_ASSERT_EQUAL(routeSize(), pos);
+    if (last != nullptr)
+    {
+        *last = point;
+    }
+    return points;
+}
+
+void setUp()
+{
+    noiseState = 1;
+    routePlaybackStop();
+    routeConfigure(ROUTE_DEFAULT_CONFIG);
+}
+
+void tearDown()
+{
+}
+
+// 命令段：直行、右转、倒车；位姿按录制开始相对值记录
+void test_round_trip_decodes_recorded_points()
+{
+    static const struct
+    {
+        uint32_t timeMs;
+        int speedA;
+        int speedB;
+        float yaw;
+        float distanceM;
+    } SAMPLES[] = {
+        {0, 160, 160, 10.0f, 2.0f},
+        {300, 160, 160, 10.5f, 2.3f},
+        {400, 160, 64, 12.0f, 2.4f},
+        {900, -128, -128, 40.0f, 2.8f},
+        {1500, 0, 0, 41.0f, 3.1f},
+    };
+    routeRecordBegin(1000, 10.0f, 2.0f);
+    for (const auto &s : SAMPLES)
+    {
+        TEST_ASSERT_TRUE(routeRecordSample(1000 + s.timeMs, s.speedA, s.speedB, s.yaw, s.distanceM));
+    }
+    routeRecordEnd(2600, 41.5f, 3.15f);
+    TEST_ASSERT_FALSE(routeRecording());
+
+    // 300 ms 处命令未变但超过位姿间隔，停车后不再记位姿，最后是结束时的停车记录
+    static const RoutePoint EXPECTED[] = {
+        {0, 160, 160, 0.0f, 0.0f},
+        {300, 160, 160, 0.5f, 0.3f},
+        {400, 160, 64, 2.0f, 0.4f},
+        {900, -128, -128, 30.0f, 0.8f},
+        {1500, 0, 0, 31.0f, 1.1f},
+        {1600, 0, 0, 31.5f, 1.15f},
+    };
+    size_t pos = ROUTE_HEADER_SIZE;
+    RoutePoint point = {};
+    for (const RoutePoint &expected : EXPECTED)
+    {
+        TEST_ASSERT_TRUE(routeDecodeNext(routeData(), routeSize(), &pos, &point));
+        TEST_ASSERT_EQUAL_UINT32(expected.timeMs, point.timeMs);
+        TEST_ASSERT_EQUAL(expected.speedA, point.speedA);
+        TEST_ASSERT_EQUAL(expected.speedB, point.speedB);
+        TEST_ASSERT_FLOAT_WITHIN(0.051f, expected.yawDeg, point.yawDeg);
+        TEST_ASSERT_FLOAT_WITHIN(0.0051f, expected.distanceM, point.distanceM);
+    }
+    TEST_ASSERT_FALSE(routeDecodeNext(routeData(), routeSize(), &pos, &point));
+    TEST_ASSERT_EQUAL(routeSize(), pos);
+    const RouteMetrics &metrics = routeGetMetrics();
+    TEST_ASSERT_EQUAL_UINT32(6, metrics.points);
+    TEST_ASSERT_EQUAL_UINT32(1600, metrics.durationMs);
+    TEST_ASSERT_FLOAT_WITHIN(0.0051f, 1.15f, metrics.distanceM);
+}
+
+void test_load_rejects_corrupt_data()
+{
+    routeRecordBegin(0, 0.0f, 0.0f);
+    routeRecordSample(0, 160, 160, 0.0f, 0.0f);
+    routeRecordEnd(1000, 0.0f, 0.5f);
+    uint8_t copy[64];
+    const size_t size = routeSize();
+    TEST_ASSERT_LESS_OR_EQUAL(sizeof(copy), size);
+    memcpy(copy, routeData(), size);
+
+    TEST_ASSERT_TRUE(routeLoad(copy, size));
+    TEST_ASSERT_EQUAL_UINT32(2, routeGetMetrics().points);
+    TEST_ASSERT_FALSE(routeLoad(copy, size - 1)); // 记录被截断
+    copy[2] = ROUTE_FORMAT_VERSION + 1;
+    TEST_ASSERT_FALSE(routeLoad(copy, size));
+    copy[2] = ROUTE_FORMAT_VERSION;
+    TEST_ASSERT_FALSE(routeLoad(copy, ROUTE_HEADER_SIZE)); // 没有记录
+}
+
+// 前进中限速器每个控制周期把速度在 120~200 之间小幅调整（外加 ±3 的抖动），录制 60 s：
+// 量化与回差后记录数远小于控制周期数，缓冲不会写满
+void test_governed_commands_do_not_fill_buffer()
+{
+    routeRecordBegin(0, 0.0f, 0.0f);
+    float distanceM = 0.0f;
+    uint32_t nowMs = 0;
+    for (; nowMs < 60000; nowMs += LOOP_MS)
+    {
+        const float s = nowMs / 1000.0f;
+        const int speed = static_cast<int>(160.0f + 40.0f * sinf(2.0f * 3.14159265f * s / 8.0f) + noise(3.0f));
+        distanceM += speed / 255.0f * LOOP_MS / 1000.0f;
+        TEST_ASSERT_TRUE(routeRecordSample(nowMs, speed, speed, 0.0f, distanceM));
+    }
+    routeRecordEnd(nowMs, 0.0f, distanceM);
+    const RouteMetrics &metrics = routeGetMetrics();
+    char message[96];
+    snprintf(message, sizeof(message), "60 s 录制：%u 条记录，%u 字节（容量 %u）", static_cast<unsigned>(metrics.points),
+             static_cast<unsigned>(metrics.bytes), static_cast<unsigned>(ROUTE_CAPACITY));
+    TEST_MESSAGE(message);
+    TEST_ASSERT_FALSE(metrics.truncated);
+    TEST_ASSERT_LESS_THAN_UINT32(ROUTE_CAPACITY / 2, metrics.bytes);
+    // 命令不变时每 ROUTE_POSE_INTERVAL_MS 一条位姿，命令变化带来的额外记录不超过同样数量
+    TEST_ASSERT_LESS_THAN_UINT32(2 * 60000 / ROUTE_POSE_INTERVAL_MS, metrics.points);
+    TEST_ASSERT_EQUAL(metrics.points, countPoints(nullptr));
+}
+
+void test_quantized_speeds_stay_on_grid()
+{
+    routeRecordBegin(0, 0.0f, 0.0f);
+    routeRecordSample(0, 3, -250, 0.0f, 0.0f);
+    routeRecordSample(100, 147, -250, 0.0f, 0.0f);
+    routeRecordEnd(200, 0.0f, 0.0f);
+    size_t pos = ROUTE_HEADER_SIZE;
+    RoutePoint point = {};
+    TEST_ASSERT_TRUE(routeDecodeNext(routeData(), routeSize(), &pos, &point));
+    TEST_ASSERT_EQUAL(ROUTE_SPEED_STEP, point.speedA); // 非零的小命令不会变成停车
+    TEST_ASSERT_EQUAL(-255, point.speedB);
+    TEST_ASSERT_TRUE(routeDecodeNext(routeData(), routeSize(), &pos, &point));
+    TEST_ASSERT_EQUAL(144, point.speedA);
+}
+
+// 复现：按录制时间轴输出，受阻期间输出 0 且时间轴暂停，结束时输出 0 并报告完成
+void test_playback_follows_timeline_and_pauses()
+{
+    routeRecordBegin(0, 0.0f, 0.0f);
+    routeRecordSample(0, 160, 160, 0.0f, 0.0f);
+    routeRecordSample(1000, 0, 0, 0.0f, 0.63f);
+    routeRecordEnd(1200, 0.0f, 0.63f);
+
+    TEST_ASSERT_TRUE(routePlaybackBegin(5000, 90.0f, 10.0f));
+    RouteInput in = {5000, 90.0f, true, 10.0f, false};
+    uint32_t drivingMs = 0;
+    RouteOutput out = {};
+    for (in.nowMs = 5000 + LOOP_MS; in.nowMs < 8000; in.nowMs += LOOP_MS)
+    {
+        in.blocked = in.nowMs >= 5500 && in.nowMs < 5800;
+        out = routePlaybackUpdate(in);
+        if (in.blocked)
+        {
+            TEST_ASSERT_TRUE(out.paused);
+            TEST_ASSERT_EQUAL(0, out.speedA);
+        }
+        if (out.speedA != 0)
+        {
+            drivingMs += LOOP_MS;
+            in.distanceM += out.speedA / 255.0f * LOOP_MS / 1000.0f;
+        }
+        if (out.done)
+        {
+            break;
+        }
+    }
+    TEST_ASSERT_TRUE(out.done);
+    TEST_ASSERT_FALSE(routePlaying());
+    TEST_ASSERT_UINT32_WITHIN(LOOP_MS, 1000, drivingMs);
+    const RouteMetrics &metrics = routeGetMetrics();
+    TEST_ASSERT_EQUAL_UINT32(1, metrics.pauses);
+    TEST_ASSERT_UINT32_WITHIN(LOOP_MS, 300, metrics.pausedMs);
+    TEST_ASSERT_FLOAT_WITHIN(0.02f, 0.0f, metrics.distanceErrorM);
+}
+
+// 录制为直行，复现时车头偏左 5°（偏航 +5，Z 轴朝上）：修正应使右转，A 侧加速、B 侧减速
+void test_playback_corrects_heading()
+{
+    routeRecordBegin(0, 0.0f, 0.0f);
+    routeRecordSample(0, 160, 160, 0.0f, 0.0f);
+    routeRecordEnd(1000, 0.0f, 0.6f);
+    TEST_ASSERT_TRUE(routePlaybackBegin(0, 0.0f, 0.0f));
+    const RouteInput in = {100, 5.0f, true, 0.05f, false};
+    const RouteOutput out = routePlaybackUpdate(in);
+    TEST_ASSERT_EQUAL(160 + 20, out.speedA);
+    TEST_ASSERT_EQUAL(160 - 20, out.speedB);
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, -5.0f, routeGetMetrics().lastHeadingErrorDeg);
+
+    const RouteInput degraded = {200, 5.0f, false, 0.1f, false}; // IMU 降级时不修正
+    const RouteOutput plain = routePlaybackUpdate(degraded);
+    TEST_ASSERT_EQUAL(160, plain.speedA);
+    TEST_ASSERT_EQUAL(160, plain.speedB);
+}
+
+int main(int, char **)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_round_trip_decodes_recorded_points);
+    RUN_TEST(test_load_rejects_corrupt_data);
+    RUN_TEST(test_governed_commands_do_not_fill_buffer);
+    RUN_TEST(test_quantized_speeds_stay_on_grid);
+    RUN_TEST(test_playback_follows_timeline_and_pauses);
+    RUN_TEST(test_playback_corrects_heading);
+    return UNITY_END();
+}
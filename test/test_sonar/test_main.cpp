@@ -0,0 +1,221 @@
+// 超声连续测量的带噪声回波评估：每次测量以一定概率得到杂散回波（多径、地面反射，距离随机）或漏检，
+// 其余为真实距离加噪声。按设备端的调用方式每 5 ms 推进一次，组间隔遵守传感器测量周期，
+// 统计单次测量与整组结果的粗差率（误差超过 5 cm）、可信组的平均误差与组延迟。
+#include <unity.h>
+#include <math.h>
+#include <stdio.h>
+#include "sonar.h"
+
+static constexpr uint32_t LOOP_MS = 5;
+static constexpr uint32_t MIN_CYCLE_MS = 60; // HC-SR04 测量周期
+static constexpr float GROSS_ERROR_CM = 5.0f;
+
+static uint32_t noiseState = 1;
+
+static float uniform()
+{
+    noiseState = noiseState * 1664525u + 1013904223u;
+    return (noiseState >> 8) / 16777216.0f;
+}
+
+struct EchoModel
+{
+    float spuriousRate; // 杂散回波概率
+    float missRate;     // 漏检（无回波）概率
+    float noiseCm;      // 正常回波的噪声幅值
+};
+
+static float ping(const EchoModel &model, float trueCm)
+{
+    const float u = uniform();
+    if (u < model.spuriousRate)
+    {
+        return 5.0f + uniform() * 295.0f;
+    }
+    if (u < model.spuriousRate + model.missRate)
+    {
+        return -1.0f;
+    }
+    return trueCm + (uniform() * 2.0f - 1.0f) * model.noiseCm;
+}
+
+struct Evaluation
+{
+    uint32_t bursts;
+    uint32_t trusted;
+    uint32_t singleGross; // 每组第一次测量单独使用时的粗差
+    uint32_t burstGross;  // 可信组的粗差
+    float meanAbsErrorCm; // 可信组
+    float meanLatencyMs;
+    uint32_t maxLatencyMs;
+    uint32_t minPingGapMs; // 任意两次相邻测量（含跨组）的最短间隔
+};
+
+static Evaluation evaluate(const EchoModel &model, uint32_t durationMs)
+{
+    static const float DISTANCES[] = {20.0f, 50.0f, 100.0f, 200.0f};
+    sonarBurstAbort(); // 上一次评估结束时可能还有未完成的组
+    Evaluation result = {0, 0, 0, 0, 0.0f, 0.0f, 0, UINT32_MAX};
+    float errorSum = 0.0f;
+    float latencySum = 0.0f;
+    uint32_t lastBurstEndMs = 0;
+    uint32_t lastPingMs = 0;
+    bool hasPing = false;
+    float firstPing = 0.0f;
+    for (uint32_t nowMs = MIN_CYCLE_MS; nowMs < durationMs; nowMs += LOOP_MS)
+    {
+        const float trueCm = DISTANCES[(nowMs / 5000) % 4];
+        // 组间按测距调度的最短间隔（行驶中靠近障碍时的情况）
+        const bool startBurst = !sonarBurstActive() && nowMs - lastBurstEndMs >= MIN_CYCLE_MS;
+        if (startBurst)
+        {
+            sonarBurstBegin(nowMs);
+        }
+        if (!startBurst && !sonarPingDue(nowMs))
+        {
+            continue;
+        }
+        if (hasPing && nowMs - lastPingMs < result.minPingGapMs)
+        {
+            result.minPingGapMs = nowMs - lastPingMs;
+        }
+        hasPing = true;
+        lastPingMs = nowMs;
+        const float cm = ping(model, trueCm);
+        if (startBurst)
+        {
+            firstPing = cm;
+        }
+        SonarResult sonar;
+        if (!sonarBurstAdd(nowMs, cm, &sonar))
+        {
+            continue;
+        }
+        lastBurstEndMs = nowMs;
+        ++result.bursts;
+        latencySum += sonar.latencyMs;
+        result.maxLatencyMs = sonar.latencyMs > result.maxLatencyMs ? sonar.latencyMs : result.maxLatencyMs;
+        if (firstPing < 0.0f || fabsf(firstPing - trueCm) > GROSS_ERROR_CM)
+        {
+            ++result.singleGross;
+        }
+        if (sonar.confidence >= SONAR_MIN_CONFIDENCE)
+        {
+            ++result.trusted;
+            const float error = sonar.distanceCm < 0.0f ? INFINITY : fabsf(sonar.distanceCm - trueCm);
+            if (error > GROSS_ERROR_CM)
+            {
+                ++result.burstGross;
+            }
+            else
+            {
+                errorSum += error;
+            }
+        }
+    }
+    result.meanAbsErrorCm = errorSum / (result.trusted - result.burstGross);
+    result.meanLatencyMs = latencySum / result.bursts;
+    return result;
+}
+
+static void report(const char *name, const Evaluation &e)
+{
+    char message[160];
+    snprintf(message, sizeof(message), "%s：%u 组，可信 %.1f%%，粗差 单次 %.2f%% / 整组 %.2f%%，平均误差 %.2f cm，延迟 平均 %.1f ms 最长 %u ms",
+             name, static_cast<unsigned>(e.bursts), 100.0f * e.trusted / e.bursts, 100.0f * e.singleGross / e.bursts,
+             100.0f * e.burstGross / e.trusted, e.meanAbsErrorCm, e.meanLatencyMs, static_cast<unsigned>(e.maxLatencyMs));
+    TEST_MESSAGE(message);
+}
+
+void setUp()
+{
+    noiseState = 1;
+    sonarBurstAbort();
+}
+
+void tearDown()
+{
+}
+
+void test_speed_of_sound_and_echo_conversion()
+{
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 343.42f, sonarSpeedOfSound(20.0f));
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, sonarSpeedOfSound(60.0f), sonarSpeedOfSound(90.0f)); // 超出范围按边界
+    // 35 °C 时 1 m 的往返回波：按 20 °C 换算偏短约 2.6 cm，按实际气温换算误差在 1 mm 以内
+    const uint32_t echoUs = static_cast<uint32_t>(lroundf(2.0f / sonarSpeedOfSound(35.0f) * 1e6f));
+    TEST_ASSERT_FLOAT_WITHIN(0.1f, 100.0f, sonarEchoToCm(echoUs, 35.0f));
+    TEST_ASSERT_LESS_THAN_FLOAT(98.0f, sonarEchoToCm(echoUs, 20.0f));
+}
+
+void test_agreeing_pair_stops_early_after_one_cycle()
+{
+    sonarBurstBegin(1000);
+    SonarResult out;
+    TEST_ASSERT_FALSE(sonarBurstAdd(1000, 80.0f, &out));
+    TEST_ASSERT_FALSE(sonarPingDue(1000 + SONAR_PING_GAP_MS - 1));
+    TEST_ASSERT_TRUE(sonarPingDue(1000 + SONAR_PING_GAP_MS));
+    TEST_ASSERT_TRUE(sonarBurstAdd(1000 + SONAR_PING_GAP_MS, 81.0f, &out));
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 80.5f, out.distanceCm);
+    TEST_ASSERT_EQUAL(2, out.pings);
+    TEST_ASSERT_EQUAL_UINT32(SONAR_PING_GAP_MS, out.latencyMs);
+    TEST_ASSERT_GREATER_THAN_FLOAT(0.9f, out.confidence);
+    TEST_ASSERT_EQUAL_UINT32(SONAR_PING_GAP_MS, sonarGetMetrics().lastLatencyMs);
+    TEST_ASSERT_FALSE(sonarBurstActive());
+}
+
+void test_outlier_rejected_and_disagreement_untrusted()
+{
+    SonarResult out;
+    sonarBurstBegin(0);
+    sonarBurstAdd(0, 80.0f, &out);
+    sonarBurstAdd(60, 23.0f, &out); // 杂散回波
+    TEST_ASSERT_TRUE(sonarBurstAdd(120, 81.0f, &out));
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 80.0f, out.distanceCm);
+    TEST_ASSERT_GREATER_THAN_FLOAT(SONAR_MIN_CONFIDENCE, out.confidence);
+    TEST_ASSERT_EQUAL_UINT32(2 * SONAR_PING_GAP_MS, out.latencyMs);
+
+    sonarBurstBegin(1000);
+    sonarBurstAdd(1000, 30.0f, &out);
+    sonarBurstAdd(1060, 90.0f, &out);
+    TEST_ASSERT_TRUE(sonarBurstAdd(1120, -1.0f, &out));
+    TEST_ASSERT_LESS_THAN_FLOAT(SONAR_MIN_CONFIDENCE, out.confidence);
+
+    // 多数无回波：前方空旷
+    sonarBurstBegin(2000);
+    sonarBurstAdd(2000, -1.0f, &out);
+    TEST_ASSERT_TRUE(sonarBurstAdd(2060, -1.0f, &out));
+    TEST_ASSERT_EQUAL_FLOAT(-1.0f, out.distanceCm);
+}
+
+// 10 分钟的噪声回波：整组结果的粗差率远低于单次测量，且相邻测量始终间隔至少一个测量周期
+void test_noisy_echo_accuracy_and_latency()
+{
+    const EchoModel model = {0.10f, 0.05f, 1.0f};
+    const Evaluation e = evaluate(model, 600000);
+    report("杂散 10% 漏检 5%", e);
+    TEST_ASSERT_GREATER_OR_EQUAL_UINT32(MIN_CYCLE_MS, e.minPingGapMs);
+    TEST_ASSERT_GREATER_THAN_FLOAT(0.10f, static_cast<float>(e.singleGross) / e.bursts);
+    // 整组的粗差主要是连续两次漏检被当作前方空旷（约 0.25%）与两次杂散回波恰好一致
+    TEST_ASSERT_LESS_THAN_FLOAT(0.015f, static_cast<float>(e.burstGross) / e.trusted);
+    TEST_ASSERT_GREATER_THAN_FLOAT(0.90f, static_cast<float>(e.trusted) / e.bursts);
+    TEST_ASSERT_LESS_THAN_FLOAT(1.0f, e.meanAbsErrorCm);
+    // 大多数组两次即一致：平均延迟接近一个测量周期，最长两个周期
+    TEST_ASSERT_LESS_THAN_FLOAT(SONAR_PING_GAP_MS * 1.35f, e.meanLatencyMs);
+    TEST_ASSERT_EQUAL_UINT32(2 * SONAR_PING_GAP_MS, e.maxLatencyMs);
+
+    const EchoModel harsh = {0.30f, 0.10f, 2.0f};
+    const Evaluation h = evaluate(harsh, 600000);
+    report("杂散 30% 漏检 10%", h);
+    TEST_ASSERT_LESS_THAN_FLOAT(0.08f, static_cast<float>(h.burstGross) / h.trusted);
+    TEST_ASSERT_LESS_THAN_FLOAT(static_cast<float>(h.singleGross) / h.bursts / 4.0f, static_cast<float>(h.burstGross) / h.trusted);
+}
+
+int main(int, char **)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_speed_of_sound_and_echo_conversion);
+    RUN_TEST(test_agreeing_pair_stops_early_after_one_cycle);
+    RUN_TEST(test_outlier_rejected_and_disagreement_untrusted);
+    RUN_TEST(test_noisy_echo_accuracy_and_latency);
+    return UNITY_END();
+}
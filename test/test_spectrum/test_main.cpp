@@ -0,0 +1,214 @@
+// 振动频谱：实数 FFT 与双精度直接 DFT 逐频点对照、两者的耗时对比，
+// 以及按传感器任务真实采样时刻（500 Hz）输入与按 loop 抖动周期输入时的主频估计。
+#include <unity.h>
+#include <chrono>
+#include <math.h>
+#include <stdio.h>
+#include "spectrum.h"
+
+static constexpr size_t N = SPECTRUM_WINDOW;
+static constexpr size_t BINS = N / 2 + 1;
+static constexpr uint32_t SAMPLE_US = 2000; // MPU_SAMPLE_PERIOD_MS
+
+static float storage[SPECTRUM_STORAGE_BYTES / sizeof(float)];
+static uint32_t noiseState = 1;
+
+static float noise(float amplitude)
+{
+    noiseState = noiseState * 1664525u + 1013904223u;
+    return ((noiseState >> 8) / 16777216.0f * 2.0f - 1.0f) * amplitude;
+}
+
+static void referenceDft(const float *in, double *powerOut)
+{
+    for (size_t k = 0; k < BINS; ++k)
+    {
+        double re = 0.0;
+        double im = 0.0;
+        for (size_t n = 0; n < N; ++n)
+        {
+            const double phase = -2.0 * M_PI * static_cast<double>(k * n % N) / N;
+            re += in[n] * cos(phase);
+            im += in[n] * sin(phase);
+        }
+        powerOut[k] = re * re + im * im;
+    }
+}
+
+// 单精度直接 DFT（三角函数查表），作为耗时对照
+static void naiveDft(const float *in, const float *cosTable, const float *sinTable, float *powerOut)
+{
+    for (size_t k = 0; k < BINS; ++k)
+    {
+        float re = 0.0f;
+        float im = 0.0f;
+        for (size_t n = 0; n < N; ++n)
+        {
+            const size_t i = k * n % N;
+            re += in[n] * cosTable[i];
+            im -= in[n] * sinTable[i];
+        }
+        powerOut[k] = re * re + im * im;
+    }
+}
+
+// 纵向 25 Hz、偏航 60 Hz 的正弦振动加噪声
+static void signalAt(uint32_t micros, float accel[3], float gyro[3])
+{
+    const float t = micros / 1e6f;
+    accel[0] = noise(0.05f);
+    accel[1] = noise(0.05f);
+    accel[2] = sinf(2.0f * static_cast<float>(M_PI) * 25.0f * t) + noise(0.05f);
+    gyro[0] = noise(0.2f);
+    gyro[1] = noise(0.2f);
+    gyro[2] = 3.0f * sinf(2.0f * static_cast<float>(M_PI) * 60.0f * t) + noise(0.2f);
+}
+
+static void computeWindow()
+{
+    int steps = 0;
+    while (spectrumStep())
+    {
+        ++steps;
+    }
+    TEST_ASSERT_EQUAL(SPECTRUM_CHANNELS, steps);
+}
+
+void setUp()
+{
+    noiseState = 1;
+    spectrumInit(storage);
+}
+
+void tearDown()
+{
+}
+
+void test_fft_matches_reference_dft()
+{
+    static float in[N];
+    static float fft[BINS];
+    static double dft[BINS];
+    double worst = 0.0;
+    for (int trial = 0; trial < 8; ++trial)
+    {
+        double energy = 0.0;
+        for (size_t n = 0; n < N; ++n)
+        {
+            in[n] = noise(1.0f) + (trial % 2 == 0 ? 0.0f : sinf(2.0f * static_cast<float>(M_PI) * (trial + 3) * n / N));
+            energy += in[n] * in[n];
+        }
+        spectrumRealFftPower(in, fft);
+        referenceDft(in, dft);
+        // Parseval：Σ|X|² 的量级为 N·Σx²，误差按它归一化
+        const double scale = N * energy;
+        for (size_t k = 0; k < BINS; ++k)
+        {
+            const double error = fabs(fft[k] - dft[k]) / scale;
+            worst = error > worst ? error : worst;
+        }
+    }
+    char message[96];
+    snprintf(message, sizeof(message), "FFT 与 DFT 的最大频点误差 %.2e（相对总能量）", worst);
+    TEST_MESSAGE(message);
+    TEST_ASSERT_TRUE(worst < 1e-5);
+}
+
+void test_fft_benchmark_against_dft()
+{
+    static float in[N];
+    static float out[BINS];
+    static float cosTable[N];
+    static float sinTable[N];
+    for (size_t n = 0; n < N; ++n)
+    {
+        in[n] = noise(1.0f);
+        cosTable[n] = cosf(2.0f * static_cast<float>(M_PI) * n / N);
+        sinTable[n] = sinf(2.0f * static_cast<float>(M_PI) * n / N);
+    }
+    static constexpr int ROUNDS = 200;
+    volatile float sink = 0.0f;
+
+    const auto fftStart = std::chrono::steady_clock::now();
+    for (int i = 0; i < ROUNDS; ++i)
+    {
+        spectrumRealFftPower(in, out);
+        sink = sink + out[i % BINS];
+    }
+    const auto fftEnd = std::chrono::steady_clock::now();
+    for (int i = 0; i < ROUNDS; ++i)
+    {
+        naiveDft(in, cosTable, sinTable, out);
+        sink = sink + out[i % BINS];
+    }
+    const auto dftEnd = std::chrono::steady_clock::now();
+
+    const double fftUs = std::chrono::duration<double, std::micro>(fftEnd - fftStart).count() / ROUNDS;
+    const double dftUs = std::chrono::duration<double, std::micro>(dftEnd - fftEnd).count() / ROUNDS;
+    char message[128];
+    snprintf(message, sizeof(message), "%u 点实数 FFT %.2f us，直接 DFT %.2f us（主机，%.0f 倍）", static_cast<unsigned>(N), fftUs, dftUs,
+             dftUs / fftUs);
+    TEST_MESSAGE(message);
+    TEST_ASSERT_TRUE(fftUs * 5.0 < dftUs);
+}
+
+// 按传感器任务的采样时刻逐个输入：实测采样率 500 Hz，主频误差小于四分之一频点
+void test_true_rate_samples_find_dominant_frequency()
+{
+    float accel[3];
+    float gyro[3];
+    for (uint32_t i = 0; i < N; ++i)
+    {
+        const uint32_t micros = 1000000 + i * SAMPLE_US;
+        signalAt(micros, accel, gyro);
+        spectrumPush(micros, accel, gyro);
+    }
+    computeWindow();
+    const SpectrumMetrics &metrics = spectrumGetMetrics();
+    const float binHz = 500.0f / N;
+    TEST_ASSERT_FLOAT_WITHIN(0.5f, 500.0f, metrics.sampleRateHz);
+    const SpectrumResult &vertical = spectrumGetResult(SpectrumChannel::AccelZ);
+    const SpectrumResult &yaw = spectrumGetResult(SpectrumChannel::GyroZ);
+    TEST_ASSERT_FLOAT_WITHIN(binHz / 4.0f, 25.0f, vertical.dominantHz);
+    TEST_ASSERT_FLOAT_WITHIN(binHz / 4.0f, 60.0f, yaw.dominantHz);
+    TEST_ASSERT_FLOAT_WITHIN(0.05f, sqrtf(0.5f), vertical.rms);
+    // 25 Hz 落在 15~30 Hz 频带，60 Hz 落在 30 Hz 以上频带
+    TEST_ASSERT_GREATER_THAN_FLOAT(0.9f * vertical.rms * vertical.rms, vertical.bandEnergy[2]);
+    TEST_ASSERT_GREATER_THAN_FLOAT(0.9f * yaw.rms * yaw.rms, yaw.bandEnergy[3]);
+}
+
+// 对照：只在 loop 中输入最新快照（周期 6 ms、抖动 ±3 ms）。不均匀的采样按平均间隔当作均匀序列计算，
+// 主频偏离真实值，奈奎斯特频率也降到约 83 Hz
+void test_loop_rate_feeding_misestimates()
+{
+    float accel[3];
+    float gyro[3];
+    uint32_t micros = 1000000;
+    for (size_t i = 0; i < N; ++i)
+    {
+        micros += 6000 + static_cast<int32_t>(noise(3000.0f));
+        const uint32_t sampleMicros = micros - micros % SAMPLE_US; // loop 看到的是最近一次传感器样本
+        signalAt(sampleMicros, accel, gyro);
+        spectrumPush(micros, accel, gyro);
+    }
+    computeWindow();
+    const SpectrumMetrics &metrics = spectrumGetMetrics();
+    const SpectrumResult &vertical = spectrumGetResult(SpectrumChannel::AccelZ);
+    const SpectrumResult &yaw = spectrumGetResult(SpectrumChannel::GyroZ);
+    char message[128];
+    snprintf(message, sizeof(message), "loop 周期输入：采样率 %.1f Hz，Az 主频 %.2f Hz（真实 25），Gz 主频 %.2f Hz（真实 60）", metrics.sampleRateHz,
+             vertical.dominantHz, yaw.dominantHz);
+    TEST_MESSAGE(message);
+    TEST_ASSERT_FLOAT_WITHIN(30.0f, 166.7f, metrics.sampleRateHz);
+    TEST_ASSERT_GREATER_THAN_FLOAT(2.0f, fabsf(yaw.dominantHz - 60.0f));
+}
+
+int main(int, char **)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_fft_matches_reference_dft);
+    RUN_TEST(test_fft_benchmark_against_dft);
+    RUN_TEST(test_true_rate_samples_find_dominant_frequency);
+    RUN_TEST(test_loop_rate_feeding_misestimates);
+    return UNITY_END();
+}
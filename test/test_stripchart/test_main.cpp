@@ -0,0 +1,186 @@
+// 曲线页的量程与光栅化检查：用与 SSD1306 显存相同布局的帧缓冲模型按设备端的方式更新
+// （量程变化时整屏重绘，否则只写最新列与光标列），每次更新后与按当前历史整屏光栅化的结果逐字节比对；
+// 量程按 2 的幂放大、带回差缩小，数值映射到各自条带内的行。
+#include <unity.h>
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+#include "stripchart.h"
+
+static uint8_t screen[STRIP_WIDTH][STRIP_PAGES];
+static uint32_t fullRedraws = 0;
+
+static void redrawAll()
+{
+    for (size_t x = 0; x < STRIP_WIDTH; ++x)
+    {
+        stripChartColumn(x, screen[x]);
+    }
+    ++fullRedraws;
+}
+
+// 与 display.cpp 的 updateStripChart 相同的更新策略，返回是否整屏重绘
+static bool push(float distance, float yawRate, float motor)
+{
+    const float values[STRIP_TRACES] = {distance, yawRate, motor};
+    if (stripChartPush(values))
+    {
+        redrawAll();
+        return true;
+    }
+    stripChartColumn(stripChartHead(), screen[stripChartHead()]);
+    stripChartColumn(stripChartCursor(), screen[stripChartCursor()]);
+    return false;
+}
+
+static bool pixel(const uint8_t column[STRIP_PAGES], int row)
+{
+    return (column[row / 8] >> (row % 8)) & 1u;
+}
+
+// 列中属于某一条带（行 top~top+height-1）的点亮行数
+static int litRows(const uint8_t column[STRIP_PAGES], int top, int height)
+{
+    int count = 0;
+    for (int row = top; row < top + height; ++row)
+    {
+        count += pixel(column, row) ? 1 : 0;
+    }
+    return count;
+}
+
+void setUp()
+{
+    stripChartReset();
+    memset(screen, 0, sizeof(screen));
+    fullRedraws = 0;
+    redrawAll(); // 进入页面时整屏重绘
+}
+
+void tearDown()
+{
+}
+
+// 30 s 的变化信号（含超出量程、无回波与跨越量程边界），增量更新的屏幕始终等于整屏光栅化
+void test_incremental_updates_match_full_raster()
+{
+    uint8_t expected[STRIP_PAGES];
+    for (int i = 0; i < 750; ++i)
+    {
+        const float s = i * STRIP_INTERVAL_MS / 1000.0f;
+        const float distance = (i / 50) % 5 == 4 ? NAN : 60.0f + 50.0f * sinf(s * 0.7f) + (i > 400 ? 150.0f : 0.0f);
+        const float yawRate = (i % 97 < 10) ? 180.0f : 6.0f * sinf(s * 3.0f);
+        const float motor = i < 300 ? 150.0f : -200.0f * cosf(s);
+        push(distance, yawRate, motor);
+        for (size_t x = 0; x < STRIP_WIDTH; ++x)
+        {
+            stripChartColumn(x, expected);
+            TEST_ASSERT_EQUAL_UINT8_ARRAY(expected, screen[x], STRIP_PAGES);
+        }
+    }
+    const StripChartMetrics &metrics = stripChartGetMetrics();
+    char message[96];
+    snprintf(message, sizeof(message), "750 列：整屏重绘 %u 次（量程变化 %u 次）", static_cast<unsigned>(fullRedraws - 1),
+             static_cast<unsigned>(metrics.rescales));
+    TEST_MESSAGE(message);
+    TEST_ASSERT_EQUAL_UINT32(750, metrics.columns);
+    TEST_ASSERT_EQUAL_UINT32(metrics.rescales, fullRedraws - 1);
+    TEST_ASSERT_LESS_THAN_UINT32(40, metrics.rescales);
+}
+
+void test_cursor_follows_head_and_stays_blank()
+{
+    for (size_t i = 0; i < STRIP_WIDTH + 5; ++i)
+    {
+        push(50.0f, 0.0f, 100.0f);
+        TEST_ASSERT_EQUAL(i % STRIP_WIDTH, stripChartHead());
+        TEST_ASSERT_EQUAL((i + 1) % STRIP_WIDTH, stripChartCursor());
+        uint8_t column[STRIP_PAGES];
+        stripChartColumn(stripChartCursor(), column);
+        for (size_t page = 0; page < STRIP_PAGES; ++page)
+        {
+            TEST_ASSERT_EQUAL_UINT8(0, column[page]);
+        }
+    }
+}
+
+// 量程按 minSpan·2^k 放大；峰值离开窗口且低于量程的 40% 才缩小
+void test_rescale_grows_by_powers_of_two_and_shrinks_with_hysteresis()
+{
+    TEST_ASSERT_EQUAL_FLOAT(8.0f, stripChartSpan(StripTrace::YawRate));
+    push(50.0f, 20.0f, 0.0f);
+    TEST_ASSERT_EQUAL_FLOAT(32.0f, stripChartSpan(StripTrace::YawRate));
+    push(50.0f, -33.0f, 0.0f);
+    TEST_ASSERT_EQUAL_FLOAT(64.0f, stripChartSpan(StripTrace::YawRate));
+    push(50.0f, 1000.0f, 0.0f); // 超出上限：量程封顶，点限制在条带边缘
+    TEST_ASSERT_EQUAL_FLOAT(512.0f, stripChartSpan(StripTrace::YawRate));
+
+    // 大值仍在窗口内时不缩小：再推入 126 列后第 0 列已被覆盖、第 1 列成为光标，1000 仍在屏上
+    for (size_t i = 0; i < STRIP_WIDTH - 2; ++i)
+    {
+        TEST_ASSERT_FALSE(push(50.0f, 5.0f, 0.0f));
+    }
+    TEST_ASSERT_EQUAL_FLOAT(512.0f, stripChartSpan(StripTrace::YawRate));
+    // 1000 那一列成为光标列后不再参与量程，缩小到能容纳剩余峰值 5 的最小量程
+    TEST_ASSERT_TRUE(push(50.0f, 5.0f, 0.0f));
+    TEST_ASSERT_EQUAL_FLOAT(8.0f, stripChartSpan(StripTrace::YawRate));
+
+    // 在量程边界附近来回变化：放大后峰值不低于量程的 40%，不会反复缩放
+    stripChartReset();
+    const uint32_t before = stripChartGetMetrics().rescales;
+    for (int i = 0; i < 1000; ++i)
+    {
+        push(50.0f, (i % 2) ? 30.0f : 34.0f, 0.0f);
+    }
+    TEST_ASSERT_EQUAL_UINT32(before + 1, stripChartGetMetrics().rescales);
+    TEST_ASSERT_EQUAL_FLOAT(64.0f, stripChartSpan(StripTrace::YawRate));
+}
+
+// 条带布局：距离 0~20 行，偏航 22~42 行，电机 44~63 行，第 21、43 行每 4 列一个虚线点
+void test_raster_maps_values_into_bands()
+{
+    push(25.0f, 8.0f, -32.0f); // 各曲线的量程上限/下限
+    push(0.0f, -8.0f, 32.0f);
+    push(NAN, 0.0f, 0.0f);
+    uint8_t column[STRIP_PAGES];
+
+    stripChartColumn(0, column);
+    TEST_ASSERT_TRUE(pixel(column, 0));  // 距离 = 量程：条带顶行
+    TEST_ASSERT_TRUE(pixel(column, 22)); // 偏航 = +量程
+    TEST_ASSERT_TRUE(pixel(column, 63)); // 电机 = −量程：底行
+    TEST_ASSERT_TRUE(pixel(column, 21)); // 第 0 列有分隔虚线
+    TEST_ASSERT_TRUE(pixel(column, 43));
+    TEST_ASSERT_EQUAL(1, litRows(column, 0, 21));
+
+    // 第 1 列从上一列的值连成竖线：每条曲线都占满自己的条带，且不越界
+    stripChartColumn(1, column);
+    TEST_ASSERT_EQUAL(21, litRows(column, 0, 21));
+    TEST_ASSERT_EQUAL(21, litRows(column, 22, 21));
+    TEST_ASSERT_EQUAL(20, litRows(column, 44, 20));
+    TEST_ASSERT_FALSE(pixel(column, 21));
+    TEST_ASSERT_FALSE(pixel(column, 43));
+
+    // 第 2 列：距离无回波不画点；对称曲线在第 2 列画零线，数值 0 正好落在零线上
+    stripChartColumn(2, column);
+    TEST_ASSERT_EQUAL(0, litRows(column, 0, 21));
+    TEST_ASSERT_TRUE(pixel(column, 22 + 10));
+    TEST_ASSERT_TRUE(pixel(column, 44 + 9)); // 20 行的条带零点四舍五入到第 10 级
+    // 偏航从 −8 回到 0：连线覆盖零线到条带底部
+    TEST_ASSERT_EQUAL(11, litRows(column, 22, 21));
+
+    // 尚未填充的列只有虚线与零线
+    stripChartColumn(6, column);
+    TEST_ASSERT_EQUAL(0, litRows(column, 0, 21));
+    TEST_ASSERT_EQUAL(1, litRows(column, 22, 21));
+    TEST_ASSERT_EQUAL(1, litRows(column, 44, 20));
+}
+
+int main(int, char **)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_incremental_updates_match_full_raster);
+    RUN_TEST(test_cursor_follows_head_and_stays_blank);
+    RUN_TEST(test_rescale_grows_by_powers_of_two_and_shrinks_with_hysteresis);
+    RUN_TEST(test_raster_maps_values_into_bands);
+    return UNITY_END();
+}
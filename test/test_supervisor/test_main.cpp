@@ -0,0 +1,123 @@
+// 监督模块的故障注入：连续故障与数据陈旧进入降级、连续有效数据恢复、非活动子系统不检查新鲜度、
+// 截止时间错过计数与恢复尝试限速。
+#include <unity.h>
+#include "supervisor.h"
+
+// 只让被测子系统参与新鲜度检查，避免其他子系统的陈旧影响 supervisorEvaluate 的返回值
+static void isolate(Subsystem subsystem)
+{
+    for (size_t i = 0; i < SUBSYSTEM_COUNT; ++i)
+    {
+        supervisorSetActive(static_cast<Subsystem>(i), static_cast<Subsystem>(i) == subsystem);
+    }
+}
+
+void setUp()
+{
+    supervisorInit(1000);
+}
+
+void tearDown()
+{
+}
+
+void test_consecutive_faults_degrade_and_fresh_recovers()
+{
+    const SupervisorBudget &budget = supervisorGetBudget(Subsystem::Imu);
+    for (uint8_t i = 1; i < budget.faultThreshold; ++i)
+    {
+        supervisorReportFault(Subsystem::Imu, 1000 + i);
+        TEST_ASSERT_FALSE(supervisorDegraded(Subsystem::Imu));
+    }
+    // 中间一次有效数据清零连续故障计数
+    supervisorReportFresh(Subsystem::Imu, 1010);
+    for (uint8_t i = 0; i < budget.faultThreshold; ++i)
+    {
+        supervisorReportFault(Subsystem::Imu, 1020 + i);
+    }
+    TEST_ASSERT_TRUE(supervisorDegraded(Subsystem::Imu));
+
+    // 恢复需要连续的有效数据，中途故障重新计数
+    for (uint8_t i = 1; i < budget.recoverThreshold; ++i)
+    {
+        supervisorReportFresh(Subsystem::Imu, 1100 + i);
+    }
+    supervisorReportFault(Subsystem::Imu, 1110);
+    for (uint8_t i = 1; i < budget.recoverThreshold; ++i)
+    {
+        supervisorReportFresh(Subsystem::Imu, 1120 + i);
+    }
+    TEST_ASSERT_TRUE(supervisorDegraded(Subsystem::Imu));
+    supervisorReportFresh(Subsystem::Imu, 1130);
+    TEST_ASSERT_FALSE(supervisorDegraded(Subsystem::Imu));
+
+    const SubsystemHealth &health = supervisorGetHealth(Subsystem::Imu);
+    TEST_ASSERT_EQUAL_UINT32(1, health.degradations);
+    TEST_ASSERT_EQUAL_UINT32(1, health.recoveries);
+    TEST_ASSERT_EQUAL_UINT32(budget.faultThreshold * 2 + 0u, health.faults);
+}
+
+void test_stale_data_degrades_only_while_active()
+{
+    isolate(Subsystem::Ranging);
+    const uint32_t freshness = supervisorGetBudget(Subsystem::Ranging).freshnessMs;
+    supervisorReportFresh(Subsystem::Ranging, 1000);
+    TEST_ASSERT_FALSE(supervisorEvaluate(1000 + freshness));
+    TEST_ASSERT_TRUE(supervisorEvaluate(1001 + freshness));
+    TEST_ASSERT_TRUE(supervisorDegraded(Subsystem::Ranging));
+    TEST_ASSERT_EQUAL_UINT32(1, supervisorGetHealth(Subsystem::Ranging).staleEvents);
+    // 已降级时不重复计数
+    TEST_ASSERT_FALSE(supervisorEvaluate(2000 + freshness));
+    TEST_ASSERT_EQUAL_UINT32(1, supervisorGetHealth(Subsystem::Ranging).staleEvents);
+}
+
+// 停车期间测距放缓：非活动时任意长的间隔都不算陈旧，重新激活后从最后一次非活动检查的时刻重新计时
+void test_inactive_subsystem_restarts_freshness_on_activation()
+{
+    isolate(Subsystem::Ranging);
+    const uint32_t freshness = supervisorGetBudget(Subsystem::Ranging).freshnessMs;
+    supervisorSetActive(Subsystem::Ranging, false);
+    for (uint32_t t = 1000; t <= 10000; t += 100)
+    {
+        TEST_ASSERT_FALSE(supervisorEvaluate(t));
+    }
+    supervisorSetActive(Subsystem::Ranging, true);
+    TEST_ASSERT_FALSE(supervisorEvaluate(10000 + freshness));
+    TEST_ASSERT_TRUE(supervisorEvaluate(10001 + freshness));
+    TEST_ASSERT_EQUAL_UINT32(0, supervisorGetHealth(Subsystem::Ranging).recoveries);
+}
+
+void test_deadline_misses_are_counted()
+{
+    const uint32_t deadline = supervisorGetBudget(Subsystem::Control).deadlineUs;
+    supervisorReportDuration(Subsystem::Control, deadline);
+    supervisorReportDuration(Subsystem::Control, deadline + 500);
+    supervisorReportDuration(Subsystem::Control, deadline + 100);
+    supervisorReportDuration(Subsystem::Control, deadline / 2);
+    const SubsystemHealth &health = supervisorGetHealth(Subsystem::Control);
+    TEST_ASSERT_EQUAL_UINT32(2, health.deadlineMisses);
+    TEST_ASSERT_EQUAL_UINT32(deadline + 100, health.lastMissUs);
+    TEST_ASSERT_EQUAL_UINT32(deadline / 2, health.lastDurationUs);
+    TEST_ASSERT_EQUAL_UINT32(deadline + 500, health.maxDurationUs);
+    // 截止时间错过只计数，不触发降级
+    TEST_ASSERT_FALSE(supervisorDegraded(Subsystem::Control));
+}
+
+void test_retry_is_rate_limited()
+{
+    TEST_ASSERT_FALSE(supervisorShouldRetry(Subsystem::Display, 1500, 1000));
+    TEST_ASSERT_TRUE(supervisorShouldRetry(Subsystem::Display, 2000, 1000));
+    TEST_ASSERT_FALSE(supervisorShouldRetry(Subsystem::Display, 2999, 1000));
+    TEST_ASSERT_TRUE(supervisorShouldRetry(Subsystem::Display, 3000, 1000));
+}
+
+int main(int, char **)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_consecutive_faults_degrade_and_fresh_recovers);
+    RUN_TEST(test_stale_data_degrades_only_while_active);
+    RUN_TEST(test_inactive_subsystem_restarts_freshness_on_activation);
+    RUN_TEST(test_deadline_misses_are_counted);
+    RUN_TEST(test_retry_is_rate_limited);
+    return UNITY_END();
+}
@@ -0,0 +1,285 @@
+// 温度-零偏模型的合成升温检查：芯片温度从 22 °C 按指数曲线升到约 55 °C，零偏随温度二次变化；
+// 行驶与停车交替，只在停车期间（500 Hz）学习。查询误差与只用开机零偏的误差对照，
+// 并检查单侧数据的边缘表点（升温过程中最常见）不偏向数据一侧；
+// 行驶-停车交替时只用 ZUPT 与叠加温度模型的航向漂移对照。
+#include <unity.h>
+#include <math.h>
+#include <stdio.h>
+#include "thermal_bias.h"
+
+static constexpr float DT = 0.002f;
+static constexpr float GRAVITY = 9.81f;
+
+static uint32_t noiseState = 1;
+
+static float noise(float amplitude)
+{
+    noiseState = noiseState * 1664525u + 1013904223u;
+    return ((noiseState >> 8) / 16777216.0f * 2.0f - 1.0f) * amplitude;
+}
+
+static void trueGyroBias(float temperatureC, float out[3])
+{
+    const float d = temperatureC - 25.0f;
+    out[0] = 0.2f + 0.010f * d;
+    out[1] = -0.3f - 0.015f * d + 0.0002f * d * d;
+    out[2] = 0.5f + 0.030f * d + 0.0008f * d * d;
+}
+
+static float trueAccelZ(float temperatureC)
+{
+    return GRAVITY + 0.004f * (temperatureC - 25.0f);
+}
+
+static float warmUp(float seconds)
+{
+    return 55.0f - 33.0f * expf(-seconds / 300.0f);
+}
+
+static void learnAt(float temperatureC, float seconds)
+{
+    const int samples = static_cast<int>(seconds / DT);
+    for (int i = 0; i < samples; ++i)
+    {
+        float gyro[3];
+        trueGyroBias(temperatureC, gyro);
+        for (float &g : gyro)
+        {
+            g += noise(0.3f);
+        }
+        thermalBiasLearnGyro(temperatureC + noise(0.05f), gyro);
+        thermalBiasLearnAccelZ(temperatureC, trueAccelZ(temperatureC) + noise(0.05f));
+    }
+}
+
+// 升温 20 分钟：每分钟行驶 50 s、停车 10 s，停车期间温度按升温曲线继续变化
+static void learnWarmUp()
+{
+    for (int minute = 0; minute < 20; ++minute)
+    {
+        for (int s = 50; s < 60; ++s)
+        {
+            learnAt(warmUp(minute * 60.0f + s), 1.0f);
+        }
+    }
+}
+
+// 行驶 40 s、停车 3 s 交替 30 分钟。ZUPT 在每次停车结束时已跟上当时的零偏（理想化），
+// 行驶中的航向误差来自零偏相对停车时刻的变化；有模型时陀螺先减去 model(T) - model(T_校准)，只剩模型没描述的部分。
+// 返回每次行驶的航向误差绝对值按行驶时间折算的 °/min
+static float driveCycleDrift(bool useModel, bool learn, float *worstDeg)
+{
+    static constexpr float DRIVE_S = 40.0f;
+    static constexpr float STOP_S = 3.0f;
+    static constexpr float STEP_S = 0.1f;
+    const float referenceC = warmUp(0.0f);
+    float totalDeg = 0.0f;
+    float drivingS = 0.0f;
+    *worstDeg = 0.0f;
+    // 陀螺 Z 轴在模型修正后的残余零偏
+    auto residual = [&](float temperatureC) {
+        float truth[3];
+        trueGyroBias(temperatureC, truth);
+        float now[3];
+        float reference[3];
+        if (useModel && thermalBiasGyro(temperatureC, now) && thermalBiasGyro(referenceC, reference))
+        {
+            return truth[2] - (now[2] - reference[2]);
+        }
+        return truth[2];
+    };
+    float t = 0.0f;
+    while (t < 30 * 60.0f)
+    {
+        if (learn)
+        {
+            learnAt(warmUp(t), STOP_S);
+        }
+        t += STOP_S;
+        const float tracked = residual(warmUp(t));
+        float headingDeg = 0.0f;
+        for (float s = 0.0f; s < DRIVE_S; s += STEP_S)
+        {
+            headingDeg += (residual(warmUp(t + s)) - tracked) * STEP_S;
+        }
+        t += DRIVE_S;
+        totalDeg += fabsf(headingDeg);
+        drivingS += DRIVE_S;
+        *worstDeg = fmaxf(*worstDeg, fabsf(headingDeg));
+    }
+    return totalDeg / (drivingS / 60.0f);
+}
+
+void setUp()
+{
+    noiseState = 1;
+    thermalBiasReset();
+}
+
+void tearDown()
+{
+}
+
+void test_empty_model_has_no_answer()
+{
+    float gyro[3];
+    float accelZ;
+    TEST_ASSERT_FALSE(thermalBiasGyro(30.0f, gyro));
+    TEST_ASSERT_FALSE(thermalBiasAccelZ(30.0f, &accelZ));
+    TEST_ASSERT_EQUAL(0, thermalBiasValidBins());
+    // 不到 THERMAL_BIAS_MIN_WEIGHT 个样本的表点不参与插值
+    learnAt(30.0f, (THERMAL_BIAS_MIN_WEIGHT - 10) * DT);
+    TEST_ASSERT_FALSE(thermalBiasGyro(30.0f, gyro));
+    learnAt(30.0f, 20 * DT);
+    TEST_ASSERT_TRUE(thermalBiasGyro(30.0f, gyro));
+    TEST_ASSERT_EQUAL(1, thermalBiasValidBins());
+}
+
+void test_warm_up_tracks_bias_across_range()
+{
+    learnWarmUp();
+    const float startC = warmUp(50.0f);
+    const float endC = warmUp(19 * 60.0f + 59.0f);
+    float bootBias[3];
+    trueGyroBias(startC, bootBias);
+    float worstModel = 0.0f;
+    float worstBoot = 0.0f;
+    float worstAccel = 0.0f;
+    for (float t = startC; t <= endC; t += 0.5f)
+    {
+        float truth[3];
+        float model[3];
+        trueGyroBias(t, truth);
+        TEST_ASSERT_TRUE(thermalBiasGyro(t, model));
+        for (int axis = 0; axis < 3; ++axis)
+        {
+            worstModel = fmaxf(worstModel, fabsf(model[axis] - truth[axis]));
+            worstBoot = fmaxf(worstBoot, fabsf(bootBias[axis] - truth[axis]));
+        }
+        float accelZ;
+        TEST_ASSERT_TRUE(thermalBiasAccelZ(t, &accelZ));
+        worstAccel = fmaxf(worstAccel, fabsf(accelZ - trueAccelZ(t)));
+    }
+    char message[128];
+    snprintf(message, sizeof(message), "%.1f~%.1f °C，%u 个表点：陀螺零偏误差最大 %.3f°/s（仅开机零偏 %.3f°/s），Z 轴 %.4f m/s²", startC,
+             endC, static_cast<unsigned>(thermalBiasValidBins()), worstModel, worstBoot, worstAccel);
+    TEST_MESSAGE(message);
+    TEST_ASSERT_LESS_THAN_FLOAT(0.04f, worstModel);
+    TEST_ASSERT_GREATER_THAN_FLOAT(1.0f, worstBoot);
+    TEST_ASSERT_LESS_THAN_FLOAT(0.01f, worstAccel);
+}
+
+// 模型在行驶-停车中在线学习即可明显降低航向漂移；沿用上一次升温学到的模型（开机载入）时更低。
+// 第三轮不再学习，使用第二轮结束时的模型
+void test_model_reduces_heading_drift()
+{
+    float zuptWorst;
+    float onlineWorst;
+    float loadedWorst;
+    const float zuptOnly = driveCycleDrift(false, false, &zuptWorst);
+    const float online = driveCycleDrift(true, true, &onlineWorst);
+    const float loaded = driveCycleDrift(true, false, &loadedWorst);
+    char message[160];
+    snprintf(message, sizeof(message), "航向漂移：仅 ZUPT %.2f °/min（单次最大 %.2f°），在线学习 %.2f °/min（%.2f°），载入模型 %.2f °/min（%.2f°）",
+             zuptOnly, zuptWorst, online, onlineWorst, loaded, loadedWorst);
+    TEST_MESSAGE(message);
+    TEST_ASSERT_LESS_THAN_FLOAT(zuptOnly * 0.75f, online); // 前几次停车时模型还是空的
+    TEST_ASSERT_LESS_THAN_FLOAT(online, loaded);
+    TEST_ASSERT_LESS_THAN_FLOAT(zuptWorst, loadedWorst);
+}
+
+// 只有 46~49 °C 的数据：45 与 50 °C 两个表点都只有单侧数据，回归外推到表点温度，
+// 直接平均会把 45 °C 表点拉向约 47.5 °C 的零偏
+void test_one_sided_bin_is_not_biased_toward_data()
+{
+    for (float t = 46.0f; t <= 49.0f; t += 0.25f)
+    {
+        learnAt(t, 1.0f);
+    }
+    float truth[3];
+    float model[3];
+    trueGyroBias(46.0f, truth);
+    TEST_ASSERT_TRUE(thermalBiasGyro(46.0f, model));
+    float naive[3];
+    trueGyroBias(47.5f, naive);
+    char message[96];
+    snprintf(message, sizeof(message), "46 °C 处 Z 轴：模型 %.3f，真实 %.3f，数据平均 %.3f", model[2], truth[2], naive[2]);
+    TEST_MESSAGE(message);
+    TEST_ASSERT_FLOAT_WITHIN(0.02f, truth[2], model[2]);
+    TEST_ASSERT_GREATER_THAN_FLOAT(0.04f, fabsf(naive[2] - truth[2]));
+}
+
+// 超出有数据的范围时取最近的表点，不做外推；只在单一温度停车时斜率收缩到 0，不被噪声放大
+void test_lookup_clamps_outside_learned_range()
+{
+    learnAt(30.0f, 2.0f);
+    learnAt(35.0f, 2.0f);
+    float at30[3];
+    float at35[3];
+    float cold[3];
+    float hot[3];
+    float truth[3];
+    TEST_ASSERT_TRUE(thermalBiasGyro(30.0f, at30));
+    TEST_ASSERT_TRUE(thermalBiasGyro(35.0f, at35));
+    trueGyroBias(30.0f, truth);
+    TEST_ASSERT_FLOAT_WITHIN(0.03f, truth[2], at30[2]);
+    TEST_ASSERT_TRUE(thermalBiasGyro(-5.0f, cold));
+    TEST_ASSERT_TRUE(thermalBiasGyro(80.0f, hot));
+    for (int axis = 0; axis < 3; ++axis)
+    {
+        TEST_ASSERT_FLOAT_WITHIN(1e-5f, at30[axis], cold[axis]);
+        TEST_ASSERT_FLOAT_WITHIN(1e-5f, at35[axis], hot[axis]);
+    }
+}
+
+// 权重封顶后按固定窗口继续更新：零偏整体漂移（器件老化）后模型能跟上
+void test_capped_weight_follows_aging()
+{
+    learnAt(40.0f, 20.0f);
+    float before[3];
+    TEST_ASSERT_TRUE(thermalBiasGyro(40.0f, before));
+    for (int i = 0; i < static_cast<int>(60.0f / DT); ++i)
+    {
+        float gyro[3];
+        trueGyroBias(40.0f, gyro);
+        gyro[2] += 0.2f + noise(0.3f);
+        thermalBiasLearnGyro(40.0f, gyro);
+    }
+    float after[3];
+    TEST_ASSERT_TRUE(thermalBiasGyro(40.0f, after));
+    TEST_ASSERT_FLOAT_WITHIN(0.03f, before[2] + 0.2f, after[2]);
+}
+
+void test_table_round_trip_and_version_check()
+{
+    learnWarmUp();
+    ThermalBiasTable saved;
+    thermalBiasGetTable(&saved);
+    float expected[3];
+    TEST_ASSERT_TRUE(thermalBiasGyro(40.0f, expected));
+    const size_t bins = thermalBiasValidBins();
+
+    thermalBiasReset();
+    TEST_ASSERT_TRUE(thermalBiasLoad(saved));
+    float loaded[3];
+    TEST_ASSERT_TRUE(thermalBiasGyro(40.0f, loaded));
+    TEST_ASSERT_EQUAL_FLOAT(expected[2], loaded[2]);
+    TEST_ASSERT_EQUAL(bins, thermalBiasValidBins());
+
+    saved.version = THERMAL_BIAS_TABLE_VERSION + 1;
+    TEST_ASSERT_FALSE(thermalBiasLoad(saved));
+    TEST_ASSERT_EQUAL(0, thermalBiasValidBins());
+}
+
+int main(int, char **)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_empty_model_has_no_answer);
+    RUN_TEST(test_warm_up_tracks_bias_across_range);
+    RUN_TEST(test_model_reduces_heading_drift);
+    RUN_TEST(test_one_sided_bin_is_not_biased_toward_data);
+    RUN_TEST(test_lookup_clamps_outside_learned_range);
+    RUN_TEST(test_capped_weight_follows_aging);
+    RUN_TEST(test_table_round_trip_and_version_check);
+    return UNITY_END();
+}
@@ -0,0 +1,132 @@
+// 静止检测与零偏跟踪的合成轨迹检查：500 Hz 样本，加速度与角速度叠加确定性伪随机噪声。
+#include <unity.h>
+#include <math.h>
+#include <stdio.h>
+#include "zupt.h"
+
+static constexpr float DT = 0.002f;
+static constexpr float GRAVITY = 9.81f;
+
+static uint32_t noiseState = 1;
+
+// 均匀分布于 [-amplitude, amplitude]
+static float noise(float amplitude)
+{
+    noiseState = noiseState * 1664525u + 1013904223u;
+    return ((noiseState >> 8) / 16777216.0f * 2.0f - 1.0f) * amplitude;
+}
+
+struct Motion
+{
+    float vibration; // 竖直方向振动幅值（m/s²）
+    float yawRate;   // 真实偏航角速度（°/s）
+    bool motorsIdle;
+};
+
+// 输入 durationS 秒的样本，gyroBiasZ 为陀螺 Z 轴的真实零偏，返回进入静止所用时间（ms，未进入为 UINT32_MAX）
+static uint32_t feed(float durationS, const Motion &motion, float gyroBiasZ)
+{
+    uint32_t enteredMs = UINT32_MAX;
+    const int samples = static_cast<int>(durationS / DT);
+    for (int i = 0; i < samples; ++i)
+    {
+        const float accel[3] = {noise(0.05f), noise(0.05f), GRAVITY + noise(0.05f) + motion.vibration * sinf(2.0f * 3.14159265f * 25.0f * i * DT)};
+        const float gyro[3] = {0.1f + noise(0.3f), -0.2f + noise(0.3f), gyroBiasZ + motion.yawRate + noise(0.3f)};
+        if (zuptUpdate(DT, accel, gyro, motion.motorsIdle) && enteredMs == UINT32_MAX)
+        {
+            enteredMs = static_cast<uint32_t>((i + 1) * DT * 1000.0f + 0.5f);
+        }
+    }
+    return enteredMs;
+}
+
+static const Motion STILL = {0.0f, 0.0f, true};
+static const Motion DRIVING = {1.5f, 0.0f, false};
+
+void setUp()
+{
+    noiseState = 1;
+    const float bias[3] = {0.1f, -0.2f, 0.5f};
+    zuptInit(bias);
+}
+
+void tearDown()
+{
+}
+
+void test_enters_stationary_after_hold_time()
+{
+    const uint32_t enteredMs = feed(2.0f, STILL, 0.5f);
+    TEST_ASSERT_GREATER_OR_EQUAL_UINT32(ZUPT_HOLD_MS, enteredMs);
+    TEST_ASSERT_LESS_THAN_UINT32(ZUPT_HOLD_MS + 100, enteredMs);
+    TEST_ASSERT_TRUE(zuptGetMetrics().stationary);
+    TEST_ASSERT_EQUAL_UINT32(1, zuptGetMetrics().stationaryCount);
+}
+
+void test_running_motors_block_stationary()
+{
+    const Motion spinningFree = {0.0f, 0.0f, false}; // 车轮悬空空转：车身不动但电机在转
+    TEST_ASSERT_EQUAL_UINT32(UINT32_MAX, feed(2.0f, spinningFree, 0.5f));
+    TEST_ASSERT_FALSE(zuptGetMetrics().stationary);
+}
+
+void test_vibration_and_rotation_block_stationary()
+{
+    const Motion vibrating = {0.5f, 0.0f, true}; // 电机已停但车身被推动/振动
+    TEST_ASSERT_EQUAL_UINT32(UINT32_MAX, feed(2.0f, vibrating, 0.5f));
+    const Motion turning = {0.0f, 5.0f, true}; // 惯性转动
+    TEST_ASSERT_EQUAL_UINT32(UINT32_MAX, feed(2.0f, turning, 0.5f));
+    // 运动结束后要等加速度方差衰减到阈值以下（时间常数 ZUPT_ACCEL_TAU_S），再计满保持时间
+    feed(0.2f, DRIVING, 0.5f);
+    const uint32_t enteredMs = feed(2.0f, STILL, 0.5f);
+    TEST_ASSERT_GREATER_THAN_UINT32(ZUPT_HOLD_MS, enteredMs);
+    TEST_ASSERT_LESS_THAN_UINT32(1500, enteredMs);
+}
+
+void test_tracks_bias_while_stationary()
+{
+    // 开机零偏 0.5，升温后真实零偏变为 0.9：静止 10 s（5 个时间常数）后跟踪误差应很小
+    feed(10.0f, STILL, 0.9f);
+    const ZuptMetrics &metrics = zuptGetMetrics();
+    TEST_ASSERT_FLOAT_WITHIN(0.02f, 0.9f, metrics.gyroBias[2]);
+    TEST_ASSERT_FLOAT_WITHIN(0.05f, 0.1f, metrics.gyroBias[0]);
+    TEST_ASSERT_FLOAT_WITHIN(0.05f, -0.2f, metrics.gyroBias[1]);
+    float corrected[3];
+    const float raw[3] = {0.1f, -0.2f, 0.9f + 10.0f};
+    zuptCorrectGyro(raw, corrected);
+    TEST_ASSERT_FLOAT_WITHIN(0.02f, 10.0f, corrected[2]);
+}
+
+// 零偏随温度缓慢上升，行驶与停车交替：跟踪零偏的残余漂移应远小于只用开机零偏
+void test_heading_drift_with_and_without_tracking()
+{
+    float trueBias = 0.5f;
+    for (int cycle = 0; cycle < 10; ++cycle)
+    {
+        trueBias += 0.04f;
+        feed(3.0f, DRIVING, trueBias);
+        feed(3.0f, STILL, trueBias);
+    }
+    const ZuptMetrics &metrics = zuptGetMetrics();
+    char message[128];
+    snprintf(message, sizeof(message), "静止 %u 次，航向漂移 %.2f°/min（仅开机零偏 %.2f°/min）", static_cast<unsigned>(metrics.stationaryCount),
+             metrics.headingDriftDegPerMin, metrics.bootBiasDriftDegPerMin);
+    TEST_MESSAGE(message);
+    TEST_ASSERT_EQUAL_UINT32(10, metrics.stationaryCount);
+    // 开机零偏的误差最终为 0.4°/s（24°/min，指标按 0.3 平滑后略低）；
+    // 跟踪零偏每次落后一个周期的升温 0.04°/s，加上 3 s 静止内未完全收敛的部分，约 3°/min
+    TEST_ASSERT_GREATER_THAN_FLOAT(15.0f, metrics.bootBiasDriftDegPerMin);
+    TEST_ASSERT_LESS_THAN_FLOAT(5.0f, fabsf(metrics.headingDriftDegPerMin));
+    TEST_ASSERT_LESS_THAN_FLOAT(fabsf(metrics.bootBiasDriftDegPerMin) / 4.0f, fabsf(metrics.headingDriftDegPerMin));
+}
+
+int main(int, char **)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_enters_stationary_after_hold_time);
+    RUN_TEST(test_running_motors_block_stationary);
+    RUN_TEST(test_vibration_and_rotation_block_stationary);
+    RUN_TEST(test_tracks_bias_while_stationary);
+    RUN_TEST(test_heading_drift_with_and_without_tracking);
+    return UNITY_END();
+}
@@ -0,0 +1,83 @@
+#pragma once
+// 主机端回放用的最小 Arduino 替身：只提供 src/main.cpp 及纯逻辑模块用到的接口。
+// 时间由回放器驱动的虚拟时钟给出，串口输出默认丢弃（-v 时打印到 stderr，仿真器导出日志时写入文件）。
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <algorithm>
+
+using std::max;
+using std::min;
+
+#define HIGH 0x1
+#define LOW 0x0
+#define PI 3.1415926535897932384626433832795
+#define F(s) (s)
+
+template <typename T, typename L, typename H>
+inline T constrain(T value, L low, H high)
+{
+    return value < low ? static_cast<T>(low) : (value > high ? static_cast<T>(high) : value);
+}
+
+// 回放时没有 PSRAM，直接用堆
+inline void *ps_malloc(size_t size) { return malloc(size); }
+
+// FreeRTOS 替身：任务在创建时同步运行到结束（启动流水线中的 IMU 任务）
+typedef void *TaskHandle_t;
+typedef int BaseType_t;
+typedef unsigned UBaseType_t;
+#define pdPASS 1
+inline BaseType_t xTaskCreatePinnedToCore(void (*task)(void *), const char *, uint32_t, void *arg, UBaseType_t, TaskHandle_t *, BaseType_t)
+{
+    task(arg);
+    return pdPASS;
+}
+inline void vTaskDelete(TaskHandle_t) {}
+
+unsigned long millis();
+unsigned long micros();
+void delay(uint32_t ms);
+void delayMicroseconds(uint32_t us);
+
+class HostSerial
+{
+public:
+    void begin(unsigned long) {}
+    bool verbose = false;
+    FILE *stream = stderr; // verbose 时的输出目标
+
+    template <typename T>
+    void print(const T &value) { write(value); }
+    template <typename T>
+    void println(const T &value)
+    {
+        write(value);
+        write("\n");
+    }
+    void println() { write("\n"); }
+    void printf(const char *fmt, ...) __attribute__((format(printf, 2, 3)));
+
+private:
+    void write(const char *s);
+    void write(char c);
+    void write(int v);
+    void write(unsigned v);
+    void write(long v);
+    void write(unsigned long v);
+    void write(float v);
+    void write(double v);
+};
+
+extern HostSerial Serial;
+
+class HostEsp
+{
+public:
+    [[noreturn]] void restart();
+};
+
+extern HostEsp ESP;
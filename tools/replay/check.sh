@@ -0,0 +1,36 @@
+#!/bin/sh
+# 回放回归检查：构建回放器，逐个回放 testdata/ 中的输入日志并与参考电机轨迹比对，任一不一致即失败。
+#   check.sh            检查
+#   check.sh --update   控制逻辑有意改变后，用仿真器重新生成全部样例（提交前请检查轨迹差异）
+set -e
+cd "$(dirname "$0")/../.."
+
+BUILD=${BUILD_DIR:-/tmp/replay-build}
+DATA=tools/replay/testdata
+SOURCES="src/main.cpp src/ranging.cpp src/motion.cpp src/logger.cpp src/supervisor.cpp src/spectrum.cpp src/governor.cpp \
+src/boot.cpp src/collision.cpp src/route.cpp src/motorid.cpp src/battery.cpp src/behavior.cpp src/sonar.cpp src/stripchart.cpp \
+tools/replay/host_stubs.cpp"
+CXXFLAGS="-std=gnu++17 -O2 -Wall -Wextra -Itools/replay -Isrc"
+
+mkdir -p "$BUILD"
+g++ $CXXFLAGS $SOURCES tools/replay/replay.cpp -o "$BUILD/replay"
+
+if [ "$1" = "--update" ]; then
+    g++ $CXXFLAGS -DINPUT_LOG_CAPTURE $SOURCES src/inputlog.cpp tools/replay/sim.cpp -o "$BUILD/sim"
+    for name in $("$BUILD/sim" --list); do
+        "$BUILD/sim" "$name" -l "$DATA/$name.log" -o "$DATA/$name.trace"
+    done
+fi
+
+status=0
+for log in "$DATA"/*.log; do
+    name=$(basename "$log" .log)
+    if "$BUILD/replay" "$log" --expect "$DATA/$name.trace" 2>"$BUILD/$name.err"; then
+        echo "PASS $name"
+    else
+        echo "FAIL $name"
+        cat "$BUILD/$name.err"
+        status=1
+    fi
+done
+exit $status
@@ -0,0 +1,312 @@
+// 主机端替身：虚拟时钟、串口，以及电机/显示/按键/超声波/MPU/电池 ADC 硬件模块。
+// 输入来自回放器设置的当前 ReplayTick，电机输出记录为命令轨迹。
+#include <Arduino.h>
+#include <stdarg.h>
+#include <sstream>
+#include "replay_host.h"
+#include "motors.h"
+#include "motor_driver.h"
+#include "display.h"
+#include "buttons.h"
+#include "ultrasonic.h"
+#include "mpu.h"
+#include "logger.h"
+#include "console.h"
+#include "route.h"
+#include "route_store.h"
+#include "motorid_store.h"
+#include "thermal_bias_store.h"
+#include "battery_adc.h"
+#include "supervisor.h"
+
+HostSerial Serial;
+HostEsp ESP;
+
+static uint64_t virtualMicros = 0;
+static const ReplayTick *currentTick = nullptr;
+static size_t rangeCursor = 0;
+static bool collisionTaken = false;
+static size_t commandCursor = 0;
+static bool batteryTaken = false;
+static unsigned desyncCount = 0;
+static std::vector<TraceEntry> trace;
+static size_t motorChanges = 0;
+static int tracedSpeedA = 0;
+static int tracedSpeedB = 0;
+static bool tracedDegraded[SUBSYSTEM_COUNT] = {};
+static MpuState mpuState = {};
+static MpuSample mpuSample = {};
+static bool sampleQueued = false;
+static int currentSpeedA = 0;
+static int currentSpeedB = 0;
+static ButtonCallback shortCb = nullptr;
+static ButtonCallback longCb = nullptr;
+
+// ---- 虚拟时钟 ----
+void hostSetClock(uint64_t micros) { virtualMicros = micros; }
+unsigned long millis() { return static_cast<unsigned long>(static_cast<uint32_t>(virtualMicros / 1000)); }
+unsigned long micros() { return static_cast<unsigned long>(static_cast<uint32_t>(virtualMicros)); }
+void delay(uint32_t) {}
+void delayMicroseconds(uint32_t) {}
+
+void hostSetTick(const ReplayTick *tick)
+{
+    // 上一迭代没有读完的超声波记录同样说明输入消费顺序已改变
+    if (currentTick != nullptr && rangeCursor < currentTick->ranges.size())
+        desyncCount += static_cast<unsigned>(currentTick->ranges.size() - rangeCursor);
+    currentTick = tick;
+    rangeCursor = 0;
+    collisionTaken = false;
+    commandCursor = 0;
+    batteryTaken = false;
+}
+
+unsigned hostDesyncCount() { return desyncCount; }
+const std::vector<TraceEntry> &hostTrace() { return trace; }
+size_t hostMotorChanges() { return motorChanges; }
+
+void hostSampleSupervisor()
+{
+    for (size_t i = 0; i < SUBSYSTEM_COUNT; ++i)
+    {
+        const bool degraded = supervisorDegraded(static_cast<Subsystem>(i));
+        if (degraded != tracedDegraded[i])
+        {
+            tracedDegraded[i] = degraded;
+            trace.push_back({virtualMicros, true, static_cast<int>(i), degraded ? 1 : 0});
+        }
+    }
+}
+
+std::string hostFormatTrace()
+{
+    std::ostringstream out;
+    for (const TraceEntry &e : trace)
+    {
+        out << e.micros << ' ';
+        if (e.supervisor)
+            out << "S ";
+        out << e.a << ' ' << e.b << '\n';
+    }
+    return out.str();
+}
+
+// ---- 串口 ----
+void HostSerial::write(const char *s)
+{
+    if (verbose)
+        fputs(s, stream);
+}
+void HostSerial::write(char c)
+{
+    if (verbose)
+        fputc(c, stream);
+}
+void HostSerial::write(int v) { write(static_cast<long>(v)); }
+void HostSerial::write(unsigned v) { write(static_cast<unsigned long>(v)); }
+void HostSerial::write(long v)
+{
+    if (verbose)
+        fprintf(stream, "%ld", v);
+}
+void HostSerial::write(unsigned long v)
+{
+    if (verbose)
+        fprintf(stream, "%lu", v);
+}
+void HostSerial::write(float v) { write(static_cast<double>(v)); }
+void HostSerial::write(double v)
+{
+    if (verbose)
+        fprintf(stream, "%.2f", v);
+}
+void HostSerial::printf(const char *fmt, ...)
+{
+    if (!verbose)
+        return;
+    va_list args;
+    va_start(args, fmt);
+    vfprintf(stream, fmt, args);
+    va_end(args);
+}
+
+void HostEsp::restart() { throw HostRestart(); }
+
+// ---- 日志：由回放器在每次 loop() 之后同步取出 ----
+static uint32_t hostLogClock() { return static_cast<uint32_t>(millis()); }
+static void hostLogSink(const char *line) { Serial.println(line); }
+void logBegin() { logSetClock(hostLogClock); }
+void hostDrainLogs()
+{
+    while (logDrain(hostLogSink, LOG_QUEUE_SIZE) > 0)
+    {
+    }
+}
+
+// ---- 电机 ----
+static void traceMotors()
+{
+    if (motorChanges > 0 && tracedSpeedA == currentSpeedA && tracedSpeedB == currentSpeedB)
+        return;
+    tracedSpeedA = currentSpeedA;
+    tracedSpeedB = currentSpeedB;
+    ++motorChanges;
+    trace.push_back({virtualMicros, false, currentSpeedA, currentSpeedB});
+}
+
+void initMotors() {}
+void motorA(int speed)
+{
+    currentSpeedA = constrain(speed, -255, 255);
+    traceMotors();
+}
+void motorB(int speed)
+{
+    currentSpeedB = constrain(speed, -255, 255);
+    traceMotors();
+}
+void motors(int speedA, int speedB)
+{
+    currentSpeedA = constrain(speedA, -255, 255);
+    currentSpeedB = constrain(speedB, -255, 255);
+    traceMotors();
+}
+void motorsMix(int throttle, int turn)
+{
+    int wheels[2];
+    DiffMixer<WHEEL_LEFT, WHEEL_RIGHT>::mix(throttle, turn, wheels);
+    motors(wheels[0], wheels[1]);
+}
+void brakeAll() {}
+// 紧急刹车发生在传感器任务中，回放时由记录的碰撞事件驱动 loop 的后续处理
+void motorsEmergencyStop() {}
+void motorsClearEmergency() {}
+bool motorsEmergencyLatched() { return false; }
+// 轨迹记录补偿前的命令，前馈表不影响回放
+void motorsSetFeedForward(const MotorIdTable *) {}
+bool motorsFeedForwardEnabled() { return false; }
+bool motorIdStoreSave(const MotorIdTable &) { return true; }
+bool motorIdStoreLoad(MotorIdTable *) { return false; }
+bool thermalBiasStoreSave(const ThermalBiasTable &) { return true; }
+bool thermalBiasStoreLoad(ThermalBiasTable *) { return false; }
+void standby() {}
+void wakeup() {}
+int getSpeedA() { return currentSpeedA; }
+int getSpeedB() { return currentSpeedB; }
+
+// ---- 显示 ----
+bool initDisplay() { return true; }
+bool displayProbe() { return true; }
+void clearDisplay() {}
+void updateDisplay(float, bool, bool, float, float) {}
+void updateAttitudeDisplay(float, float, float, float, float) {}
+void displaySetTraveledDistance(float) {}
+void displayBootProgress(const char *const[], const char[], size_t, int) {}
+void updateStripChart(bool) {}
+const DisplayStripMetrics &displayStripMetrics()
+{
+    static const DisplayStripMetrics metrics = {};
+    return metrics;
+}
+
+// ---- 按键 ----
+void buttonsInit() {}
+void buttonsSetShortPressHandler(ButtonCallback cb) { shortCb = cb; }
+void buttonsSetLongPressHandler(ButtonCallback cb) { longCb = cb; }
+void buttonsPoll()
+{
+    if (currentTick == nullptr)
+        return;
+    for (uint8_t packed : currentTick->buttons)
+    {
+        const int index = packed & 0x7F;
+        ButtonCallback cb = (packed & 0x80) ? longCb : shortCb;
+        if (cb)
+            cb(index);
+    }
+}
+
+// ---- 串口控制台 ----
+bool consolePoll(ConsoleCommand *out)
+{
+    if (currentTick == nullptr || commandCursor >= currentTick->commands.size())
+        return false;
+    *out = currentTick->commands[commandCursor++];
+    return true;
+}
+
+// ---- 路线存储 ----
+// 保存不影响控制流程；载入的路线来自日志中的 Route 记录
+bool routeStoreSave() { return true; }
+bool routeStoreLoad()
+{
+    if (currentTick == nullptr || currentTick->route.empty())
+        return false;
+    return routeLoad(currentTick->route.data(), currentTick->route.size());
+}
+
+// ---- 超声波 ----
+bool initUltrasonic() { return true; }
+void ultrasonicSetTemperature(float) {}
+float ultrasonicReadCm()
+{
+    if (currentTick == nullptr || rangeCursor >= currentTick->ranges.size())
+    {
+        ++desyncCount;
+        return -1.0f;
+    }
+    return currentTick->ranges[rangeCursor++];
+}
+
+// ---- 电池 ADC ----
+bool batteryAdcBegin() { return true; }
+bool batteryAdcRead(float *volts)
+{
+    if (currentTick == nullptr || !currentTick->hasBattery || batteryTaken)
+        return false;
+    batteryTaken = true;
+    *volts = currentTick->battery;
+    return true;
+}
+
+// ---- MPU ----
+bool mpuInit(uint8_t, uint8_t) { return true; }
+bool mpuRecover() { return true; }
+uint8_t mpuCalibrationPercent() { return 100; }
+bool mpuStartTask() { return true; }
+// 设备端只在取到新样本时记录 Mpu/Sample，缺少记录即回放为取样失败（快照保持不变）
+bool mpuFetch()
+{
+    if (currentTick == nullptr || !currentTick->hasMpu)
+    {
+        return false;
+    }
+    mpuState = currentTick->mpu;
+    mpuSample = currentTick->sample;
+    sampleQueued = true;
+    return true;
+}
+// 日志只记录 loop 取到的最新样本：回放时每个有新样本的 Tick 入队一个样本，频谱采样率为 loop 频率。
+// 频谱只输出日志，不影响电机轨迹
+size_t mpuTakeSamples(MpuQueuedSample *out, size_t maxCount)
+{
+    if (!sampleQueued || maxCount == 0)
+        return 0;
+    sampleQueued = false;
+    out[0] = {static_cast<uint32_t>(micros()), mpuSample};
+    return 1;
+}
+uint32_t mpuDroppedSamples() { return 0; }
+CollisionKind mpuTakeCollision()
+{
+    if (currentTick == nullptr || collisionTaken)
+        return CollisionKind::None;
+    collisionTaken = true;
+    return static_cast<CollisionKind>(currentTick->collision);
+}
+const MpuState &mpuGetState() { return mpuState; }
+// 漂移指标与温度模型只在传感器任务中更新，回放时为空（不会触发保存）
+MpuDriftMetrics mpuGetDriftMetrics() { return {}; }
+bool mpuSetThermalTable(const ThermalBiasTable &) { return false; }
+bool mpuGetThermalTable(ThermalBiasTable *) { return false; }
+const MpuSample &mpuGetSample() { return mpuSample; }
@@ -0,0 +1,257 @@
+// 输入日志回放器：把设备采集的输入按虚拟时钟喂给未修改的 src/main.cpp，
+// 输出电机命令轨迹，并可与参考轨迹逐行比对（用于 CI 回归）。
+//
+// 用法：replay <串口日志> [-o 轨迹输出] [--expect 参考轨迹] [-v]
+#include <Arduino.h>
+#include <string>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include "replay_host.h"
+#include "inputlog_codec.h"
+
+void setup();
+void loop();
+
+// 从串口日志中提取最后一个完整的 IL:BEGIN..IL:END 块
+static bool loadLog(const char *path, std::vector<uint8_t> &bytes)
+{
+    std::ifstream in(path);
+    if (!in)
+    {
+        fprintf(stderr, "无法打开 %s\n", path);
+        return false;
+    }
+
+    std::vector<uint8_t> block;
+    bool inBlock = false;
+    bool complete = false;
+    std::string line;
+    while (std::getline(in, line))
+    {
+        while (!line.empty() && (line.back() == '\r' || line.back() == ' '))
+            line.pop_back();
+        const size_t pos = line.find("IL:");
+        if (pos == std::string::npos)
+            continue;
+        const std::string payload = line.substr(pos + 3);
+        if (payload.compare(0, 5, "BEGIN") == 0)
+        {
+            block.clear();
+            inBlock = true;
+            if (payload.find("OVERFLOW") != std::string::npos)
+                fprintf(stderr, "警告：采集缓冲已写满，日志被截断\n");
+            continue;
+        }
+        if (payload == "END")
+        {
+            if (inBlock)
+            {
+                bytes = block;
+                complete = true;
+            }
+            inBlock = false;
+            continue;
+        }
+        if (!inBlock)
+            continue;
+        for (size_t i = 0; i + 1 < payload.size(); i += 2)
+            block.push_back(static_cast<uint8_t>(strtoul(payload.substr(i, 2).c_str(), nullptr, 16)));
+    }
+
+    if (!complete)
+        fprintf(stderr, "%s 中没有完整的 IL:BEGIN..IL:END 块\n", path);
+    return complete;
+}
+
+static bool decodeLog(const std::vector<uint8_t> &bytes, std::vector<ReplayTick> &ticks)
+{
+    if (!inputLogCheckHeader(bytes.data(), bytes.size(), static_cast<uint8_t>(sizeof(MpuState))))
+    {
+        fprintf(stderr, "日志头不匹配（版本或 MpuState 布局与当前代码不同）\n");
+        return false;
+    }
+
+    const uint8_t *p = bytes.data() + INPUT_LOG_HEADER_SIZE;
+    const uint8_t *end = bytes.data() + bytes.size();
+    uint64_t clock = 0;
+    while (p < end)
+    {
+        const InputLogType type = static_cast<InputLogType>(*p++);
+        const size_t left = static_cast<size_t>(end - p);
+        if (type == InputLogType::Tick)
+        {
+            uint32_t delta = 0;
+            const size_t n = inputLogGetVarint(p, left, &delta);
+            if (n == 0)
+                break;
+            p += n;
+            clock += delta;
+            ticks.push_back({clock, false, {}, {}, {}, {}, 0, {}, {}, false, 0.0f});
+            continue;
+        }
+        if (ticks.empty())
+        {
+            fprintf(stderr, "首个 Tick 之前出现输入记录\n");
+            return false;
+        }
+        ReplayTick &tick = ticks.back();
+        if (type == InputLogType::Mpu && left >= sizeof(MpuState))
+        {
+            memcpy(&tick.mpu, p, sizeof(MpuState));
+            tick.hasMpu = true;
+            p += sizeof(MpuState);
+        }
+        else if (type == InputLogType::Sample && left >= sizeof(MpuSample))
+        {
+            memcpy(&tick.sample, p, sizeof(MpuSample));
+            p += sizeof(MpuSample);
+        }
+        else if (type == InputLogType::Range && left >= sizeof(float))
+        {
+            tick.ranges.push_back(inputLogGetFloat(p));
+            p += sizeof(float);
+        }
+        else if (type == InputLogType::Button && left >= 1)
+        {
+            tick.buttons.push_back(*p++);
+        }
+        else if (type == InputLogType::Collision && left >= 1)
+        {
+            tick.collision = *p++;
+        }
+        else if (type == InputLogType::Command && left >= 5)
+        {
+            tick.commands.push_back({static_cast<ConsoleCommandKind>(p[0]), inputLogGetInt16(p + 1), inputLogGetInt16(p + 3)});
+            p += 5;
+        }
+        else if (type == InputLogType::Route)
+        {
+            uint32_t size = 0;
+            const size_t n = inputLogGetVarint(p, left, &size);
+            if (n == 0 || left - n < size)
+            {
+                fprintf(stderr, "偏移 %ld 处路线记录损坏\n", static_cast<long>(p - bytes.data() - 1));
+                return false;
+            }
+            tick.route.assign(p + n, p + n + size);
+            p += n + size;
+        }
+        else if (type == InputLogType::Battery && left >= sizeof(float))
+        {
+            tick.battery = inputLogGetFloat(p);
+            tick.hasBattery = true;
+            p += sizeof(float);
+        }
+        else
+        {
+            fprintf(stderr, "偏移 %ld 处记录损坏\n", static_cast<long>(p - bytes.data() - 1));
+            return false;
+        }
+    }
+    return true;
+}
+
+// 逐行比对，返回第一处差异的行号（从 1 开始），一致返回 0
+static size_t diffTrace(const std::string &actual, const std::string &expected)
+{
+    std::istringstream a(actual), e(expected);
+    std::string la, le;
+    size_t line = 0;
+    while (true)
+    {
+        const bool hasA = static_cast<bool>(std::getline(a, la));
+        const bool hasE = static_cast<bool>(std::getline(e, le));
+        ++line;
+        if (!hasA && !hasE)
+            return 0;
+        if (hasA != hasE || la != le)
+        {
+            fprintf(stderr, "轨迹第 %zu 行不一致\n  实际: %s\n  参考: %s\n", line,
+                    hasA ? la.c_str() : "<结束>", hasE ? le.c_str() : "<结束>");
+            return line;
+        }
+    }
+}
+
+int main(int argc, char **argv)
+{
+    const char *logPath = nullptr;
+    const char *outPath = nullptr;
+    const char *expectPath = nullptr;
+    for (int i = 1; i < argc; ++i)
+    {
+        const std::string arg = argv[i];
+        if (arg == "-o" && i + 1 < argc)
+            outPath = argv[++i];
+        else if (arg == "--expect" && i + 1 < argc)
+            expectPath = argv[++i];
+        else if (arg == "-v")
+            Serial.verbose = true;
+        else
+            logPath = argv[i];
+    }
+    if (logPath == nullptr)
+    {
+        fprintf(stderr, "用法：%s <串口日志> [-o 轨迹输出] [--expect 参考轨迹] [-v]\n", argv[0]);
+        return 2;
+    }
+
+    std::vector<uint8_t> bytes;
+    std::vector<ReplayTick> ticks;
+    if (!loadLog(logPath, bytes) || !decodeLog(bytes, ticks) || ticks.empty())
+        return 2;
+
+    hostSetClock(ticks.front().micros);
+    hostSetTick(nullptr);
+    setup();
+    hostDrainLogs();
+
+    size_t executed = 0;
+    try
+    {
+        for (const ReplayTick &tick : ticks)
+        {
+            hostSetClock(tick.micros);
+            hostSetTick(&tick);
+            loop();
+            hostSampleSupervisor();
+            hostDrainLogs();
+            ++executed;
+        }
+    }
+    catch (const HostRestart &)
+    {
+        fprintf(stderr, "控制代码请求重启，回放在第 %zu 个 Tick 结束\n", executed);
+    }
+
+    const std::string trace = hostFormatTrace();
+    fprintf(stderr, "回放 %zu/%zu 个 Tick，电机命令变化 %zu 次，输入不同步 %u 次\n", executed, ticks.size(),
+            hostMotorChanges(), hostDesyncCount());
+
+    if (outPath != nullptr)
+    {
+        std::ofstream out(outPath);
+        out << trace;
+    }
+    else if (expectPath == nullptr)
+    {
+        fputs(trace.c_str(), stdout);
+    }
+
+    if (expectPath != nullptr)
+    {
+        std::ifstream in(expectPath);
+        if (!in)
+        {
+            fprintf(stderr, "无法打开参考轨迹 %s\n", expectPath);
+            return 2;
+        }
+        std::stringstream expected;
+        expected << in.rdbuf();
+        if (diffTrace(trace, expected.str()) != 0)
+            return 1;
+        fprintf(stderr, "轨迹与参考一致\n");
+    }
+    return hostDesyncCount() == 0 ? 0 : 1;
+}
@@ -0,0 +1,53 @@
+#pragma once
+// 回放器与主机端替身之间共享的状态
+#include <stdint.h>
+#include <string>
+#include <vector>
+#include "mpu.h"
+#include "console.h"
+
+struct ReplayTick
+{
+    uint64_t micros;
+    bool hasMpu; // false 表示本次迭代 mpuFetch 没有取到新样本
+    MpuState mpu;
+    MpuSample sample;
+    std::vector<float> ranges;
+    std::vector<uint8_t> buttons;
+    uint8_t collision; // CollisionKind，0 表示无
+    std::vector<ConsoleCommand> commands;
+    std::vector<uint8_t> route; // 本次迭代从闪存载入的路线，空表示未载入
+    bool hasBattery;
+    float battery; // 电池电压（V）
+};
+
+// 轨迹条目：电机命令变化，或每次 loop 之后采样到的监督降级状态变化
+struct TraceEntry
+{
+    uint64_t micros;
+    bool supervisor; // false：a、b 为 A/B 速度；true：a 为 Subsystem，b 为是否降级
+    int a;
+    int b;
+};
+
+// 设置虚拟时钟与当前迭代要喂给控制代码的输入
+void hostSetClock(uint64_t micros);
+void hostSetTick(const ReplayTick *tick);
+
+// 取出控制代码排队的日志（-v 时打印）
+void hostDrainLogs();
+
+// 控制代码读取输入时与日志不一致的次数（代码改变了输入消费顺序时 > 0）
+unsigned hostDesyncCount();
+
+// 在每次 loop() 之后调用：记录各子系统降级/恢复的变化
+void hostSampleSupervisor();
+
+// 轨迹（仅记录变化）及其文本形式：电机行为 "<微秒> <A速度> <B速度>"，监督行为 "<微秒> S <子系统序号> <是否降级>"
+const std::vector<TraceEntry> &hostTrace();
+size_t hostMotorChanges();
+std::string hostFormatTrace();
+
+struct HostRestart
+{
+};
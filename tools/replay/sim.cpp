@@ -0,0 +1,293 @@
+// 闭环仿真器：用简单的车辆与环境模型代替硬件，驱动未修改的 src/main.cpp 运行一个预设场景，
+// 同时以 INPUT_LOG_CAPTURE 构建采集输入日志。导出的日志与电机轨迹作为回放器的回归样例（testdata/），
+// 日志只包含控制代码实际读取的输入，与设备端采集的日志格式完全相同。
+//
+// 用法：sim <场景> -l 日志输出 -o 轨迹输出 [-v]
+//       sim --list    列出场景名
+#include <Arduino.h>
+#include <string>
+#include <fstream>
+#include "replay_host.h"
+#include "inputlog.h"
+#include "inputlog_codec.h"
+#include "motors.h"
+#include "ultrasonic.h"
+
+void setup();
+void loop();
+
+// 一次 loop 约 6 ms（末尾 delay(5) 加上计算与总线时间）；setup() 与首次 loop() 在同一时刻，与回放器一致
+static constexpr uint32_t SIM_TICK_US = 6000;
+static constexpr uint64_t SIM_START_US = 1000000;
+
+// 车辆模型：满占空比车速、原地转向角速度、电机死区与一阶响应时间常数
+static constexpr float SIM_FULL_SPEED_MPS = 1.0f;
+static constexpr float SIM_FULL_RATE_DPS = 360.0f;
+static constexpr int SIM_DEADBAND = 60;
+static constexpr float SIM_TAU_S = 0.1f;
+// 超声波有效量程与偏离墙面法线的最大角度
+static constexpr float SIM_MAX_RANGE_CM = 400.0f;
+static constexpr float SIM_MAX_ECHO_ANGLE_DEG = 30.0f;
+
+enum class SimEventKind : uint8_t
+{
+    ShortPress, // a = 按键序号
+    LongPress,
+    Command,     // a、b 为命令参数，kind 在 command 中
+    Collision,   // a = CollisionKind
+    ImuDropout,  // a = 持续时间（ms），期间 mpuFetch 取不到新样本
+    RangeDropout // a = 持续时间（ms），期间超声波模块无响应
+};
+
+struct SimEvent
+{
+    uint32_t atMs; // 相对场景开始
+    SimEventKind kind;
+    int a;
+    int b;
+    ConsoleCommandKind command;
+};
+
+struct SimScenario
+{
+    const char *name;
+    const char *description;
+    float wallCm; // 正前方墙面距离，<= 0 表示前方空旷
+    bool corridor; // 窄通道尽头的墙：两侧墙约束车身，差速只改变航向读数，前进方向始终朝向墙面
+    uint32_t durationMs;
+    const SimEvent *events;
+    size_t eventCount;
+};
+
+// 前进巡航：调速器接近墙面时减速并差速绕开；之后一次撞击触发后退、原地转向的避障脚本
+static const SimEvent CRUISE_EVENTS[] = {
+    {500, SimEventKind::ShortPress, 2, 0, ConsoleCommandKind::None},
+    {5000, SimEventKind::Collision, static_cast<int>(CollisionKind::Bump), 0, ConsoleCommandKind::None},
+    {14000, SimEventKind::ShortPress, 2, 0, ConsoleCommandKind::None},
+};
+
+// 串口遥控：直行、原地转向、零速与停车，振动分析与航向积分都看到真实的样本
+static const SimEvent REMOTE_EVENTS[] = {
+    {500, SimEventKind::Command, 150, 150, ConsoleCommandKind::Drive},
+    {3000, SimEventKind::Command, 150, -150, ConsoleCommandKind::Drive},
+    {4000, SimEventKind::Command, 200, 120, ConsoleCommandKind::Drive},
+    {6000, SimEventKind::Command, 0, 0, ConsoleCommandKind::Drive},
+    {8000, SimEventKind::Command, 0, 0, ConsoleCommandKind::Stop},
+};
+
+// 电机启用但命令为 0：测距按空闲间隔进行，监督不应因此反复降级/恢复；之后正常起步
+static const SimEvent IDLE_EVENTS[] = {
+    {500, SimEventKind::Command, 0, 0, ConsoleCommandKind::Drive},
+    {4000, SimEventKind::Command, 150, 150, ConsoleCommandKind::Drive},
+    {5500, SimEventKind::Command, 0, 0, ConsoleCommandKind::Stop},
+};
+
+// 行驶中 IMU 断开 1 s：监督进入降级、定期尝试恢复，恢复后继续遥控转向
+static const SimEvent IMU_FAULT_EVENTS[] = {
+    {500, SimEventKind::Command, 150, 150, ConsoleCommandKind::Drive},
+    {2000, SimEventKind::ImuDropout, 1000, 0, ConsoleCommandKind::None},
+    {4500, SimEventKind::Command, 150, -150, ConsoleCommandKind::Drive},
+    {5500, SimEventKind::Command, 0, 0, ConsoleCommandKind::Stop},
+};
+
+// 巡航中超声波模块无响应 1.5 s：连续超时后停车等待，测距恢复后继续前进
+static const SimEvent RANGE_FAULT_EVENTS[] = {
+    {500, SimEventKind::ShortPress, 2, 0, ConsoleCommandKind::None},
+    {2000, SimEventKind::RangeDropout, 1500, 0, ConsoleCommandKind::None},
+    {6000, SimEventKind::ShortPress, 2, 0, ConsoleCommandKind::None},
+};
+
+// 窄通道尽头：差速避让绕不开，调速器按计入延迟的预估距离给出停车，由避障脚本后退转向
+static const SimEvent DEADEND_EVENTS[] = {
+    {500, SimEventKind::ShortPress, 2, 0, ConsoleCommandKind::None},
+    {8500, SimEventKind::ShortPress, 2, 0, ConsoleCommandKind::None},
+};
+
+#define SIM_SCENARIO(name, wall, corridor, duration, events, description) \
+    {name, description, wall, corridor, duration, events, sizeof(events) / sizeof(events[0])}
+
+static const SimScenario SCENARIOS[] = {
+    SIM_SCENARIO("cruise", 150.0f, false, 14500, CRUISE_EVENTS, "K3 启动前进，绕开墙面，撞击后避障"),
+    SIM_SCENARIO("remote", 0.0f, false, 9000, REMOTE_EVENTS, "串口遥控直行、转向、零速与停车"),
+    SIM_SCENARIO("idle", 0.0f, false, 6000, IDLE_EVENTS, "电机启用但零速，测距监督不应反复降级"),
+    SIM_SCENARIO("imufault", 0.0f, false, 6000, IMU_FAULT_EVENTS, "行驶中 IMU 断开 1 s 后恢复"),
+    SIM_SCENARIO("rangefault", 0.0f, false, 6500, RANGE_FAULT_EVENTS, "巡航中超声波无响应 1.5 s，停车等待后继续"),
+    SIM_SCENARIO("deadend", 120.0f, true, 9000, DEADEND_EVENTS, "K3 驶入窄通道尽头，绕不开，调速器按预估距离停车避障"),
+};
+
+struct SimWorld
+{
+    float x;       // 沿墙面法线方向的位置（m）
+    float yaw;     // °
+    float speed;   // 前进速度（m/s）
+    float yawRate; // °/s
+    float accel;   // 前进方向加速度（m/s²）
+};
+
+static float deadband(int command)
+{
+    return abs(command) < SIM_DEADBAND ? 0.0f : command / 255.0f;
+}
+
+static void stepWorld(const SimScenario &scenario, SimWorld &world, float dt)
+{
+    const float a = deadband(getSpeedA());
+    const float b = deadband(getSpeedB());
+    const float targetSpeed = (a + b) * 0.5f * SIM_FULL_SPEED_MPS;
+    const float targetRate = (a - b) * 0.5f * SIM_FULL_RATE_DPS;
+    const float k = dt / (SIM_TAU_S + dt);
+    const float previous = world.speed;
+    world.speed += (targetSpeed - world.speed) * k;
+    world.yawRate += (targetRate - world.yawRate) * k;
+    world.accel = (world.speed - previous) / dt;
+    world.yaw += world.yawRate * dt;
+    world.x += world.speed * (scenario.corridor ? 1.0f : cosf(world.yaw * PI / 180.0f)) * dt;
+}
+
+static float rangeCm(const SimScenario &scenario, const SimWorld &world)
+{
+    if (scenario.wallCm <= 0.0f || (!scenario.corridor && fabsf(world.yaw) > SIM_MAX_ECHO_ANGLE_DEG))
+    {
+        return ULTRASONIC_NO_ECHO;
+    }
+    const float cm = (scenario.wallCm - world.x * 100.0f) / (scenario.corridor ? 1.0f : cosf(world.yaw * PI / 180.0f));
+    return cm > SIM_MAX_RANGE_CM ? ULTRASONIC_NO_ECHO : fmaxf(cm, 2.0f);
+}
+
+// 传感器任务输出的融合状态与原始样本；竖直方向叠加与车速成正比的 25 Hz 车轮振动
+static void fillImu(const SimWorld &world, uint32_t ms, ReplayTick &tick)
+{
+    const float yawRad = world.yaw * PI / 180.0f;
+    tick.hasMpu = true;
+    tick.mpu = {0.0f, 0.0f, world.yaw, world.yawRate, world.speed * cosf(yawRad), world.speed * sinf(yawRad)};
+    const float vibration = 0.8f * fabsf(world.speed) * sinf(2.0f * PI * 25.0f * ms / 1000.0f);
+    tick.sample = {{world.accel, world.speed * world.yawRate * static_cast<float>(PI) / 180.0f, vibration}, {0.0f, 0.0f, world.yawRate}, 30.0f};
+}
+
+static const SimScenario *findScenario(const std::string &name)
+{
+    for (const SimScenario &scenario : SCENARIOS)
+    {
+        if (name == scenario.name)
+        {
+            return &scenario;
+        }
+    }
+    return nullptr;
+}
+
+static void usage(const char *argv0)
+{
+    fprintf(stderr, "用法：%s <场景> -l 日志输出 -o 轨迹输出 [-v]\n场景：\n", argv0);
+    for (const SimScenario &scenario : SCENARIOS)
+    {
+        fprintf(stderr, "  %-10s %s\n", scenario.name, scenario.description);
+    }
+}
+
+int main(int argc, char **argv)
+{
+    const char *name = nullptr;
+    const char *logPath = nullptr;
+    const char *tracePath = nullptr;
+    for (int i = 1; i < argc; ++i)
+    {
+        const std::string arg = argv[i];
+        if (arg == "-l" && i + 1 < argc)
+            logPath = argv[++i];
+        else if (arg == "-o" && i + 1 < argc)
+            tracePath = argv[++i];
+        else if (arg == "-v")
+            Serial.verbose = true;
+        else if (arg == "--list")
+        {
+            for (const SimScenario &scenario : SCENARIOS)
+            {
+                printf("%s\n", scenario.name);
+            }
+            return 0;
+        }
+        else
+            name = argv[i];
+    }
+    const SimScenario *scenario = name != nullptr ? findScenario(name) : nullptr;
+    if (scenario == nullptr || logPath == nullptr || tracePath == nullptr)
+    {
+        usage(argv[0]);
+        return 2;
+    }
+
+    hostSetClock(SIM_START_US);
+    hostSetTick(nullptr);
+    setup();
+    hostDrainLogs();
+
+    SimWorld world = {};
+    uint32_t imuDropUntil = 0;
+    uint32_t rangeDropUntil = 0;
+    size_t nextEvent = 0;
+    ReplayTick tick = {};
+    for (uint32_t ms = 0; ms < scenario->durationMs; ms += SIM_TICK_US / 1000)
+    {
+        stepWorld(*scenario, world, SIM_TICK_US / 1000000.0f);
+        tick = {};
+        tick.micros = SIM_START_US + static_cast<uint64_t>(ms) * 1000;
+        for (; nextEvent < scenario->eventCount && scenario->events[nextEvent].atMs <= ms; ++nextEvent)
+        {
+            const SimEvent &event = scenario->events[nextEvent];
+            switch (event.kind)
+            {
+            case SimEventKind::ShortPress:
+            case SimEventKind::LongPress:
+                tick.buttons.push_back(inputLogPackButton(event.a, event.kind == SimEventKind::LongPress));
+                break;
+            case SimEventKind::Command:
+                tick.commands.push_back({event.command, static_cast<int16_t>(event.a), static_cast<int16_t>(event.b)});
+                break;
+            case SimEventKind::Collision:
+                tick.collision = static_cast<uint8_t>(event.a);
+                break;
+            case SimEventKind::ImuDropout:
+                imuDropUntil = ms + event.a;
+                break;
+            case SimEventKind::RangeDropout:
+                rangeDropUntil = ms + event.a;
+                break;
+            }
+        }
+        if (ms >= imuDropUntil)
+        {
+            fillImu(world, ms, tick);
+        }
+        tick.ranges.push_back(ms < rangeDropUntil ? ULTRASONIC_NO_RESPONSE : rangeCm(*scenario, world));
+        tick.hasBattery = true;
+        tick.battery = 7.9f - 0.3f * (abs(getSpeedA()) + abs(getSpeedB())) / 510.0f;
+
+        hostSetClock(tick.micros);
+        hostSetTick(&tick);
+        loop();
+        hostSampleSupervisor();
+        hostDrainLogs();
+    }
+    hostSetTick(nullptr);
+
+    // 导出方式与设备端 K4 长按相同：IL: 前缀的十六进制行
+    FILE *log = fopen(logPath, "w");
+    if (log == nullptr)
+    {
+        fprintf(stderr, "无法写入 %s\n", logPath);
+        return 2;
+    }
+    const bool verbose = Serial.verbose;
+    Serial.verbose = true;
+    Serial.stream = log;
+    inputLogDump();
+    Serial.stream = stderr;
+    Serial.verbose = verbose;
+    fclose(log);
+
+    std::ofstream trace(tracePath);
+    trace << hostFormatTrace();
+    fprintf(stderr, "场景 %s：%u ms，电机命令变化 %zu 次\n", scenario->name, scenario->durationMs, hostMotorChanges());
+    return 0;
+}